@@ -0,0 +1,51 @@
+# Generation of C++ headers from XML dictionaries by diameter_dictgen, see tools/dictgen
+#
+# diameter_generate_dictionary(<target>
+#     NAMESPACE <namespace of the generated code>
+#     HEADER <path of the header in the include directory>
+#     XML <dictionary files>...)
+#
+# Creates the interface library <target>: the header is generated into the include directory of
+# the library in the current binary directory when a target linked to it is built, and again when
+# one of the dictionary files changes.
+#
+#   diameter_generate_dictionary(gy_dictionary
+#       NAMESPACE myapp::gy
+#       HEADER myapp/gy.h
+#       XML ${DIAMETER_DICTIONARIES_DIR}/base.xml ${DIAMETER_DICTIONARIES_DIR}/dcca.xml)
+#   target_link_libraries(MyTarget PRIVATE gy_dictionary)
+
+function(diameter_generate_dictionary TARGET)
+    cmake_parse_arguments(ARG "" "NAMESPACE;HEADER" "XML" ${ARGN})
+    if(NOT ARG_NAMESPACE OR NOT ARG_HEADER OR NOT ARG_XML)
+        message(FATAL_ERROR "diameter_generate_dictionary: NAMESPACE, HEADER and XML are required")
+    endif()
+    if(NOT TARGET diameter_dictgen)
+        message(FATAL_ERROR "diameter_generate_dictionary: no diameter_dictgen target, "
+            "enable DIAMETER_BUILD_DICTIONARIES")
+    endif()
+
+    set(include_dir ${CMAKE_CURRENT_BINARY_DIR}/include)
+    set(output ${include_dir}/${ARG_HEADER})
+    get_filename_component(output_dir ${output} DIRECTORY)
+    set(inputs)
+    foreach(xml ${ARG_XML})
+        get_filename_component(path ${xml} ABSOLUTE)
+        list(APPEND inputs ${path})
+    endforeach()
+
+    add_custom_command(
+        OUTPUT ${output}
+        COMMAND ${CMAKE_COMMAND} -E make_directory ${output_dir}
+        COMMAND diameter_dictgen --namespace ${ARG_NAMESPACE} --output ${output} ${inputs}
+        DEPENDS diameter_dictgen ${inputs}
+        COMMENT "Generating dictionary ${ARG_HEADER}"
+        VERBATIM
+    )
+    add_custom_target(${TARGET}_generate ALL DEPENDS ${output})
+
+    add_library(${TARGET} INTERFACE)
+    add_dependencies(${TARGET} ${TARGET}_generate)
+    target_include_directories(${TARGET} INTERFACE $<BUILD_INTERFACE:${include_dir}>)
+    target_link_libraries(${TARGET} INTERFACE diameter::diameter)
+endfunction()
@@ -0,0 +1,71 @@
+#ifndef DIAMETER_APPLICATION_BASE_AVP_H
+#define DIAMETER_APPLICATION_BASE_AVP_H
+
+#include <diameter/message/avp/avp.h>
+#include <diameter/message/avp/avp_def.h>
+
+// RFC 6733 4.5 Diameter Base Protocol AVPs
+
+namespace diameter::application::base::avp {
+
+template<message::avp::Code CodeV, typename T,
+         uint8_t FlagBitsV = message::avp::FlagBits::Mandatory>
+using BaseAvp = message::avp::AvpDef<CodeV, 0, T, FlagBitsV>;
+
+using AcctInterimInterval           = BaseAvp<85, message::avp::Unsigned32>;
+using AccountingRealtimeRequired    = BaseAvp<483, message::avp::Enumerated>;
+using AcctMultiSessionId            = BaseAvp<50, message::avp::UTF8String>;
+using AccountingRecordNumber        = BaseAvp<485, message::avp::Unsigned32>;
+using AccountingRecordType          = BaseAvp<480, message::avp::Enumerated>;
+using AcctSessionId                 = BaseAvp<44, message::avp::OctetString>;
+using AccountingSubSessionId        = BaseAvp<287, message::avp::Unsigned64>;
+using AcctApplicationId             = BaseAvp<259, message::avp::Unsigned32>;
+using AuthApplicationId             = BaseAvp<258, message::avp::Unsigned32>;
+using AuthRequestType               = BaseAvp<274, message::avp::Enumerated>;
+using AuthorizationLifetime         = BaseAvp<291, message::avp::Unsigned32>;
+using AuthGracePeriod               = BaseAvp<276, message::avp::Unsigned32>;
+using AuthSessionState              = BaseAvp<277, message::avp::Enumerated>;
+using ReAuthRequestType             = BaseAvp<285, message::avp::Enumerated>;
+using Class                         = BaseAvp<25, message::avp::OctetString>;
+using DestinationHost               = BaseAvp<293, message::avp::DiameterIdentity>;
+using DestinationRealm              = BaseAvp<283, message::avp::DiameterIdentity>;
+using DisconnectCause               = BaseAvp<273, message::avp::Enumerated>;
+using ErrorMessage                  = BaseAvp<281, message::avp::UTF8String,
+                                              message::avp::FlagBits::None>;
+using ErrorReportingHost            = BaseAvp<294, message::avp::DiameterIdentity,
+                                              message::avp::FlagBits::None>;
+using EventTimestamp                = BaseAvp<55, message::avp::Time>;
+using ExperimentalResult            = BaseAvp<297, message::avp::Grouped>;
+using ExperimentalResultCode        = BaseAvp<298, message::avp::Unsigned32>;
+using FailedAvp                     = BaseAvp<279, message::avp::Grouped>;
+using FirmwareRevision              = BaseAvp<267, message::avp::Unsigned32,
+                                              message::avp::FlagBits::None>;
+using HostIpAddress                 = BaseAvp<257, message::avp::Address>;
+using InbandSecurityId              = BaseAvp<299, message::avp::Unsigned32>;
+using MultiRoundTimeOut             = BaseAvp<272, message::avp::Unsigned32>;
+using OriginHost                    = BaseAvp<264, message::avp::DiameterIdentity>;
+using OriginRealm                   = BaseAvp<296, message::avp::DiameterIdentity>;
+using OriginStateId                 = BaseAvp<278, message::avp::Unsigned32>;
+using ProductName                   = BaseAvp<269, message::avp::UTF8String,
+                                              message::avp::FlagBits::None>;
+using ProxyHost                     = BaseAvp<280, message::avp::DiameterIdentity>;
+using ProxyInfo                     = BaseAvp<284, message::avp::Grouped>;
+using ProxyState                    = BaseAvp<33, message::avp::OctetString>;
+using RedirectHost                  = BaseAvp<292, message::avp::DiameterURI>;
+using RedirectHostUsage             = BaseAvp<261, message::avp::Enumerated>;
+using RedirectMaxCacheTime          = BaseAvp<262, message::avp::Unsigned32>;
+using ResultCode                    = BaseAvp<268, message::avp::Unsigned32>;
+using RouteRecord                   = BaseAvp<282, message::avp::DiameterIdentity>;
+using SessionId                     = BaseAvp<263, message::avp::UTF8String>;
+using SessionTimeout                = BaseAvp<27, message::avp::Unsigned32>;
+using SessionBinding                = BaseAvp<270, message::avp::Unsigned32>;
+using SessionServerFailover         = BaseAvp<271, message::avp::Enumerated>;
+using SupportedVendorId             = BaseAvp<265, message::avp::Unsigned32>;
+using TerminationCause              = BaseAvp<295, message::avp::Enumerated>;
+using UserName                      = BaseAvp<1, message::avp::UTF8String>;
+using VendorId                      = BaseAvp<266, message::avp::Unsigned32>;
+using VendorSpecificApplicationId   = BaseAvp<260, message::avp::Grouped>;
+
+}
+
+#endif
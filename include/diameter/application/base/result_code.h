@@ -0,0 +1,60 @@
+#ifndef DIAMETER_APPLICATION_BASE_RESULT_CODE_H
+#define DIAMETER_APPLICATION_BASE_RESULT_CODE_H
+
+#include <cstdint>
+
+namespace diameter::application::base {
+
+// RFC 6733 7.1 Result-Code AVP values
+struct ResultCodeV
+{
+    enum Value : uint32_t
+    {
+        // 7.1.1 Informational
+        MultiRoundAuth              = 1001,
+
+        // 7.1.2 Success
+        Success                     = 2001,
+        LimitedSuccess              = 2002,
+
+        // 7.1.3 Protocol Errors
+        CommandUnsupported          = 3001,
+        UnableToDeliver             = 3002,
+        RealmNotServed              = 3003,
+        TooBusy                     = 3004,
+        LoopDetected                = 3005,
+        RedirectIndication          = 3006,
+        ApplicationUnsupported      = 3007,
+        InvalidHdrBits              = 3008,
+        InvalidAvpBits              = 3009,
+        UnknownPeer                 = 3010,
+
+        // 7.1.4 Transient Failures
+        AuthenticationRejected      = 4001,
+        OutOfSpace                  = 4002,
+        ElectionLost                = 4003,
+
+        // 7.1.5 Permanent Failures
+        AvpUnsupported              = 5001,
+        UnknownSessionId            = 5002,
+        AuthorizationRejected       = 5003,
+        InvalidAvpValue             = 5004,
+        MissingAvp                  = 5005,
+        ResourcesExceeded           = 5006,
+        ContradictingAvps           = 5007,
+        AvpNotAllowed               = 5008,
+        AvpOccursTooManyTimes       = 5009,
+        NoCommonApplication         = 5010,
+        UnsupportedVersion          = 5011,
+        UnableToComply              = 5012,
+        InvalidBitInHeader          = 5013,
+        InvalidAvpLength            = 5014,
+        InvalidMessageLength        = 5015,
+        InvalidAvpBitCombo          = 5016,
+        NoCommonSecurity            = 5017
+    };
+};
+
+}
+
+#endif
@@ -0,0 +1,153 @@
+#ifndef DIAMETER_DICTIONARY_DETAIL_PERFECT_HASH_H
+#define DIAMETER_DICTIONARY_DETAIL_PERFECT_HASH_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace diameter::dictionary::detail {
+
+// splitmix64 finalizer
+constexpr uint64_t mix(uint64_t x) noexcept
+{
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ull;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBull;
+    x ^= x >> 31;
+    return x;
+}
+
+// Maps the high 32 bits of the hash to [0, n) without a division, n < 2^32
+constexpr std::size_t reduce(uint64_t h, std::size_t n) noexcept
+{
+    return static_cast<std::size_t>(((h >> 32) * n) >> 32);
+}
+
+// Second hash of an already mixed key
+constexpr uint64_t displace(uint64_t h, uint32_t seed) noexcept
+{
+    h += seed * 0x9E3779B97F4A7C15ull;
+    h ^= h >> 29;
+    h *= 0xBF58476D1CE4E5B9ull;
+    return h ^ h >> 32;
+}
+
+/*
+ * Perfect hash of a fixed set of 64-bit keys, "hash, displace and compress" (CHD).
+ *
+ * The keys are split into buckets of about four keys by a first hash. Starting from the largest
+ * bucket, every bucket gets the first seed which moves all its keys to free slots of the table by
+ * a second hash, so index() is one bucket load and two hashes, without probing or division. The
+ * table has about 25% more slots than keys. A key which is not in the set gets an arbitrary slot:
+ * the caller compares the key stored in the slot.
+ */
+class PerfectHash
+{
+public:
+    PerfectHash() = default;
+
+    PerfectHash(PerfectHash const&) = default;
+    PerfectHash& operator= (PerfectHash const&) = default;
+    PerfectHash(PerfectHash&&) = default;
+    PerfectHash& operator= (PerfectHash&&) = default;
+
+    // The keys must be distinct
+    explicit PerfectHash(const std::vector<uint64_t>& keys)
+    {
+        if (keys.empty()) {
+            return;
+        }
+        // A failed seed search is very unlikely, a larger table makes the next one easier. Equal
+        // keys can never be placed
+        for (auto slots = keys.size() + keys.size() / 4 + 1; slots < keys.size() * 8 + 8;
+             slots += slots / 4 + 1) {
+            if (build(keys, slots)) {
+                return;
+            }
+        }
+        throw std::invalid_argument("PerfectHash: the keys are not distinct");
+    }
+
+    // Slot of the key in [0, size())
+    std::size_t index(uint64_t key) const noexcept
+    {
+        if (m_seeds.empty()) {
+            return 0;
+        }
+        auto h = mix(key);
+        auto seed = m_seeds[reduce(h, m_seeds.size())];
+        return reduce(displace(h, seed), m_size);
+    }
+
+    // Number of slots, 0 for an empty set of keys
+    std::size_t size() const noexcept
+    {
+        return m_size;
+    }
+
+private:
+    static constexpr uint32_t max_seed = 1u << 16;
+
+    bool build(const std::vector<uint64_t>& keys, std::size_t slots)
+    {
+        auto bucket_count = (keys.size() + 3) / 4;
+        std::vector<std::vector<uint64_t>> buckets(bucket_count);
+        for (auto key : keys) {
+            auto h = mix(key);
+            buckets[reduce(h, bucket_count)].push_back(h);
+        }
+        std::vector<std::size_t> order(bucket_count);
+        for (std::size_t i = 0; i < bucket_count; ++i) {
+            order[i] = i;
+        }
+        std::stable_sort(order.begin(), order.end(), [&](std::size_t lhs, std::size_t rhs) {
+            return buckets[lhs].size() > buckets[rhs].size();
+        });
+
+        std::vector<uint32_t> seeds(bucket_count, 0);
+        std::vector<bool> taken(slots, false);
+        std::vector<std::size_t> placed;
+        for (auto b : order) {
+            const auto& bucket = buckets[b];
+            if (bucket.empty()) {
+                break;
+            }
+            uint32_t seed = 0;
+            for (; seed < max_seed; ++seed) {
+                placed.clear();
+                for (auto h : bucket) {
+                    auto slot = reduce(displace(h, seed), slots);
+                    if (taken[slot] || std::find(placed.begin(), placed.end(), slot)
+                        != placed.end()) {
+                        break;
+                    }
+                    placed.push_back(slot);
+                }
+                if (placed.size() == bucket.size()) {
+                    break;
+                }
+            }
+            if (seed == max_seed) {
+                return false;
+            }
+            for (auto slot : placed) {
+                taken[slot] = true;
+            }
+            seeds[b] = seed;
+        }
+        m_seeds = std::move(seeds);
+        m_size = slots;
+        return true;
+    }
+
+private:
+    std::vector<uint32_t> m_seeds;
+    std::size_t m_size {0};
+};
+
+} // namespace diameter::dictionary::detail
+
+#endif
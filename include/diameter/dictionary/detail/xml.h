@@ -0,0 +1,372 @@
+#ifndef DIAMETER_DICTIONARY_DETAIL_XML_H
+#define DIAMETER_DICTIONARY_DETAIL_XML_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace diameter::dictionary::detail {
+
+struct XmlElement
+{
+    std::string name;
+    std::vector<std::pair<std::string, std::string>> attributes;
+    std::vector<XmlElement> children;
+
+    // The attribute value, nullptr if there is no such attribute
+    const std::string* attribute(std::string_view attribute_name) const noexcept
+    {
+        for (const auto& [n, value] : attributes) {
+            if (n == attribute_name) {
+                return &value;
+            }
+        }
+        return nullptr;
+    }
+};
+
+/*
+ * Reader of the XML subset used by dictionary files: elements, attributes, comments, processing
+ * instructions, CDATA and the document type declaration. Character data is skipped, only the
+ * element tree is kept. Entities declared in the internal subset of the document type, e.g.
+ *
+ *     <!ENTITY nasreq SYSTEM "nasreq.xml">
+ *
+ * are expanded where they are referenced between elements: the content of an external entity is
+ * read by `load` and parsed as a sequence of elements. Errors throw std::runtime_error with the
+ * line of the error.
+ */
+class XmlReader
+{
+public:
+    using Loader = std::function<std::string(const std::string& system_id)>;
+
+    explicit XmlReader(Loader load = nullptr)
+        : m_load(std::move(load))
+    {
+    }
+
+    // The top level elements of the document or of a fragment
+    std::vector<XmlElement> parse(std::string_view text)
+    {
+        return parse(text, 0);
+    }
+
+private:
+    struct Entity
+    {
+        std::string name;
+        std::string value;
+        bool external;
+    };
+
+    static constexpr std::size_t max_depth = 16;
+
+    std::vector<XmlElement> parse(std::string_view text, std::size_t depth)
+    {
+        if (depth > max_depth) {
+            throw std::runtime_error("dictionary: entities nested too deep");
+        }
+        auto saved_text = m_text;
+        auto saved_pos = m_pos;
+        m_text = text;
+        m_pos = 0;
+
+        std::vector<XmlElement> elements;
+        content(elements, depth);
+        if (m_pos != m_text.size()) {
+            fail("unexpected closing tag");
+        }
+
+        m_text = saved_text;
+        m_pos = saved_pos;
+        return elements;
+    }
+
+    // Elements up to the end of the text or a closing tag
+    void content(std::vector<XmlElement>& elements, std::size_t depth)
+    {
+        while (m_pos < m_text.size()) {
+            auto c = m_text[m_pos];
+            if (c == '&') {
+                reference(elements, depth);
+            }
+            else if (c != '<') {
+                ++m_pos;
+            }
+            else if (starts_with("</")) {
+                return;
+            }
+            else if (starts_with("<!--")) {
+                skip_past("-->");
+            }
+            else if (starts_with("<![CDATA[")) {
+                skip_past("]]>");
+            }
+            else if (starts_with("<?")) {
+                skip_past("?>");
+            }
+            else if (starts_with("<!DOCTYPE")) {
+                doctype();
+            }
+            else {
+                elements.push_back(element(depth));
+            }
+        }
+    }
+
+    XmlElement element(std::size_t depth)
+    {
+        ++m_pos;
+        XmlElement result;
+        result.name = name();
+        for (;;) {
+            skip_space();
+            if (starts_with("/>")) {
+                m_pos += 2;
+                return result;
+            }
+            if (starts_with(">")) {
+                ++m_pos;
+                break;
+            }
+            auto attribute_name = name();
+            skip_space();
+            expect('=');
+            skip_space();
+            result.attributes.emplace_back(std::move(attribute_name), quoted());
+        }
+        content(result.children, depth);
+        if (!starts_with("</")) {
+            fail("missing closing tag of " + result.name);
+        }
+        m_pos += 2;
+        if (name() != result.name) {
+            fail("mismatched closing tag of " + result.name);
+        }
+        skip_space();
+        expect('>');
+        return result;
+    }
+
+    // <!DOCTYPE name SYSTEM "uri" [ <!ENTITY ...> ... ]>
+    void doctype()
+    {
+        m_pos += 9;
+        while (m_pos < m_text.size() && m_text[m_pos] != '[' && m_text[m_pos] != '>') {
+            if (m_text[m_pos] == '"' || m_text[m_pos] == '\'') {
+                quoted();
+            }
+            else {
+                ++m_pos;
+            }
+        }
+        if (m_pos < m_text.size() && m_text[m_pos] == '[') {
+            ++m_pos;
+            for (;;) {
+                skip_space();
+                if (starts_with("]")) {
+                    ++m_pos;
+                    break;
+                }
+                if (starts_with("<!ENTITY")) {
+                    entity();
+                }
+                else if (starts_with("<!--")) {
+                    skip_past("-->");
+                }
+                else if (starts_with("<!") || starts_with("<?")) {
+                    skip_past(">");
+                }
+                else {
+                    fail("invalid document type declaration");
+                }
+            }
+            skip_space();
+        }
+        expect('>');
+    }
+
+    void entity()
+    {
+        m_pos += 8;
+        skip_space();
+        Entity result {name(), "", false};
+        skip_space();
+        if (starts_with("SYSTEM")) {
+            m_pos += 6;
+            skip_space();
+            result.external = true;
+        }
+        result.value = quoted();
+        skip_space();
+        expect('>');
+        m_entities.push_back(std::move(result));
+    }
+
+    void reference(std::vector<XmlElement>& elements, std::size_t depth)
+    {
+        auto end = m_text.find(';', m_pos);
+        if (end == std::string_view::npos) {
+            fail("unterminated reference");
+        }
+        auto entity_name = m_text.substr(m_pos + 1, end - m_pos - 1);
+        m_pos = end + 1;
+        for (const auto& e : m_entities) {
+            if (e.name != entity_name) {
+                continue;
+            }
+            if (e.external && !m_load) {
+                fail("external entity " + e.name + " without a loader");
+            }
+            // The entity may declare entities too, `e` is not used after parsing
+            auto text = e.external ? m_load(e.value) : e.value;
+            auto nested = parse(text, depth + 1);
+            elements.insert(elements.end(), std::make_move_iterator(nested.begin()),
+                std::make_move_iterator(nested.end()));
+            return;
+        }
+        // Predefined and character references stand for character data
+        if (entity_name.empty()
+            || (entity_name != "lt" && entity_name != "gt" && entity_name != "amp"
+                && entity_name != "apos" && entity_name != "quot" && entity_name[0] != '#')) {
+            fail("undeclared entity " + std::string(entity_name));
+        }
+    }
+
+    std::string name()
+    {
+        auto begin = m_pos;
+        while (m_pos < m_text.size()) {
+            auto c = m_text[m_pos];
+            if (c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '=' || c == '>'
+                || c == '/' || c == '"' || c == '\'') {
+                break;
+            }
+            ++m_pos;
+        }
+        if (begin == m_pos) {
+            fail("name expected");
+        }
+        return std::string(m_text.substr(begin, m_pos - begin));
+    }
+
+    // Quoted attribute value with the predefined and character references replaced
+    std::string quoted()
+    {
+        if (m_pos == m_text.size() || (m_text[m_pos] != '"' && m_text[m_pos] != '\'')) {
+            fail("quoted value expected");
+        }
+        auto quote = m_text[m_pos++];
+        auto end = m_text.find(quote, m_pos);
+        if (end == std::string_view::npos) {
+            fail("unterminated value");
+        }
+        auto raw = m_text.substr(m_pos, end - m_pos);
+        m_pos = end + 1;
+
+        std::string value;
+        for (std::size_t i = 0; i < raw.size(); ++i) {
+            auto semicolon = raw[i] == '&' ? raw.find(';', i) : std::string_view::npos;
+            if (semicolon == std::string_view::npos) {
+                value += raw[i];
+                continue;
+            }
+            auto ref = raw.substr(i + 1, semicolon - i - 1);
+            i = semicolon;
+            if (ref == "lt") {
+                value += '<';
+            }
+            else if (ref == "gt") {
+                value += '>';
+            }
+            else if (ref == "amp") {
+                value += '&';
+            }
+            else if (ref == "apos") {
+                value += '\'';
+            }
+            else if (ref == "quot") {
+                value += '"';
+            }
+            else if (ref.size() > 1 && ref[0] == '#') {
+                value += character(ref.substr(1));
+            }
+            else {
+                fail("unknown reference in a value");
+            }
+        }
+        return value;
+    }
+
+    // "#65" or "#x41" without '#'; dictionaries are ASCII, other characters become '?'
+    char character(std::string_view ref) const
+    {
+        auto hex = ref[0] == 'x';
+        unsigned long code = 0;
+        for (auto c : ref.substr(hex ? 1 : 0)) {
+            auto digit = c >= '0' && c <= '9' ? c - '0'
+                : hex && c >= 'a' && c <= 'f' ? c - 'a' + 10
+                : hex && c >= 'A' && c <= 'F' ? c - 'A' + 10 : -1;
+            if (digit < 0 || code > 0x10FFFF) {
+                fail("invalid character reference");
+            }
+            code = code * (hex ? 16 : 10) + static_cast<unsigned long>(digit);
+        }
+        return code < 0x80 ? static_cast<char>(code) : '?';
+    }
+
+    void skip_space() noexcept
+    {
+        while (m_pos < m_text.size()
+            && (m_text[m_pos] == ' ' || m_text[m_pos] == '\t' || m_text[m_pos] == '\r'
+                || m_text[m_pos] == '\n')) {
+            ++m_pos;
+        }
+    }
+
+    void skip_past(std::string_view terminator)
+    {
+        auto end = m_text.find(terminator, m_pos);
+        if (end == std::string_view::npos) {
+            fail("unterminated markup");
+        }
+        m_pos = end + terminator.size();
+    }
+
+    void expect(char c)
+    {
+        if (m_pos == m_text.size() || m_text[m_pos] != c) {
+            fail(std::string("'") + c + "' expected");
+        }
+        ++m_pos;
+    }
+
+    bool starts_with(std::string_view prefix) const noexcept
+    {
+        return m_text.substr(m_pos, prefix.size()) == prefix;
+    }
+
+    [[noreturn]] void fail(const std::string& reason) const
+    {
+        auto line = 1 + std::count(m_text.begin(),
+            m_text.begin() + static_cast<std::ptrdiff_t>(std::min(m_pos, m_text.size())), '\n');
+        throw std::runtime_error("dictionary: " + reason + " at line " + std::to_string(line));
+    }
+
+private:
+    Loader m_load;
+    std::vector<Entity> m_entities;
+    std::string_view m_text;
+    std::size_t m_pos {0};
+};
+
+} // namespace diameter::dictionary::detail
+
+#endif
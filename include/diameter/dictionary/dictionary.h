@@ -0,0 +1,375 @@
+#ifndef DIAMETER_DICTIONARY_DICTIONARY_H
+#define DIAMETER_DICTIONARY_DICTIONARY_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <diameter/dictionary/detail/perfect_hash.h>
+#include <diameter/message/avp/avp.h>
+#include <diameter/message/header/application_id.h>
+#include <diameter/message/header/command_code.h>
+
+namespace diameter::dictionary {
+
+// Type of an AVP value: the index of the alternative of message::avp::Value
+struct AvpTypeV
+{
+    enum Value : uint8_t
+    {
+        OctetString      = 0,
+        Integer32        = 1,
+        Integer64        = 2,
+        Unsigned32       = 3,
+        Unsigned64       = 4,
+        Float32          = 5,
+        Float64          = 6,
+        Address          = 7,
+        Time             = 8,
+        UTF8String       = 9,
+        DiameterIdentity = 10,
+        DiameterURI      = 11,
+        Enumerated       = 12,
+        IPFilterRule     = 13,
+        Grouped          = 14,
+    };
+};
+
+static_assert(std::is_same_v<std::variant_alternative_t<AvpTypeV::Address, message::avp::Value>,
+    message::avp::Address>);
+static_assert(std::is_same_v<std::variant_alternative_t<AvpTypeV::Grouped, message::avp::Value>,
+    message::avp::Grouped>);
+static_assert(std::variant_size_v<message::avp::Value> == AvpTypeV::Grouped + 1);
+
+// Position of an AVP in the ABNF of a command or a Grouped AVP, RFC 6733 3.2
+struct RuleSectionV
+{
+    enum Value : uint8_t
+    {
+        Fixed    = 0, // < AVP-Name >, at the given position
+        Required = 1, // { AVP-Name }
+        Optional = 2, // [ AVP-Name ]
+    };
+};
+
+/*
+ * One element of a command or Grouped AVP grammar: the AVP, its section and the number of
+ * occurrences, e.g. "*2{ Route-Record }" is Required with min 1 and max 2.
+ */
+struct AvpRule
+{
+    static constexpr uint32_t unbounded = std::numeric_limits<uint32_t>::max();
+
+    std::string name;
+    message::avp::Code code {0};
+    message::avp::VendorId vendor_id {0};
+    RuleSectionV::Value section {RuleSectionV::Optional};
+    uint32_t min {0};
+    uint32_t max {unbounded};
+};
+
+/*
+ * Grammar of a command or of a Grouped AVP. `any_avp` is set by the "* [ AVP ]" element: AVPs
+ * which are not listed are allowed too.
+ */
+struct AvpRules
+{
+    std::vector<AvpRule> rules;
+    bool any_avp {false};
+};
+
+struct EnumValue
+{
+    std::string name;
+    int32_t code {0};
+};
+
+/*
+ * Definition of an AVP. `vendor_id` is 0 for AVPs without the 'V' flag. `flag_bits` are the flags
+ * the AVP must be sent with (message::avp::FlagBits). `rules` are the grammar of a Grouped AVP.
+ */
+struct AvpDefinition
+{
+    std::string name;
+    message::avp::Code code {0};
+    message::avp::VendorId vendor_id {0};
+    AvpTypeV::Value type {AvpTypeV::OctetString};
+    uint8_t flag_bits {0};
+    std::vector<EnumValue> values;
+    AvpRules rules;
+};
+
+/*
+ * Definition of a command, the grammars of the request and of the answer
+ */
+struct CommandDefinition
+{
+    std::string name;
+    message::header::CommandCode code {0};
+    message::header::ApplicationId application_id {0};
+    AvpRules request;
+    AvpRules answer;
+};
+
+struct VendorDefinition
+{
+    std::string name;
+    message::avp::VendorId id {0};
+};
+
+/*
+ * Entries of the constexpr tables of a generated dictionary (see tools/dictgen), the counterparts
+ * of AvpDefinition and CommandDefinition without the grammars.
+ */
+struct AvpEntry
+{
+    std::string_view name;
+    message::avp::Code code {0};
+    message::avp::VendorId vendor_id {0};
+    AvpTypeV::Value type {AvpTypeV::OctetString};
+    uint8_t flag_bits {0};
+};
+
+struct CommandEntry
+{
+    std::string_view name;
+    message::header::CommandCode code {0};
+    message::header::ApplicationId application_id {0};
+};
+
+/*
+ * A dictionary for the decoding of serial/dictionary.h: `find(code, vendor_id)` returns a pointer
+ * to a definition with the `type` of the AVP, or nullptr. Dictionary and the generated
+ * dictionaries are.
+ */
+template<typename D, typename = void>
+struct is_dictionary : std::false_type
+{
+};
+
+template<typename D>
+struct is_dictionary<D, std::void_t<decltype(std::declval<const D&>()
+    .find(message::avp::Code {}, message::avp::VendorId {})->type)>> : std::true_type
+{
+};
+
+template<typename D>
+inline constexpr bool is_dictionary_v = is_dictionary<D>::value;
+
+/*
+ * Runtime dictionary of AVP and command definitions, e.g. loaded from XML files at startup (see
+ * dictionary/xml.h).
+ *
+ * The dictionary is immutable once constructed, so it is shared by the decoding threads without
+ * locking. AVPs are found by (code, vendor id) through a perfect hash built for the loaded set:
+ * one slot per lookup, without probing. A later definition of the same AVP or command replaces
+ * the earlier one. The rules refer to AVPs by name; they get their codes here, the rules of AVPs
+ * which are not defined are dropped.
+ */
+class Dictionary
+{
+public:
+    Dictionary() = default;
+
+    Dictionary(Dictionary const&) = default;
+    Dictionary& operator= (Dictionary const&) = default;
+    Dictionary(Dictionary&&) = default;
+    Dictionary& operator= (Dictionary&&) = default;
+
+    Dictionary(std::vector<VendorDefinition> vendors, std::vector<AvpDefinition> avps,
+        std::vector<CommandDefinition> commands)
+        : m_vendors(std::move(vendors))
+    {
+        add_avps(std::move(avps));
+        add_commands(std::move(commands));
+        build();
+    }
+
+    const AvpDefinition* find(message::avp::Code code, message::avp::VendorId vendor_id = 0) const
+        noexcept
+    {
+        if (m_slots.empty()) {
+            return nullptr;
+        }
+        auto k = key(code, vendor_id);
+        const auto& slot = m_slots[m_hash.index(k)];
+        return slot.key == k && slot.index != npos ? &m_avps[slot.index] : nullptr;
+    }
+
+    const AvpDefinition* find(std::string_view name) const noexcept
+    {
+        auto it = std::lower_bound(m_avp_names.begin(), m_avp_names.end(), name,
+            [this](std::size_t index, std::string_view n) { return m_avps[index].name < n; });
+        return it != m_avp_names.end() && m_avps[*it].name == name ? &m_avps[*it] : nullptr;
+    }
+
+    // The command of the application, or of the base protocol (application 0)
+    const CommandDefinition* find_command(message::header::CommandCode code,
+        message::header::ApplicationId application_id = 0) const noexcept
+    {
+        auto found = find_exact_command(code, application_id);
+        return found != nullptr ? found : find_exact_command(code, 0);
+    }
+
+    const VendorDefinition* find_vendor(message::avp::VendorId id) const noexcept
+    {
+        auto it = std::find_if(m_vendors.begin(), m_vendors.end(),
+            [id](const VendorDefinition& vendor) { return vendor.id == id; });
+        return it != m_vendors.end() ? &*it : nullptr;
+    }
+
+    const std::vector<AvpDefinition>& avps() const noexcept
+    {
+        return m_avps;
+    }
+
+    const std::vector<CommandDefinition>& commands() const noexcept
+    {
+        return m_commands;
+    }
+
+    const std::vector<VendorDefinition>& vendors() const noexcept
+    {
+        return m_vendors;
+    }
+
+private:
+    static constexpr uint32_t npos = std::numeric_limits<uint32_t>::max();
+
+    // The key is kept in the slot, a lookup reads the definition only when it is found
+    struct Slot
+    {
+        uint64_t key {0};
+        uint32_t index {npos};
+    };
+
+    static uint64_t key(message::avp::Code code, message::avp::VendorId vendor_id) noexcept
+    {
+        return static_cast<uint64_t>(vendor_id) << 32 | code;
+    }
+
+    void add_avps(std::vector<AvpDefinition> avps)
+    {
+        std::vector<std::pair<uint64_t, std::size_t>> keys;
+        for (std::size_t i = 0; i < avps.size(); ++i) {
+            keys.emplace_back(key(avps[i].code, avps[i].vendor_id), i);
+        }
+        // The last definition of a key wins
+        std::stable_sort(keys.begin(), keys.end(),
+            [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+        std::vector<bool> keep(avps.size(), false);
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            if (i + 1 == keys.size() || keys[i].first != keys[i + 1].first) {
+                keep[keys[i].second] = true;
+            }
+        }
+        for (std::size_t i = 0; i < avps.size(); ++i) {
+            if (keep[i]) {
+                m_avps.push_back(std::move(avps[i]));
+            }
+        }
+    }
+
+    void add_commands(std::vector<CommandDefinition> commands)
+    {
+        for (auto& command : commands) {
+            auto it = std::find_if(m_commands.begin(), m_commands.end(),
+                [&](const CommandDefinition& c) {
+                    return c.code == command.code && c.application_id == command.application_id;
+                });
+            if (it != m_commands.end()) {
+                *it = std::move(command);
+            }
+            else {
+                m_commands.push_back(std::move(command));
+            }
+        }
+        std::sort(m_commands.begin(), m_commands.end(), [](const auto& lhs, const auto& rhs) {
+            return std::pair(lhs.code, lhs.application_id)
+                < std::pair(rhs.code, rhs.application_id);
+        });
+    }
+
+    void build()
+    {
+        m_avp_names.resize(m_avps.size());
+        for (std::size_t i = 0; i < m_avps.size(); ++i) {
+            m_avp_names[i] = i;
+        }
+        std::stable_sort(m_avp_names.begin(), m_avp_names.end(),
+            [this](std::size_t lhs, std::size_t rhs) {
+                return m_avps[lhs].name < m_avps[rhs].name;
+            });
+
+        std::vector<uint64_t> keys;
+        for (const auto& avp : m_avps) {
+            keys.push_back(key(avp.code, avp.vendor_id));
+        }
+        m_hash = detail::PerfectHash(keys);
+        m_slots.assign(m_hash.size(), Slot {});
+        for (std::size_t i = 0; i < m_avps.size(); ++i) {
+            m_slots[m_hash.index(keys[i])] = Slot {keys[i], static_cast<uint32_t>(i)};
+        }
+
+        for (auto& avp : m_avps) {
+            resolve(avp.rules);
+        }
+        for (auto& command : m_commands) {
+            resolve(command.request);
+            resolve(command.answer);
+        }
+    }
+
+    void resolve(AvpRules& rules) const
+    {
+        auto& list = rules.rules;
+        for (auto& rule : list) {
+            if (rule.name == "AVP") {
+                rules.any_avp = true;
+            }
+            else if (const auto* avp = find(rule.name)) {
+                rule.code = avp->code;
+                rule.vendor_id = avp->vendor_id;
+                continue;
+            }
+            rule.name.clear();
+        }
+        list.erase(std::remove_if(list.begin(), list.end(),
+            [](const AvpRule& rule) { return rule.name.empty(); }), list.end());
+    }
+
+    const CommandDefinition* find_exact_command(message::header::CommandCode code,
+        message::header::ApplicationId application_id) const noexcept
+    {
+        auto it = std::lower_bound(m_commands.begin(), m_commands.end(),
+            std::pair(code, application_id), [](const CommandDefinition& command, const auto& k) {
+                return std::pair(command.code, command.application_id) < k;
+            });
+        return it != m_commands.end() && it->code == code && it->application_id == application_id
+            ? &*it : nullptr;
+    }
+
+private:
+    std::vector<VendorDefinition> m_vendors;
+    std::vector<AvpDefinition> m_avps;
+    std::vector<CommandDefinition> m_commands;
+
+    // Indexes of m_avps sorted by name
+    std::vector<std::size_t> m_avp_names;
+    detail::PerfectHash m_hash;
+    // Slot of the perfect hash -> key and index of m_avps
+    std::vector<Slot> m_slots;
+};
+
+static_assert(is_dictionary_v<Dictionary>);
+
+} // namespace diameter::dictionary
+
+#endif
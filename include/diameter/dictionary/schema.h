@@ -0,0 +1,230 @@
+#ifndef DIAMETER_DICTIONARY_SCHEMA_H
+#define DIAMETER_DICTIONARY_SCHEMA_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <diameter/application/base/result_code.h>
+#include <diameter/dictionary/dictionary.h>
+#include <diameter/message/avp/avp.h>
+#include <diameter/message/avp/avp_def.h>
+#include <diameter/message/message.h>
+
+namespace diameter::dictionary {
+
+// One element of a CommandSchema, an AvpRule with its AVP resolved
+struct SchemaRule
+{
+    message::avp::Code code {0};
+    message::avp::VendorId vendor_id {0};
+    RuleSectionV::Value section {RuleSectionV::Optional};
+    uint32_t min {0};
+    uint32_t max {AvpRule::unbounded};
+};
+
+/*
+ * The ABNF of a command, RFC 6733 3.2, as a view of rules: constexpr arrays in the generated
+ * dictionaries (see tools/dictgen), or the storage of a Schema. The rules are in the order of the
+ * grammar, the Fixed ones first; `index` lists them sorted by vendor id and code for the lookup of
+ * an AVP. At most max_rules rules, so validate() counts the occurrences on the stack.
+ */
+struct CommandSchema
+{
+    static constexpr std::size_t max_rules = 64;
+
+    const SchemaRule* rules {nullptr};
+    const uint8_t* index {nullptr};
+    uint8_t size {0};
+    // Number of the leading Fixed rules
+    uint8_t fixed {0};
+    // "* [ AVP ]": the AVPs which are not listed are allowed
+    bool any_avp {false};
+
+    // The position of the rule of the AVP, std::nullopt if it is not listed
+    constexpr std::optional<std::size_t> find(message::avp::Code code,
+        message::avp::VendorId vendor_id) const noexcept
+    {
+        std::size_t first = 0;
+        std::size_t last = size;
+        while (first < last) {
+            auto middle = first + (last - first) / 2;
+            const auto& rule = rules[index[middle]];
+            if (rule.vendor_id == vendor_id && rule.code == code) {
+                return index[middle];
+            }
+            if (rule.vendor_id < vendor_id || (rule.vendor_id == vendor_id && rule.code < code)) {
+                first = middle + 1;
+            }
+            else {
+                last = middle;
+            }
+        }
+        return std::nullopt;
+    }
+};
+
+/*
+ * The storage of a CommandSchema built at runtime from the grammar of a command of a Dictionary,
+ * e.g. Schema(dictionary.find_command(272, 4)->request). The rules of Fixed AVPs are moved first,
+ * in their order. More than CommandSchema::max_rules rules throw std::invalid_argument.
+ */
+class Schema
+{
+public:
+    Schema() = default;
+
+    Schema(Schema const&) = default;
+    Schema& operator= (Schema const&) = default;
+    Schema(Schema&&) = default;
+    Schema& operator= (Schema&&) = default;
+
+    explicit Schema(const AvpRules& rules)
+        : m_any_avp(rules.any_avp)
+    {
+        if (rules.rules.size() > CommandSchema::max_rules) {
+            throw std::invalid_argument("Schema: too many rules");
+        }
+        for (const auto& rule : rules.rules) {
+            m_rules.push_back(SchemaRule {rule.code, rule.vendor_id, rule.section, rule.min,
+                rule.max});
+        }
+        auto fixed = std::stable_partition(m_rules.begin(), m_rules.end(),
+            [](const SchemaRule& rule) { return rule.section == RuleSectionV::Fixed; });
+        m_fixed = static_cast<uint8_t>(fixed - m_rules.begin());
+
+        for (std::size_t i = 0; i < m_rules.size(); ++i) {
+            m_index.push_back(static_cast<uint8_t>(i));
+        }
+        std::stable_sort(m_index.begin(), m_index.end(), [this](uint8_t lhs, uint8_t rhs) {
+            return std::pair(m_rules[lhs].vendor_id, m_rules[lhs].code)
+                < std::pair(m_rules[rhs].vendor_id, m_rules[rhs].code);
+        });
+    }
+
+    CommandSchema view() const noexcept
+    {
+        return CommandSchema {m_rules.data(), m_index.data(), static_cast<uint8_t>(m_rules.size()),
+            m_fixed, m_any_avp};
+    }
+
+private:
+    std::vector<SchemaRule> m_rules;
+    std::vector<uint8_t> m_index;
+    uint8_t m_fixed {0};
+    bool m_any_avp {false};
+};
+
+/*
+ * The first violation of a grammar found by validate(): the Result-Code of the answer and the AVP
+ * for its Failed-AVP, RFC 6733 7.5. `avp` is the offending AVP of the message, nullptr for a
+ * missing one. No violation is DIAMETER_SUCCESS.
+ */
+struct SchemaViolation
+{
+    uint32_t result_code {application::base::ResultCodeV::Success};
+    message::avp::Code code {0};
+    message::avp::VendorId vendor_id {0};
+    const message::avp::AVP* avp {nullptr};
+
+    explicit operator bool() const noexcept
+    {
+        return result_code != application::base::ResultCodeV::Success;
+    }
+
+    /*
+     * The content of the Failed-AVP AVP: a copy of the offending AVP, or an example of the missing
+     * AVP with the Vendor-Id and an empty value.
+     */
+    message::avp::AVP failed_avp() const
+    {
+        namespace dma = message::avp;
+        if (avp != nullptr) {
+            return *avp;
+        }
+        auto bits = static_cast<uint8_t>(dma::FlagBits::Mandatory
+            | (vendor_id != 0 ? dma::FlagBits::VendorSpecific : dma::FlagBits::None));
+        return dma::AVP {code, dma::Flags {bits},
+            vendor_id != 0 ? std::optional<dma::VendorId>(vendor_id) : std::nullopt,
+            dma::OctetString()};
+    }
+};
+
+/*
+ * Checks the AVPs of a message against the grammar of its command in one pass, without
+ * allocation: the occurrences of the listed AVPs are counted on the stack. The violations are,
+ * in the order they are found:
+ *
+ * - DIAMETER_MISSING_AVP: an AVP of a Fixed rule is not at its position;
+ * - DIAMETER_AVP_UNSUPPORTED: an AVP with the 'M' flag which is neither listed nor known to the
+ *   dictionary;
+ * - DIAMETER_AVP_NOT_ALLOWED: an AVP which is not listed, without "* [ AVP ]", or whose rule
+ *   has a maximum of 0;
+ * - DIAMETER_AVP_OCCURS_TOO_MANY_TIMES: the occurrence past the maximum of the rule;
+ * - DIAMETER_MISSING_AVP: the first rule of the grammar with fewer occurrences than its minimum.
+ *
+ * The dictionary is a Dictionary or a generated one. Grouped values are not descended into.
+ */
+template<typename Dictionary>
+SchemaViolation validate(const message::avp::AvpList& avps, const CommandSchema& schema,
+    const Dictionary& dictionary) noexcept
+{
+    static_assert(is_dictionary_v<Dictionary>, "validate: not a dictionary");
+    using application::base::ResultCodeV;
+
+    std::array<uint32_t, CommandSchema::max_rules> counts {};
+    std::size_t position = 0;
+    for (const auto& avp : avps) {
+        auto vendor_id = avp.vendor_id.value_or(0);
+        if (position < schema.fixed) {
+            const auto& fixed = schema.rules[position];
+            if (avp.code != fixed.code || vendor_id != fixed.vendor_id) {
+                return SchemaViolation {ResultCodeV::MissingAvp, fixed.code, fixed.vendor_id,
+                    nullptr};
+            }
+        }
+        ++position;
+
+        auto index = schema.find(avp.code, vendor_id);
+        if (!index) {
+            if (avp.flags[message::avp::Flag::Mandatory]
+                && dictionary.find(avp.code, vendor_id) == nullptr) {
+                return SchemaViolation {ResultCodeV::AvpUnsupported, avp.code, vendor_id, &avp};
+            }
+            if (!schema.any_avp) {
+                return SchemaViolation {ResultCodeV::AvpNotAllowed, avp.code, vendor_id, &avp};
+            }
+            continue;
+        }
+        const auto& rule = schema.rules[*index];
+        if (rule.max == 0) {
+            return SchemaViolation {ResultCodeV::AvpNotAllowed, avp.code, vendor_id, &avp};
+        }
+        if (++counts[*index] > rule.max) {
+            return SchemaViolation {ResultCodeV::AvpOccursTooManyTimes, avp.code, vendor_id, &avp};
+        }
+    }
+    for (std::size_t i = 0; i < schema.size; ++i) {
+        const auto& rule = schema.rules[i];
+        if (counts[i] < rule.min) {
+            return SchemaViolation {ResultCodeV::MissingAvp, rule.code, rule.vendor_id, nullptr};
+        }
+    }
+    return SchemaViolation {};
+}
+
+template<typename Dictionary>
+SchemaViolation validate(const message::Message& msg, const CommandSchema& schema,
+    const Dictionary& dictionary) noexcept
+{
+    return validate(msg.avps, schema, dictionary);
+}
+
+} // namespace diameter::dictionary
+
+#endif
@@ -0,0 +1,354 @@
+#ifndef DIAMETER_DICTIONARY_XML_H
+#define DIAMETER_DICTIONARY_XML_H
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <diameter/dictionary/detail/xml.h>
+#include <diameter/dictionary/dictionary.h>
+#include <diameter/message/avp/avp_def.h>
+
+// Dictionaries in the XML format of Wireshark (diameter/dictionary.xml and the files it includes):
+//
+//     <vendor vendor-id="TGPP" code="10415" name="3GPP"/>
+//     <application id="4" name="Diameter Credit Control">
+//         <command name="Credit-Control" code="272">
+//             <requestrules>
+//                 <fixed><avprule name="Session-Id" maximum="1"/></fixed>
+//                 <required><avprule name="Origin-Host"/>...</required>
+//                 <optional><avprule name="Multiple-Services-Credit-Control"/>...</optional>
+//             </requestrules>
+//             <answerrules>...</answerrules>
+//         </command>
+//         <avp name="CC-Request-Type" code="416" mandatory="must">
+//             <type type-name="Enumerated"/>
+//             <enum name="INITIAL_REQUEST" code="1"/>
+//         </avp>
+//         <avp name="Service-Parameter-Info" code="440" mandatory="must">
+//             <grouped><gavp name="Service-Parameter-Type"/>...</grouped>
+//         </avp>
+//     </application>
+
+namespace diameter::dictionary {
+
+/*
+ * Collects the definitions of one or several XML dictionaries, e.g. the base protocol and the
+ * applications, into one Dictionary. Vendors and types may be referenced before they are defined,
+ * they are resolved by dictionary(). Types derived by <typedefn type-parent="..."> get the type
+ * of their nearest base type, unknown types are OctetString. Rules without "minimum" or
+ * "maximum" are 1 for fixed and required AVPs, optional AVPs are 0 to 1 and the AVPs of <grouped>
+ * are 0 to unbounded. Invalid documents throw std::runtime_error.
+ */
+class XmlLoader
+{
+public:
+    XmlLoader() = default;
+
+    XmlLoader(XmlLoader const&) = default;
+    XmlLoader& operator= (XmlLoader const&) = default;
+    XmlLoader(XmlLoader&&) = default;
+    XmlLoader& operator= (XmlLoader&&) = default;
+
+    // Adds the definitions of the document, without external entities
+    void load(std::string_view text)
+    {
+        for (const auto& element : detail::XmlReader().parse(text)) {
+            visit(element, 0);
+        }
+    }
+
+    // Adds the definitions of the file; the external entities are read relative to its directory
+    void load_file(const std::string& path)
+    {
+        auto slash = path.find_last_of('/');
+        auto directory = slash == std::string::npos ? std::string() : path.substr(0, slash + 1);
+        auto reader = detail::XmlReader([directory](const std::string& system_id) {
+            return read_file(!system_id.empty() && system_id[0] == '/' ? system_id
+                : directory + system_id);
+        });
+        for (const auto& element : reader.parse(read_file(path))) {
+            visit(element, 0);
+        }
+    }
+
+    Dictionary dictionary() const
+    {
+        auto avps = m_avps;
+        for (std::size_t i = 0; i < avps.size(); ++i) {
+            auto& avp = avps[i];
+            avp.vendor_id = vendor(m_avp_vendors[i]);
+            if (avp.vendor_id != 0) {
+                avp.flag_bits |= message::avp::FlagBits::VendorSpecific;
+            }
+            if (avp.type != AvpTypeV::Grouped) {
+                avp.type = type(m_avp_types[i]);
+            }
+        }
+        return Dictionary(m_vendors, std::move(avps), m_commands);
+    }
+
+private:
+    static std::string read_file(const std::string& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            throw std::runtime_error("dictionary: cannot read " + path);
+        }
+        std::ostringstream text;
+        text << file.rdbuf();
+        return text.str();
+    }
+
+    static std::string attribute(const detail::XmlElement& element, std::string_view name,
+        std::string_view default_value = {})
+    {
+        const auto* value = element.attribute(name);
+        return value != nullptr ? *value : std::string(default_value);
+    }
+
+    static std::optional<uint64_t> digits(std::string_view text) noexcept
+    {
+        if (text.empty() || text.size() > 10) {
+            return std::nullopt;
+        }
+        uint64_t result = 0;
+        for (auto c : text) {
+            if (c < '0' || c > '9') {
+                return std::nullopt;
+            }
+            result = result * 10 + static_cast<uint64_t>(c - '0');
+        }
+        return result;
+    }
+
+    [[noreturn]] static void invalid(const detail::XmlElement& element, std::string_view name)
+    {
+        throw std::runtime_error("dictionary: invalid " + std::string(name) + " of " + element.name
+            + " " + attribute(element, "name"));
+    }
+
+    // Unsigned 32-bit decimal number
+    static uint32_t number(const detail::XmlElement& element, std::string_view name)
+    {
+        const auto* value = element.attribute(name);
+        auto result = value != nullptr ? digits(*value) : std::nullopt;
+        if (!result || *result > UINT32_MAX) {
+            invalid(element, name);
+        }
+        return static_cast<uint32_t>(*result);
+    }
+
+    // Signed 32-bit decimal number, the code of an enum
+    static int32_t signed_number(const detail::XmlElement& element, std::string_view name)
+    {
+        auto text = attribute(element, name);
+        auto negative = !text.empty() && text[0] == '-';
+        auto result = digits(std::string_view(text).substr(negative ? 1 : 0));
+        if (!result || *result > (negative ? uint64_t {1} << 31 : INT32_MAX)) {
+            invalid(element, name);
+        }
+        auto value = static_cast<int64_t>(*result);
+        return static_cast<int32_t>(negative ? -value : value);
+    }
+
+    void visit(const detail::XmlElement& element, message::header::ApplicationId application_id)
+    {
+        if (element.name == "avp") {
+            add_avp(element);
+        }
+        else if (element.name == "command") {
+            add_command(element, application_id);
+        }
+        else if (element.name == "vendor") {
+            m_vendors.push_back(VendorDefinition {attribute(element, "name"),
+                number(element, "code")});
+            m_vendor_names.push_back(attribute(element, "vendor-id"));
+        }
+        else if (element.name == "typedefn") {
+            m_types.emplace_back(attribute(element, "type-name"),
+                attribute(element, "type-parent"));
+        }
+        else {
+            if (element.name == "application") {
+                application_id = number(element, "id");
+            }
+            for (const auto& child : element.children) {
+                visit(child, application_id);
+            }
+        }
+    }
+
+    void add_avp(const detail::XmlElement& element)
+    {
+        AvpDefinition avp;
+        avp.name = attribute(element, "name");
+        avp.code = number(element, "code");
+        if (attribute(element, "mandatory") == "must") {
+            avp.flag_bits |= message::avp::FlagBits::Mandatory;
+        }
+        if (attribute(element, "protected") == "must") {
+            avp.flag_bits |= message::avp::FlagBits::Protected;
+        }
+        std::string type_name = "OctetString";
+        for (const auto& child : element.children) {
+            if (child.name == "type") {
+                type_name = attribute(child, "type-name");
+            }
+            else if (child.name == "enum") {
+                avp.values.push_back(EnumValue {attribute(child, "name"),
+                    signed_number(child, "code")});
+            }
+            else if (child.name == "grouped") {
+                avp.type = AvpTypeV::Grouped;
+                add_rules(child, RuleSectionV::Optional, avp.rules, true);
+            }
+        }
+        m_avps.push_back(std::move(avp));
+        m_avp_vendors.push_back(attribute(element, "vendor-id", "None"));
+        m_avp_types.push_back(std::move(type_name));
+    }
+
+    void add_command(const detail::XmlElement& element,
+        message::header::ApplicationId application_id)
+    {
+        CommandDefinition command;
+        command.name = attribute(element, "name");
+        command.code = number(element, "code");
+        command.application_id = application_id;
+        for (const auto& child : element.children) {
+            if (child.name == "requestrules") {
+                add_sections(child, command.request);
+            }
+            else if (child.name == "answerrules") {
+                add_sections(child, command.answer);
+            }
+        }
+        m_commands.push_back(std::move(command));
+    }
+
+    void add_sections(const detail::XmlElement& element, AvpRules& rules)
+    {
+        for (const auto& section : element.children) {
+            if (section.name == "fixed") {
+                add_rules(section, RuleSectionV::Fixed, rules, false);
+            }
+            else if (section.name == "required") {
+                add_rules(section, RuleSectionV::Required, rules, false);
+            }
+            else if (section.name == "optional") {
+                add_rules(section, RuleSectionV::Optional, rules, false);
+            }
+        }
+    }
+
+    void add_rules(const detail::XmlElement& element, RuleSectionV::Value section,
+        AvpRules& rules, bool grouped)
+    {
+        for (const auto& child : element.children) {
+            if (child.name != "avprule" && child.name != "gavp") {
+                continue;
+            }
+            AvpRule rule;
+            rule.name = attribute(child, "name");
+            rule.section = section;
+            rule.min = grouped || section == RuleSectionV::Optional ? 0 : 1;
+            rule.max = grouped ? AvpRule::unbounded : 1;
+            if (child.attribute("minimum") != nullptr) {
+                rule.min = number(child, "minimum");
+            }
+            auto maximum = attribute(child, "maximum");
+            if (maximum == "*" || maximum == "unbounded") {
+                rule.max = AvpRule::unbounded;
+            }
+            else if (!maximum.empty()) {
+                rule.max = number(child, "maximum");
+            }
+            rules.rules.push_back(std::move(rule));
+        }
+    }
+
+    message::avp::VendorId vendor(const std::string& name) const
+    {
+        if (name.empty() || name == "None") {
+            return 0;
+        }
+        for (std::size_t i = 0; i < m_vendors.size(); ++i) {
+            if (m_vendor_names[i] == name) {
+                return m_vendors[i].id;
+            }
+        }
+        if (auto id = digits(name); id && *id <= UINT32_MAX) {
+            return static_cast<message::avp::VendorId>(*id);
+        }
+        throw std::runtime_error("dictionary: unknown vendor " + name);
+    }
+
+    AvpTypeV::Value type(std::string name) const
+    {
+        static const std::pair<std::string_view, AvpTypeV::Value> base_types[] = {
+            {"OctetString", AvpTypeV::OctetString},
+            {"Integer32", AvpTypeV::Integer32},
+            {"Integer64", AvpTypeV::Integer64},
+            {"Unsigned32", AvpTypeV::Unsigned32},
+            {"Unsigned64", AvpTypeV::Unsigned64},
+            {"Float32", AvpTypeV::Float32},
+            {"Float64", AvpTypeV::Float64},
+            {"Address", AvpTypeV::Address},
+            {"IPAddress", AvpTypeV::Address},
+            {"Time", AvpTypeV::Time},
+            {"UTF8String", AvpTypeV::UTF8String},
+            {"DiameterIdentity", AvpTypeV::DiameterIdentity},
+            {"DiameterURI", AvpTypeV::DiameterURI},
+            {"Enumerated", AvpTypeV::Enumerated},
+            {"IPFilterRule", AvpTypeV::IPFilterRule},
+            {"Grouped", AvpTypeV::Grouped},
+        };
+        // The chain of parents ends at a base type; a loop ends after every typedefn is seen once
+        for (std::size_t step = 0; step <= m_types.size(); ++step) {
+            for (const auto& [base_name, base_type] : base_types) {
+                if (name == base_name) {
+                    return base_type;
+                }
+            }
+            auto it = std::find_if(m_types.begin(), m_types.end(),
+                [&name](const auto& typedefn) { return typedefn.first == name; });
+            if (it == m_types.end() || it->second.empty()) {
+                break;
+            }
+            name = it->second;
+        }
+        return AvpTypeV::OctetString;
+    }
+
+private:
+    std::vector<VendorDefinition> m_vendors;
+    // Symbolic vendor-id of m_vendors, e.g. "TGPP"
+    std::vector<std::string> m_vendor_names;
+    // Type name and parent type name
+    std::vector<std::pair<std::string, std::string>> m_types;
+    std::vector<AvpDefinition> m_avps;
+    // Symbolic vendor-id and type name of m_avps, resolved by dictionary()
+    std::vector<std::string> m_avp_vendors;
+    std::vector<std::string> m_avp_types;
+    std::vector<CommandDefinition> m_commands;
+};
+
+// The dictionary of an XML file and the files it includes
+inline Dictionary load_xml_file(const std::string& path)
+{
+    XmlLoader loader;
+    loader.load_file(path);
+    return loader.dictionary();
+}
+
+} // namespace diameter::dictionary
+
+#endif
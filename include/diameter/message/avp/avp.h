@@ -3,9 +3,11 @@
 
 #include <any>
 #include <cstdint>
-#include <list>
+#include <iterator>
+#include <memory_resource>
 #include <numeric>
 #include <optional>
+#include <string>
 #include <type_traits>
 #include <variant>
 #include <vector>
@@ -27,6 +29,12 @@ namespace diameter::message::avp {
 
 struct AVP;
 
+// AVPs of a message or of a Grouped AVP, stored contiguously. The list, as the OctetString and
+// UTF8String values, is allocator-aware: a message decoded into a std::pmr::memory_resource (e.g. a
+// per-request monotonic arena) keeps all its memory there, as moved AVPs keep their resource.
+// Copies are allocated from the default resource.
+using AvpList = std::pmr::vector<AVP>;
+
 template<typename RawValue>
 class BasicValue;
 
@@ -53,12 +61,25 @@ public:
     template<typename ... Args,
              typename = std::enable_if_t<
              !std::disjunction_v<is_basic_value<std::decay_t<Args>>...>
+             && std::is_constructible_v<RawValue, Args&&...>
              >>
     BasicValue(Args&&... args)
         : m_value(std::forward<decltype(args)>(args)...)
     {
     }
 
+    // Container of another allocator type, e.g. std::vector<uint8_t> for OctetString
+    template<typename Range,
+             typename = std::enable_if_t<
+             !is_basic_value<std::decay_t<Range>>::value
+             && !std::is_constructible_v<RawValue, Range&&>
+             >,
+             typename = decltype(std::begin(std::declval<const Range&>()))>
+    BasicValue(const Range& range)
+        : m_value(std::begin(range), std::end(range))
+    {
+    }
+
     BasicValue(BasicValue const&) = default;
     BasicValue& operator= (BasicValue const&) = default;
     BasicValue(BasicValue&&) = default;
@@ -99,7 +120,7 @@ private:
 };
 
 // RFC 6733 4.2 Basic AVP Data Formats
-using OctetString = BasicValue<std::vector<uint8_t>>;
+using OctetString = BasicValue<std::pmr::vector<uint8_t>>;
 using Integer32 = BasicValue<int32_t>;
 using Integer64 = BasicValue<int64_t>;
 using Unsigned32 = BasicValue<uint32_t>;
@@ -109,13 +130,13 @@ using Float64 = BasicValue<double>;
 // RFC 6733 4.3 Derived AVP Data Formats
 using Address = BasicValue<value::AddressBase>;
 using Time = BasicValue<value::TimeBase>;
-using UTF8String = BasicValue<std::string>;
+using UTF8String = BasicValue<std::pmr::string>;
 using DiameterIdentity = BasicValue<value::DiameterIdentityBase>;
 using DiameterURI = BasicValue<value::DiameterURIBase>;
 using Enumerated = BasicValue<value::EnumeratedBase>;
 using IPFilterRule = BasicValue<value::IPFilterRuleBase>;
 // RFC 6733 4.4 Grouped AVP Values
-using Grouped = BasicValue<std::list<AVP>>;
+using Grouped = BasicValue<AvpList>;
 
 using Value = std::variant<OctetString, Integer32, Integer64, Unsigned32, Unsigned64, Float32,
     Float64, Address, Time, UTF8String, DiameterIdentity, DiameterURI, Enumerated, IPFilterRule,
@@ -178,18 +199,36 @@ struct AVP
 
     Length size() const
     {
-        return length() + padding();
+        auto len = length();
+        return len + padding(len);
     }
 
     Length padding() const
     {
-        auto len = length();
-        uint32_t pad = len % 4;
+        return padding(length());
+    }
+
+    // Padding of an AVP with the given length to a 32-bit boundary
+    static Length padding(Length length)
+    {
+        uint32_t pad = length % 4;
         pad = pad ? 4 - pad : 0;
         return pad;
     }
 };
 
+// AvpList relocates elements on growth, make sure it moves them instead of copying
+static_assert(std::is_nothrow_move_constructible_v<AVP>);
+
+// Size budget: a decoded AVP fits in one 64-byte cache line. Scalars are stored inline, the text
+// values keep their text (DiameterURI and IPFilterRule add the 16-bit offsets of their parts,
+// parsed on first access) and Address keeps up to 16 bytes inline.
+static_assert(sizeof(Flags) == 1);
+static_assert(sizeof(UTF8String) <= 40 && sizeof(DiameterIdentity) <= 40 && sizeof(DiameterURI) <= 40
+    && sizeof(IPFilterRule) <= 40 && sizeof(Address) <= 40 && sizeof(Grouped) <= 40);
+static_assert(sizeof(Value) <= 48);
+static_assert(sizeof(AVP) <= 64);
+
 } // namespace diameter::message::avp
 
 #endif
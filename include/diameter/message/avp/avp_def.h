@@ -0,0 +1,115 @@
+#ifndef DIAMETER_MESSAGE_AVP_AVP_DEF_H
+#define DIAMETER_MESSAGE_AVP_AVP_DEF_H
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include <diameter/message/avp/avp.h>
+#include <diameter/message/avp/code.h>
+#include <diameter/message/avp/flags.h>
+#include <diameter/message/avp/length.h>
+#include <diameter/message/avp/vendor_id.h>
+
+namespace diameter::message::avp {
+
+// Masks of the AVP flags as they are encoded, see Flag
+struct FlagBits
+{
+    enum Value : uint8_t
+    {
+        None           = 0x00,
+        VendorSpecific = 0x80,
+        Mandatory      = 0x40,
+        Protected      = 0x20,
+    };
+};
+
+template<typename T, typename V = Value>
+struct is_value_alternative;
+
+template<typename T, typename... Alternatives>
+struct is_value_alternative<T, std::variant<Alternatives...>>
+    : std::bool_constant<(std::is_same_v<T, Alternatives> || ...)>
+{
+};
+
+template<typename T>
+inline constexpr bool is_value_alternative_v = is_value_alternative<T>::value;
+
+/*
+ * Compile time definition of an AVP: code, vendor id (0 - no vendor), type of the value and
+ * flags. The 'V' flag is set for a non-zero vendor id.
+ *
+ * The encoded AVP header is a constexpr array with a zero AVP Length, so encoding the AVP is one
+ * fixed-size copy, the value and the length. The typed helpers of serial/avp/avp_def.h only
+ * accept values of the defined type, a mismatch is a compile error instead of an
+ * InvalidAvpValueCast at runtime.
+ */
+template<Code CodeV, VendorId VendorIdV, typename T, uint8_t FlagBitsV = FlagBits::Mandatory>
+struct AvpDef
+{
+    static_assert(is_value_alternative_v<T>, "AvpDef: T must be an alternative of Value");
+    static_assert((FlagBitsV & FlagBits::VendorSpecific) == 0 || VendorIdV != 0,
+        "AvpDef: the 'V' flag requires a vendor id");
+
+    using value_type = T;
+
+    static constexpr Code code = CodeV;
+    static constexpr VendorId vendor = VendorIdV;
+    static constexpr bool vendor_specific = VendorIdV != 0;
+    static constexpr uint8_t flag_bits = vendor_specific
+        ? static_cast<uint8_t>(FlagBitsV | FlagBits::VendorSpecific)
+        : FlagBitsV;
+    static constexpr Length header_length = vendor_specific ? 12 : 8;
+
+    // AVP Code, flags, zero AVP Length and Vendor-ID, in network byte order
+    static constexpr std::array<uint8_t, header_length> header = [] {
+        std::array<uint8_t, header_length> h {};
+        h[0] = static_cast<uint8_t>(CodeV >> 24);
+        h[1] = static_cast<uint8_t>(CodeV >> 16);
+        h[2] = static_cast<uint8_t>(CodeV >> 8);
+        h[3] = static_cast<uint8_t>(CodeV);
+        h[4] = flag_bits;
+        if constexpr (vendor_specific) {
+            h[8] = static_cast<uint8_t>(VendorIdV >> 24);
+            h[9] = static_cast<uint8_t>(VendorIdV >> 16);
+            h[10] = static_cast<uint8_t>(VendorIdV >> 8);
+            h[11] = static_cast<uint8_t>(VendorIdV);
+        }
+        return h;
+    }();
+
+    static Flags flags()
+    {
+        return Flags {flag_bits};
+    }
+
+    static std::optional<VendorId> vendor_id()
+    {
+        if constexpr (vendor_specific) {
+            return VendorIdV;
+        }
+        else {
+            return std::nullopt;
+        }
+    }
+
+    // Code and vendor id match, the flags are not compared
+    static bool matches(const AVP& avp)
+    {
+        return avp.code == CodeV && avp.vendor_id == vendor_id();
+    }
+
+    static AVP make(T value)
+    {
+        return AVP {CodeV, flags(), vendor_id(), Value(std::move(value))};
+    }
+};
+
+} // namespace diameter::message::avp
+
+#endif
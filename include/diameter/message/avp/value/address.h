@@ -1,12 +1,18 @@
 #ifndef DIAMETER_MESSAGE_AVP_VALUE_ADDRESS_H
 #define DIAMETER_MESSAGE_AVP_VALUE_ADDRESS_H
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
 #include <cstring>
+#include <memory_resource>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 
-#include <arpa/inet.h>
+#include <diameter/message/avp/value/detail/ip_address.h>
+#include <diameter/message/span.h>
 
 namespace diameter::message::avp::value {
 
@@ -35,138 +41,243 @@ struct AddressFamilyV
     };
 };
 
+/*
+ * Text form of an address, formatted on the stack by AddressBase::address_text(). The text of an
+ * address family other than IPv4 and IPv6 is not copied: it refers to the value of the address.
+ */
+class AddressText
+{
+public:
+    AddressText() = default;
+
+    AddressText(AddressText const&) = default;
+    AddressText& operator= (AddressText const&) = default;
+    AddressText(AddressText&&) = default;
+    AddressText& operator= (AddressText&&) = default;
+
+    const char* data() const noexcept
+    {
+        return m_external.data() != nullptr ? m_external.data() : m_buffer.data();
+    }
+
+    std::size_t size() const noexcept
+    {
+        return m_external.data() != nullptr ? m_external.size() : m_size;
+    }
+
+    std::string_view view() const noexcept
+    {
+        return std::string_view(data(), size());
+    }
+
+    operator std::string_view() const noexcept
+    {
+        return view();
+    }
+
+private:
+    friend class AddressBase;
+
+    std::array<char, detail::ip_text_capacity> m_buffer {};
+    uint8_t m_size {0};
+    std::string_view m_external;
+};
+
 /*
  * The Address format is derived from the OctetString Basic AVP Format.  It is a discriminated union
  * representing, for example, a 32-bit (IPv4) [RFC0791] or 128-bit (IPv6) [RFC4291] address, most
  * significant octet first.  The first two octets of the Address AVP represent the AddressType,
  * which contains an Address Family, defined in [IANAADFAM].  The AddressType is used to
  * discriminate the content and format of the remaining octets.
+ *
+ * Addresses of up to 16 bytes, IPv4 and IPv6 included, are stored inline: constructing, copying
+ * and decoding them allocates nothing. value() is a view of the bytes, the text form is only
+ * produced by address_text() / address_string().
  */
 class AddressBase
 {
 public:
-    using value_type = std::vector<uint8_t>;
+    using value_type = ByteSpan;
     using address_family_type = uint16_t;
     using address_string_type = std::string;
+    using address_text_type = AddressText;
+
+    static constexpr std::size_t inline_capacity = 16;
 
     AddressBase() = default;
 
-    AddressBase(AddressBase const&) = default;
-    AddressBase& operator= (AddressBase const&) = default;
-    AddressBase(AddressBase&&) = default;
-    AddressBase& operator= (AddressBase&&) = default;
+    // Copies of long addresses are allocated from the default resource, as pmr containers do
+    AddressBase(AddressBase const& other)
+        : m_address_family(other.m_address_family)
+    {
+        assign(other.value(), std::pmr::get_default_resource());
+    }
+
+    AddressBase& operator= (AddressBase const& other)
+    {
+        if (this != &other) {
+            AddressBase copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    AddressBase(AddressBase&& other) noexcept
+    {
+        steal(other);
+    }
+
+    AddressBase& operator= (AddressBase&& other) noexcept
+    {
+        if (this != &other) {
+            release();
+            steal(other);
+        }
+        return *this;
+    }
 
-    AddressBase(address_family_type address_family, const value_type& val)
-        : m_address_family(address_family),
-          m_value(val)
+    ~AddressBase()
     {
+        release();
     }
 
-    AddressBase(address_family_type address_family, const address_string_type& val)
-        : m_address_family(address_family),
-          m_address_string(val)
+    // The bytes are copied, into `resource` if they do not fit inline
+    AddressBase(address_family_type address_family, value_type val,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : m_address_family(address_family)
+    {
+        assign(val, resource);
+    }
+
+    // IPv4 and IPv6 addresses are parsed, the text of other families is the value
+    AddressBase(address_family_type address_family, std::string_view val)
+        : m_address_family(address_family)
     {
         if (m_address_family == AddressFamilyV::IPv4) {
-            struct in_addr ipv4_bin;
-            if (inet_pton(AF_INET, m_address_string.c_str(), &ipv4_bin) < 1) {
+            if (!detail::parse_ipv4(val, m_inline.data())) {
                 throw std::runtime_error("avp::Address: incorrect IPv4");
             }
-            m_value.resize(sizeof(in_addr));
-            std::memcpy(m_value.data(), &ipv4_bin, sizeof(ipv4_bin));
+            m_size = 4;
         }
         else if (m_address_family == AddressFamilyV::IPv6) {
-            struct in6_addr ipv6_bin;
-            if (inet_pton(AF_INET6, m_address_string.c_str(), &ipv6_bin) < 1) {
+            if (!detail::parse_ipv6(val, m_inline.data())) {
                 throw std::runtime_error("avp::Address: incorrect IPv6");
             }
-            m_value.resize(sizeof(in6_addr));
-            std::memcpy(m_value.data(), &ipv6_bin, sizeof(in6_addr));
+            m_size = 16;
         }
         else {
-            m_value.assign(m_address_string.begin(), m_address_string.end());
+            assign(value_type(reinterpret_cast<const uint8_t*>(val.data()), val.size()),
+                std::pmr::get_default_resource());
         }
     }
 
-    AddressBase(const address_string_type& val)
+    AddressBase(std::string_view val)
         : AddressBase(AddressFamilyV::IPv4, val)
     {
     }
 
-    value_type value() const
+    value_type value() const noexcept
     {
-        return m_value;
+        return value_type(is_long() ? m_long : m_inline.data(), m_size);
     }
 
-    address_family_type address_family() const
+    address_family_type address_family() const noexcept
     {
         return m_address_family;
     }
 
+    // Formatted on each call, nothing is allocated
+    address_text_type address_text() const noexcept
+    {
+        AddressText text;
+        if (is_ipv4()) {
+            text.m_size = static_cast<uint8_t>(detail::format_ipv4(m_inline.data(),
+                text.m_buffer.data()));
+        }
+        else if (is_ipv6()) {
+            text.m_size = static_cast<uint8_t>(detail::format_ipv6(m_inline.data(),
+                text.m_buffer.data()));
+        }
+        else {
+            auto bytes = value();
+            text.m_external = std::string_view(reinterpret_cast<const char*>(bytes.data()),
+                bytes.size());
+        }
+        return text;
+    }
+
     address_string_type address_string() const
     {
-        return m_address_string;
+        return address_string_type(address_text().view());
     }
 
     std::size_t size() const noexcept
     {
-        return m_value.size() + sizeof(address_family_type);
+        return value().size() + sizeof(address_family_type);
     }
 
     bool is_ipv4() const noexcept
     {
-        return (m_address_family == AddressFamilyV::IPv4) && (m_value.size() == sizeof(in_addr));
+        return m_address_family == AddressFamilyV::IPv4 && m_size == 4;
     }
 
     bool is_ipv6() const noexcept
     {
-        return (m_address_family == AddressFamilyV::IPv6) && (m_value.size() == sizeof(in6_addr));
+        return m_address_family == AddressFamilyV::IPv6 && m_size == 16;
     }
 
-    bool validate()
+    // An IPv4 or IPv6 address of the right size
+    bool validate() const noexcept
     {
-        if (m_address_family == AddressFamilyV::IPv4) {
-            if (m_value.size() != sizeof(in_addr)) {
-                return m_is_validated;
-            }
+        return is_ipv4() || is_ipv6();
+    }
 
-            struct in_addr ipv4_bin;
-            std::memcpy(&ipv4_bin, m_value.data(), sizeof(ipv4_bin));
+private:
+    bool is_long() const noexcept
+    {
+        return m_size > inline_capacity;
+    }
 
-            char ipv4_str[INET_ADDRSTRLEN];
-            const char* result = inet_ntop(AF_INET, &ipv4_bin, ipv4_str, INET_ADDRSTRLEN);
-            if (result == nullptr) {
-                return m_is_validated;
-            }
-            m_address_string.assign(result);
-            m_is_validated = true;
-            return m_is_validated;
+    void assign(value_type val, std::pmr::memory_resource* resource)
+    {
+        if (val.size() <= inline_capacity) {
+            std::copy(val.begin(), val.end(), m_inline.begin());
         }
-        else if (m_address_family == AddressFamilyV::IPv6) {
-            if (m_value.size() != sizeof(in6_addr)) {
-                return m_is_validated;
-            }
+        else {
+            m_long = static_cast<uint8_t*>(resource->allocate(val.size(), 1));
+            m_resource = resource;
+            std::copy(val.begin(), val.end(), m_long);
+        }
+        m_size = static_cast<uint32_t>(val.size());
+    }
 
-            struct in6_addr ipv6_bin;
-            std::memcpy(&ipv6_bin, m_value.data(), sizeof(ipv6_bin));
+    void steal(AddressBase& other) noexcept
+    {
+        m_address_family = other.m_address_family;
+        m_size = other.m_size;
+        std::memcpy(&m_inline, &other.m_inline, sizeof(m_inline));
+        m_resource = other.m_resource;
+        other.m_size = 0;
+        other.m_resource = nullptr;
+    }
 
-            char ipv6_str[INET6_ADDRSTRLEN];
-            const char* result = inet_ntop(AF_INET6, &ipv6_bin, ipv6_str, INET6_ADDRSTRLEN);
-            if (result == nullptr) {
-                return m_is_validated;
-            }
-            m_address_string.assign(result);
-            m_is_validated = true;
-            return m_is_validated;
+    void release() noexcept
+    {
+        if (is_long()) {
+            m_resource->deallocate(m_long, m_size, 1);
         }
-        return m_is_validated;
+        m_size = 0;
     }
 
-private:
-    address_family_type m_address_family;
-    value_type m_value;
-
-    bool m_is_validated {false};
-    address_string_type m_address_string;
+    address_family_type m_address_family {AddressFamilyV::IPv4};
+    uint32_t m_size {0};
+    union
+    {
+        std::array<uint8_t, inline_capacity> m_inline {};
+        // Addresses longer than inline_capacity, allocated from m_resource
+        uint8_t* m_long;
+    };
+    std::pmr::memory_resource* m_resource {nullptr};
 };
 
 } // namespace diameter::message::avp::value
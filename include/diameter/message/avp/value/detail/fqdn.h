@@ -0,0 +1,127 @@
+#ifndef DIAMETER_MESSAGE_AVP_VALUE_DETAIL_FQDN_H
+#define DIAMETER_MESSAGE_AVP_VALUE_DETAIL_FQDN_H
+
+#include <cstddef>
+#include <string_view>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace diameter::message::avp::value::detail {
+
+inline constexpr bool is_alpha(char c) noexcept
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+inline constexpr bool is_digit(char c) noexcept
+{
+    return c >= '0' && c <= '9';
+}
+
+inline constexpr bool is_alnum(char c) noexcept
+{
+    return is_alpha(c) || is_digit(c);
+}
+
+// Letters, digits, hyphens and dots, 32 or 16 bytes at a time where the target supports it
+inline bool is_fqdn_chars(const char* data, std::size_t size) noexcept
+{
+    std::size_t i = 0;
+#if defined(__AVX2__)
+    const auto in_range = [](__m256i x, char lo, char hi) {
+        // x - lo in [0, hi - lo] as unsigned, compared as signed after moving 0 to -128
+        auto t = _mm256_xor_si256(_mm256_sub_epi8(x, _mm256_set1_epi8(lo)),
+            _mm256_set1_epi8(static_cast<char>(-128)));
+        return _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(-128 + hi - lo + 1)), t);
+    };
+    for (; i + 32 <= size; i += 32) {
+        auto x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        auto ok = _mm256_or_si256(
+            _mm256_or_si256(in_range(_mm256_or_si256(x, _mm256_set1_epi8(0x20)), 'a', 'z'),
+                in_range(x, '0', '9')),
+            _mm256_or_si256(_mm256_cmpeq_epi8(x, _mm256_set1_epi8('-')),
+                _mm256_cmpeq_epi8(x, _mm256_set1_epi8('.'))));
+        if (_mm256_movemask_epi8(ok) != -1) {
+            return false;
+        }
+    }
+#endif
+#if defined(__SSE2__)
+    const auto in_range_128 = [](__m128i x, char lo, char hi) {
+        auto t = _mm_xor_si128(_mm_sub_epi8(x, _mm_set1_epi8(lo)),
+            _mm_set1_epi8(static_cast<char>(-128)));
+        return _mm_cmpgt_epi8(_mm_set1_epi8(static_cast<char>(-128 + hi - lo + 1)), t);
+    };
+    for (; i + 16 <= size; i += 16) {
+        auto x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        auto ok = _mm_or_si128(
+            _mm_or_si128(in_range_128(_mm_or_si128(x, _mm_set1_epi8(0x20)), 'a', 'z'),
+                in_range_128(x, '0', '9')),
+            _mm_or_si128(_mm_cmpeq_epi8(x, _mm_set1_epi8('-')),
+                _mm_cmpeq_epi8(x, _mm_set1_epi8('.'))));
+        if (_mm_movemask_epi8(ok) != 0xFFFF) {
+            return false;
+        }
+    }
+#endif
+    for (; i < size; ++i) {
+        auto c = data[i];
+        if (!is_alnum(c) && c != '-' && c != '.') {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * FQDN check of DiameterIdentity and DiameterURI, the same language as the regular expression
+ *
+ *     (?=^.{4,253}$)(^((?!-)[a-zA-Z0-9-]{0,62}[a-zA-Z0-9]\.)+[a-zA-Z]{2,63}$)
+ *
+ * 4 to 253 characters; one or more labels of 1 to 63 letters, digits and hyphens, not starting
+ * with a hyphen and ending with a letter or digit, each followed by a dot; a top level label of 2
+ * to 63 letters.
+ *
+ * The characters are checked by is_fqdn_chars(), then only the dots and the label boundaries are
+ * looked at.
+ */
+inline bool is_fqdn(std::string_view fqdn) noexcept
+{
+    if (fqdn.size() < 4 || fqdn.size() > 253 || !is_fqdn_chars(fqdn.data(), fqdn.size())) {
+        return false;
+    }
+
+    std::size_t start = 0;
+    auto dot = fqdn.find('.');
+    if (dot == std::string_view::npos) {
+        return false;
+    }
+    do {
+        auto length = dot - start;
+        if (length == 0 || length > 63 || fqdn[start] == '-' || fqdn[dot - 1] == '-') {
+            return false;
+        }
+        start = dot + 1;
+        dot = fqdn.find('.', start);
+    } while (dot != std::string_view::npos);
+
+    // Top level label
+    auto length = fqdn.size() - start;
+    if (length < 2 || length > 63) {
+        return false;
+    }
+    for (auto i = start; i < fqdn.size(); ++i) {
+        if (!is_alpha(fqdn[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace diameter::message::avp::value::detail
+
+#endif
@@ -0,0 +1,248 @@
+#ifndef DIAMETER_MESSAGE_AVP_VALUE_DETAIL_IP_ADDRESS_H
+#define DIAMETER_MESSAGE_AVP_VALUE_DETAIL_IP_ADDRESS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+// IPv4 and IPv6 text conversions without the C library: the same results as inet_pton() and
+// inet_ntop() of glibc, nothing is allocated and the text is written into the caller's buffer.
+
+namespace diameter::message::avp::value::detail {
+
+// Longest text form, "ffff:ffff:ffff:ffff:ffff:ffff:255.255.255.255"
+inline constexpr std::size_t ip_text_capacity = 45;
+
+// Dotted decimal, four octets without leading zeros
+inline bool parse_ipv4(std::string_view text, uint8_t* out) noexcept
+{
+    uint8_t octets[4] = {};
+    std::size_t count = 0;
+    bool digit_seen = false;
+    for (auto c : text) {
+        if (c >= '0' && c <= '9') {
+            if (!digit_seen) {
+                if (count == 4) {
+                    return false;
+                }
+                ++count;
+                digit_seen = true;
+            }
+            else if (octets[count - 1] == 0) {
+                return false;
+            }
+            auto value = octets[count - 1] * 10u + static_cast<unsigned>(c - '0');
+            if (value > 255) {
+                return false;
+            }
+            octets[count - 1] = static_cast<uint8_t>(value);
+        }
+        else if (c == '.' && digit_seen) {
+            if (count == 4) {
+                return false;
+            }
+            digit_seen = false;
+        }
+        else {
+            return false;
+        }
+    }
+    if (count < 4 || !digit_seen) {
+        return false;
+    }
+    std::memcpy(out, octets, sizeof(octets));
+    return true;
+}
+
+inline int hex_digit(char c) noexcept
+{
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+// RFC 4291 2.2: groups of up to 4 hex digits, one "::", an optional trailing dotted IPv4 address
+inline bool parse_ipv6(std::string_view text, uint8_t* out) noexcept
+{
+    uint8_t bytes[16] = {};
+    std::size_t size = 0;
+    std::size_t gap = 16;  // Position of "::", none if 16
+    bool has_gap = false;
+
+    std::size_t pos = 0;
+    if (text.empty()) {
+        return false;
+    }
+    // A leading colon is only allowed as part of "::"
+    if (text[0] == ':') {
+        if (text.size() < 2 || text[1] != ':') {
+            return false;
+        }
+        pos = 1;
+    }
+
+    auto group_begin = pos;
+    std::size_t digits = 0;
+    uint32_t value = 0;
+    while (pos < text.size()) {
+        auto c = text[pos++];
+        auto digit = hex_digit(c);
+        if (digit >= 0) {
+            if (digits == 4) {
+                return false;
+            }
+            value = value << 4 | static_cast<uint32_t>(digit);
+            ++digits;
+            continue;
+        }
+        if (c == ':') {
+            group_begin = pos;
+            if (digits == 0) {
+                if (has_gap) {
+                    return false;
+                }
+                has_gap = true;
+                gap = size;
+                continue;
+            }
+            if (pos == text.size() || size + 2 > 16) {
+                return false;
+            }
+            bytes[size++] = static_cast<uint8_t>(value >> 8);
+            bytes[size++] = static_cast<uint8_t>(value);
+            digits = 0;
+            value = 0;
+            continue;
+        }
+        if (c == '.' && size + 4 <= 16 && parse_ipv4(text.substr(group_begin), bytes + size)) {
+            size += 4;
+            digits = 0;
+            break;
+        }
+        return false;
+    }
+    if (digits > 0) {
+        if (size + 2 > 16) {
+            return false;
+        }
+        bytes[size++] = static_cast<uint8_t>(value >> 8);
+        bytes[size++] = static_cast<uint8_t>(value);
+    }
+    if (has_gap) {
+        // "::" must stand for at least one group
+        if (size == 16) {
+            return false;
+        }
+        auto tail = size - gap;
+        std::memmove(bytes + 16 - tail, bytes + gap, tail);
+        std::memset(bytes + gap, 0, 16 - tail - gap);
+        size = 16;
+    }
+    if (size != 16) {
+        return false;
+    }
+    std::memcpy(out, bytes, sizeof(bytes));
+    return true;
+}
+
+// Returns the length of the text, at most 15
+inline std::size_t format_ipv4(const uint8_t* bytes, char* out) noexcept
+{
+    auto* p = out;
+    for (std::size_t i = 0; i < 4; ++i) {
+        if (i != 0) {
+            *p++ = '.';
+        }
+        unsigned value = bytes[i];
+        if (value >= 100) {
+            *p++ = static_cast<char>('0' + value / 100);
+            value %= 100;
+            *p++ = static_cast<char>('0' + value / 10);
+        }
+        else if (value >= 10) {
+            *p++ = static_cast<char>('0' + value / 10);
+        }
+        *p++ = static_cast<char>('0' + value % 10);
+    }
+    return static_cast<std::size_t>(p - out);
+}
+
+/*
+ * RFC 5952 text: lower case, the longest run of two or more zero groups (the first one of equal
+ * runs) replaced by "::". IPv4-compatible and IPv4-mapped addresses end with the dotted IPv4
+ * address. Returns the length of the text, at most ip_text_capacity.
+ */
+inline std::size_t format_ipv6(const uint8_t* bytes, char* out) noexcept
+{
+    static constexpr char hex[] = "0123456789abcdef";
+
+    uint16_t groups[8];
+    for (std::size_t i = 0; i < 8; ++i) {
+        groups[i] = static_cast<uint16_t>(bytes[2 * i] << 8 | bytes[2 * i + 1]);
+    }
+
+    // Longest run of zero groups
+    std::size_t best = 8;
+    std::size_t best_length = 0;
+    for (std::size_t i = 0; i < 8;) {
+        if (groups[i] != 0) {
+            ++i;
+            continue;
+        }
+        auto begin = i;
+        while (i < 8 && groups[i] == 0) {
+            ++i;
+        }
+        if (i - begin > best_length) {
+            best = begin;
+            best_length = i - begin;
+        }
+    }
+    if (best_length < 2) {
+        best = 8;
+        best_length = 0;
+    }
+
+    auto* p = out;
+    for (std::size_t i = 0; i < 8; ++i) {
+        if (i >= best && i < best + best_length) {
+            if (i == best) {
+                *p++ = ':';
+            }
+            continue;
+        }
+        if (i != 0) {
+            *p++ = ':';
+        }
+        if (i == 6 && best == 0
+            && (best_length == 6 || (best_length == 5 && groups[5] == 0xffff))) {
+            p += format_ipv4(bytes + 12, p);
+            return static_cast<std::size_t>(p - out);
+        }
+        bool leading = true;
+        for (int shift = 12; shift >= 0; shift -= 4) {
+            auto digit = (groups[i] >> shift) & 0xF;
+            if (digit == 0 && leading && shift != 0) {
+                continue;
+            }
+            leading = false;
+            *p++ = hex[digit];
+        }
+    }
+    if (best != 8 && best + best_length == 8) {
+        *p++ = ':';
+    }
+    return static_cast<std::size_t>(p - out);
+}
+
+} // namespace diameter::message::avp::value::detail
+
+#endif
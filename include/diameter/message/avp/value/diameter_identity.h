@@ -1,8 +1,11 @@
 #ifndef DIAMETER_MESSAGE_AVP_VALUE_DIAMETER_IDENTITY_H
 #define DIAMETER_MESSAGE_AVP_VALUE_DIAMETER_IDENTITY_H
 
-#include <regex>
 #include <string>
+#include <string_view>
+
+#include <diameter/message/avp/value/detail/fqdn.h>
+#include <diameter/message/avp/value/identity_table.h>
 
 namespace diameter::message::avp::value {
 
@@ -27,6 +30,10 @@ namespace diameter::message::avp::value {
  * this document, note that DiameterIdentity is in ASCII form in order to be compatible with
  * existing DNS infrastructure. See Appendix D for interactions between the Diameter protocol and
  * Internationalized Domain Names (IDNs).
+ *
+ * A value interned in an IdentityTable refers to the entry of the table instead of keeping its own
+ * text: it is copied without allocation and compared with another value of the same table by the
+ * entry. The table must outlive the value.
  */
 class DiameterIdentityBase
 {
@@ -45,28 +52,66 @@ public:
     {
     }
 
-    value_type value() const
+    DiameterIdentityBase(const IdentityTable::Entry& entry)
+        : m_entry(&entry)
+    {
+    }
+
+    // Interned in the table, or a copy of the text if the table is full
+    DiameterIdentityBase(std::string_view val, IdentityTable& table)
+        : m_entry(table.intern(val))
     {
-        return m_value;
+        if (m_entry == nullptr) {
+            m_value = val;
+        }
+    }
+
+    const value_type& value() const noexcept
+    {
+        return m_entry != nullptr ? m_entry->text : m_value;
     }
 
     std::size_t size() const noexcept
     {
-        return m_value.size();
+        return value().size();
+    }
+
+    // The entry of the interning table, nullptr if the value is not interned
+    const IdentityTable::Entry* entry() const noexcept
+    {
+        return m_entry;
+    }
+
+    // The id in the interning table, IdentityTable::npos if the value is not interned
+    IdentityTable::Id id() const noexcept
+    {
+        return m_entry != nullptr ? m_entry->id : IdentityTable::npos;
+    }
+
+    // FQDN format, see detail::is_fqdn()
+    bool validate() const noexcept
+    {
+        return detail::is_fqdn(value());
+    }
+
+    // Values interned in the same table compare by the entry, without comparing the text
+    bool operator== (const DiameterIdentityBase& other) const noexcept
+    {
+        if (m_entry != nullptr && other.m_entry != nullptr
+            && m_entry->table == other.m_entry->table) {
+            return m_entry == other.m_entry;
+        }
+        return value() == other.value();
     }
 
-    bool validate() const
+    bool operator!= (const DiameterIdentityBase& other) const noexcept
     {
-        // Validation for FQDN format
-        // https://stackoverflow.com/questions/11809631/fully-qualified-domain-name-validation
-        static const std::regex r(
-            R"((?=^.{4,253}$)(^((?!-)[a-zA-Z0-9-]{0,62}[a-zA-Z0-9]\.)+[a-zA-Z]{2,63}$))",
-            std::regex_constants::icase);
-        return std::regex_match(m_value, r);
+        return !(*this == other);
     }
 
 private:
     value_type m_value;
+    const IdentityTable::Entry* m_entry {nullptr};
 };
 
 }
@@ -1,10 +1,12 @@
 #ifndef DIAMETER_MESSAGE_AVP_VALUE_DIAMETER_URI_H
 #define DIAMETER_MESSAGE_AVP_VALUE_DIAMETER_URI_H
 
-#include <cassert>
+#include <cstdint>
 #include <optional>
-#include <regex>
 #include <string>
+#include <string_view>
+
+#include <diameter/message/avp/value/detail/fqdn.h>
 
 namespace diameter::message::avp::value {
 
@@ -61,11 +63,11 @@ class DiameterURIBase
 {
 public:
     using value_type = std::string;
-    using scheme_type = std::string;
-    using fqdn_type = std::string;
+    using scheme_type = std::string_view;
+    using fqdn_type = std::string_view;
     using port_type = std::optional<std::uint32_t>;
-    using transport_type = std::optional<std::string>;
-    using protocol_type = std::optional<std::string>;
+    using transport_type = std::optional<std::string_view>;
+    using protocol_type = std::optional<std::string_view>;
 
     DiameterURIBase() = default;
 
@@ -77,9 +79,10 @@ public:
     DiameterURIBase(const value_type& val)
         : m_value(val)
     {
+        parse();
     }
 
-    value_type value() const noexcept
+    const value_type& value() const noexcept
     {
         return m_value;
     }
@@ -89,102 +92,215 @@ public:
         return m_value.size();
     }
 
-    bool validate()
+    /*
+     * The URI is parsed in a single pass by the constructor, nothing is allocated. The scheme,
+     * the transport and the protocol are matched case-insensitively. Returns false if the syntax
+     * or the FQDN is invalid, the parts are available whenever the syntax is valid.
+     */
+    bool validate() noexcept
     {
-        static const std::regex r1(
-            R"(^(aaa|aaas):\/\/([a-zA-Z0-9\-._~%!$&'()*+,=]+)(?::([0-9]+))?(?:;transport=(tcp|sctp|udp))?(?:;protocol=(diameter|radius|tacacs\+))?$)",
-            std::regex_constants::icase);
-        // group1: scheme
-        // group2: FQDN
-        // group3: port
-        // group4: transport
-        // group5: protocol
+        return m_fqdn_end != invalid && detail::is_fqdn(fqdn());
+    }
 
-        std::smatch match;
-        if (!std::regex_match(m_value, match, r1)) {
-            return false;
+    // The constructor keeps the offsets of the parts: the accessors return views into value()
+    // without parsing it again. A URI longer than 65534 characters is invalid.
+
+    scheme_type scheme() const noexcept
+    {
+        if (m_fqdn_end == invalid) {
+            return scheme_type();
         }
-        for (std::size_t i = 0; i < match.size(); ++i) {
-            if (!match[i].matched)
-                continue;
-            std::string piece = match[i].str();
-            switch (i) {
-                case 1:
-                    m_scheme = piece;
-                    break;
-                case 2:
-                    m_fqdn = piece;
-                    break;
-                case 3:
-                    m_port = std::atoi(piece.c_str());
-                    break;
-                case 4:
-                    m_transport = piece;
-                    break;
-                case 5:
-                    m_protocol = piece;
-                    break;
-                default:
-                    break;
-            }
+        return std::string_view(m_value).substr(0, fqdn_begin() - 3);
+    }
+
+    fqdn_type fqdn() const noexcept
+    {
+        if (m_fqdn_end == invalid) {
+            return fqdn_type();
         }
+        return std::string_view(m_value).substr(fqdn_begin(), m_fqdn_end - fqdn_begin());
+    }
 
-        static const std::regex r2(
-            R"((?=^.{4,253}$)(^((?!-)[a-zA-Z0-9-]{0,62}[a-zA-Z0-9]\.)+[a-zA-Z]{2,63}$))");
-        m_is_validated = std::regex_match(m_fqdn, r2);
-        return m_is_validated;
+    port_type port() const noexcept
+    {
+        if (m_fqdn_end == invalid || m_fqdn_end == m_value.size() || m_value[m_fqdn_end] != ':') {
+            return std::nullopt;
+        }
+        // The digits are checked by the constructor
+        uint32_t port = 0;
+        for (auto pos = m_fqdn_end + 1u; pos < m_value.size() && detail::is_digit(m_value[pos]);
+             ++pos) {
+            port = port * 10 + static_cast<uint32_t>(m_value[pos] - '0');
+        }
+        return port;
     }
 
-    scheme_type scheme() const
+    transport_type transport() const noexcept
     {
-        // assert(m_is_validated);
-        return m_scheme;
+        if (m_fqdn_end == invalid || m_transport == 0) {
+            return std::nullopt;
+        }
+        // Up to ";protocol=" or the end
+        auto end = m_protocol == 0 ? m_value.size() : m_protocol - protocol_prefix.size();
+        return std::string_view(m_value).substr(m_transport, end - m_transport);
     }
 
-    fqdn_type fqdn() const
+    protocol_type protocol() const noexcept
     {
-        // assert(m_is_validated);
-        return m_fqdn;
+        if (m_fqdn_end == invalid || m_protocol == 0) {
+            return std::nullopt;
+        }
+        return std::string_view(m_value).substr(m_protocol);
     }
 
-    port_type port() const
+private:
+    struct Parts
     {
-        // assert(m_is_validated);
-        return m_port;
+        scheme_type scheme;
+        fqdn_type fqdn;
+        port_type port;
+        transport_type transport;
+        protocol_type protocol;
+    };
+
+    // m_fqdn_end of an invalid URI
+    static constexpr uint16_t invalid = UINT16_MAX;
+
+    static constexpr std::string_view transport_prefix = ";transport=";
+    static constexpr std::string_view protocol_prefix = ";protocol=";
+
+    void parse() noexcept
+    {
+        Parts parts;
+        if (m_value.size() >= invalid || !parse(m_value, parts)) {
+            return;
+        }
+        m_transport = parts.transport ? offset(*parts.transport) : uint16_t {0};
+        m_protocol = parts.protocol ? offset(*parts.protocol) : uint16_t {0};
+        m_fqdn_end = static_cast<uint16_t>(offset(parts.fqdn) + parts.fqdn.size());
     }
 
-    transport_type transport() const
+    uint16_t offset(std::string_view part) const noexcept
     {
-        // assert(m_is_validated);
-        return m_transport;
+        return static_cast<uint16_t>(part.data() - m_value.data());
     }
 
-    protocol_type protocol() const
+    // After "aaa://" or "aaas://"
+    std::size_t fqdn_begin() const noexcept
     {
-        // assert(m_is_validated);
-        return m_protocol;
+        return m_value[3] == ':' ? 6 : 7;
     }
 
-private:
-    std::vector<std::string> split(const value_type& val, char delim)
+    static bool parse(std::string_view uri, Parts& parts) noexcept
     {
-        std::istringstream iss(val);
-        std::string item;
-        std::vector<std::string> result;
-        while (std::getline(iss, item, delim)) {
-            result.push_back(item);
+        std::size_t pos = 0;
+
+        // "aaa://" or "aaas://"
+        if (!consume(uri, pos, "aaa")) {
+            return false;
+        }
+        auto scheme_end = pos;
+        if (pos < uri.size() && (uri[pos] == 's' || uri[pos] == 'S')) {
+            ++scheme_end;
+        }
+        pos = scheme_end;
+        if (!consume(uri, pos, "://")) {
+            return false;
+        }
+        parts.scheme = uri.substr(0, scheme_end);
+
+        auto fqdn_begin = pos;
+        while (pos < uri.size() && is_fqdn_char(uri[pos])) {
+            ++pos;
+        }
+        if (pos == fqdn_begin) {
+            return false;
         }
-        return result;
+        parts.fqdn = uri.substr(fqdn_begin, pos - fqdn_begin);
+
+        if (pos < uri.size() && uri[pos] == ':') {
+            auto port_begin = ++pos;
+            uint64_t port = 0;
+            while (pos < uri.size() && detail::is_digit(uri[pos])) {
+                port = port * 10 + static_cast<uint64_t>(uri[pos] - '0');
+                if (port > UINT32_MAX) {
+                    return false;
+                }
+                ++pos;
+            }
+            if (pos == port_begin) {
+                return false;
+            }
+            parts.port = static_cast<uint32_t>(port);
+        }
+
+        static constexpr std::string_view transports[] = {"tcp", "sctp", "udp"};
+        static constexpr std::string_view protocols[] = {"diameter", "radius", "tacacs+"};
+        if (consume(uri, pos, transport_prefix)
+            && !consume_one_of(uri, pos, transports, parts.transport)) {
+            return false;
+        }
+        if (consume(uri, pos, protocol_prefix)
+            && !consume_one_of(uri, pos, protocols, parts.protocol)) {
+            return false;
+        }
+        return pos == uri.size();
     }
 
-    value_type m_value;
+    // RFC 3986 unreserved and sub-delims characters, except ';' and ':'
+    static bool is_fqdn_char(char c) noexcept
+    {
+        if (detail::is_alnum(c)) {
+            return true;
+        }
+        switch (c) {
+            case '-': case '.': case '_': case '~': case '%': case '!': case '$': case '&':
+            case '\'': case '(': case ')': case '*': case '+': case ',': case '=':
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    static char lower(char c) noexcept
+    {
+        return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+    }
 
-    bool m_is_validated {false};
-    scheme_type m_scheme;
-    fqdn_type m_fqdn;
-    port_type m_port;
-    transport_type m_transport;
-    protocol_type m_protocol;
+    // Case-insensitive match of the lower case literal at pos, advances pos past it
+    static bool consume(std::string_view uri, std::size_t& pos, std::string_view literal) noexcept
+    {
+        if (uri.size() - pos < literal.size()) {
+            return false;
+        }
+        for (std::size_t i = 0; i < literal.size(); ++i) {
+            if (lower(uri[pos + i]) != literal[i]) {
+                return false;
+            }
+        }
+        pos += literal.size();
+        return true;
+    }
+
+    template<std::size_t N>
+    static bool consume_one_of(std::string_view uri, std::size_t& pos,
+        const std::string_view (&literals)[N], std::optional<std::string_view>& part) noexcept
+    {
+        for (auto literal : literals) {
+            auto begin = pos;
+            if (consume(uri, pos, literal)) {
+                part = uri.substr(begin, pos - begin);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    value_type m_value;
+    // Offsets of the parts into m_value, 0 for a transport or a protocol which is absent
+    uint16_t m_fqdn_end {invalid};
+    uint16_t m_transport {0};
+    uint16_t m_protocol {0};
 };
 
 } // namespace diameter::message::avp::value
@@ -0,0 +1,157 @@
+#ifndef DIAMETER_MESSAGE_AVP_VALUE_IDENTITY_TABLE_H
+#define DIAMETER_MESSAGE_AVP_VALUE_IDENTITY_TABLE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace diameter::message::avp::value {
+
+/*
+ * Interning table of DiameterIdentity values (hosts and realms of the peers).
+ *
+ * Every text interned in the table gets an entry with a stable 32-bit id, numbered from 0 in the
+ * order of interning. Entries are never removed or moved: a pointer to an entry, its text and its
+ * id stay valid for the lifetime of the table, so DiameterIdentity values refer to the entry
+ * instead of keeping their own copy of the text and two interned values compare by the entry.
+ *
+ * The table is safe for concurrent use. find() and entry() take no lock: the entries are published
+ * into an open addressing hash table of atomic pointers after they are constructed. intern()
+ * serializes the writers with a mutex. The capacity is fixed at construction, so the hash table
+ * never grows under the readers; once the table is full intern() returns nullptr and the caller
+ * keeps the text itself, e.g. for identities of unknown peers which must not fill the table.
+ */
+class IdentityTable
+{
+public:
+    using Id = uint32_t;
+
+    static constexpr Id npos = std::numeric_limits<Id>::max();
+
+    struct Entry
+    {
+        std::string text;
+        Id id;
+        std::size_t hash;
+        const IdentityTable* table;
+    };
+
+    explicit IdentityTable(std::size_t capacity = 1024)
+        : m_capacity(capacity)
+    {
+        if (capacity == 0 || capacity >= npos) {
+            throw std::invalid_argument("IdentityTable: invalid capacity");
+        }
+        // At most a half of the slots is used, so a probe always ends on an empty slot
+        std::size_t slots = 4;
+        while (slots < capacity * 2) {
+            slots <<= 1;
+        }
+        m_mask = slots - 1;
+        // Value initialized, all the pointers are null
+        m_slots = std::make_unique<std::atomic<const Entry*>[]>(slots);
+        m_by_id = std::make_unique<std::atomic<const Entry*>[]>(capacity);
+    }
+
+    // Values refer to the entries, the table is neither copied nor moved
+    IdentityTable(IdentityTable const&) = delete;
+    IdentityTable& operator= (IdentityTable const&) = delete;
+    IdentityTable(IdentityTable&&) = delete;
+    IdentityTable& operator= (IdentityTable&&) = delete;
+
+    // The entry of the text, nullptr if the text is not interned. Lock free
+    const Entry* find(std::string_view text) const noexcept
+    {
+        return find(text, hash(text));
+    }
+
+    // The entry of the id, nullptr if there is no such id. Lock free
+    const Entry* entry(Id id) const noexcept
+    {
+        if (id >= m_capacity) {
+            return nullptr;
+        }
+        return m_by_id[id].load(std::memory_order_acquire);
+    }
+
+    // The entry of the text, added if the text is new; nullptr if the table is full
+    const Entry* intern(std::string_view text)
+    {
+        auto h = hash(text);
+        if (const auto* found = find(text, h)) {
+            return found;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        // Another writer could add the text after the lookup above
+        if (const auto* found = find(text, h)) {
+            return found;
+        }
+        if (m_entries.size() == m_capacity) {
+            return nullptr;
+        }
+        const auto& added = m_entries.emplace_back(
+            Entry {std::string(text), static_cast<Id>(m_entries.size()), h, this});
+
+        auto i = h & m_mask;
+        while (m_slots[i].load(std::memory_order_relaxed) != nullptr) {
+            i = (i + 1) & m_mask;
+        }
+        m_by_id[added.id].store(&added, std::memory_order_release);
+        m_slots[i].store(&added, std::memory_order_release);
+        m_size.store(m_entries.size(), std::memory_order_release);
+        return &added;
+    }
+
+    std::size_t size() const noexcept
+    {
+        return m_size.load(std::memory_order_acquire);
+    }
+
+    std::size_t capacity() const noexcept
+    {
+        return m_capacity;
+    }
+
+private:
+    static std::size_t hash(std::string_view text) noexcept
+    {
+        return std::hash<std::string_view> {}(text);
+    }
+
+    const Entry* find(std::string_view text, std::size_t h) const noexcept
+    {
+        for (auto i = h & m_mask;; i = (i + 1) & m_mask) {
+            const auto* entry = m_slots[i].load(std::memory_order_acquire);
+            if (entry == nullptr) {
+                return nullptr;
+            }
+            if (entry->hash == h && entry->text == text) {
+                return entry;
+            }
+        }
+    }
+
+private:
+    std::size_t m_capacity;
+    std::size_t m_mask {0};
+    std::unique_ptr<std::atomic<const Entry*>[]> m_slots;
+    std::unique_ptr<std::atomic<const Entry*>[]> m_by_id;
+    std::atomic<std::size_t> m_size {0};
+
+    // Writers only. std::deque keeps the entries in place as it grows
+    std::mutex m_mutex;
+    std::deque<Entry> m_entries;
+};
+
+} // namespace diameter::message::avp::value
+
+#endif
@@ -0,0 +1,725 @@
+#ifndef DIAMETER_MESSAGE_AVP_VALUE_IP_FILTER_H
+#define DIAMETER_MESSAGE_AVP_VALUE_IP_FILTER_H
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <diameter/message/avp/value/address.h>
+#include <diameter/message/avp/value/detail/fqdn.h>
+#include <diameter/message/avp/value/detail/ip_address.h>
+
+namespace diameter::message::avp::value {
+
+struct IPFilterActionV
+{
+    enum Value : uint8_t
+    {
+        Permit = 0,
+        Deny = 1,
+    };
+};
+
+struct IPFilterDirectionV
+{
+    // in - from the terminal, out - to the terminal
+    enum Value : uint8_t
+    {
+        In = 0,
+        Out = 1,
+    };
+};
+
+struct IPProtocolV
+{
+    enum Value : uint8_t
+    {
+        Icmp = 1,
+        Tcp = 6,
+        Udp = 17,
+        Sctp = 132,
+    };
+};
+
+struct IPOptionV
+{
+    enum Value : uint8_t
+    {
+        Ssrr = 0x01,
+        Lsrr = 0x02,
+        Rr = 0x04,
+        Ts = 0x08,
+    };
+};
+
+struct TcpOptionV
+{
+    enum Value : uint8_t
+    {
+        Mss = 0x01,
+        Window = 0x02,
+        Sack = 0x04,
+        Ts = 0x08,
+        Cc = 0x10,
+    };
+};
+
+struct TcpFlagV
+{
+    // The bits of the TCP header
+    enum Value : uint8_t
+    {
+        Fin = 0x01,
+        Syn = 0x02,
+        Rst = 0x04,
+        Psh = 0x08,
+        Ack = 0x10,
+        Urg = 0x20,
+    };
+};
+
+// IPv4 or IPv6 address, most significant octet first. An IPv4 address uses the first 4 bytes.
+struct IPFilterAddress
+{
+    uint16_t family {AddressFamilyV::IPv4};
+    std::array<uint8_t, 16> bytes {};
+
+    static std::optional<IPFilterAddress> parse(std::string_view text) noexcept
+    {
+        IPFilterAddress address;
+        if (text.find(':') == std::string_view::npos) {
+            if (!detail::parse_ipv4(text, address.bytes.data())) {
+                return std::nullopt;
+            }
+        }
+        else {
+            address.family = AddressFamilyV::IPv6;
+            if (!detail::parse_ipv6(text, address.bytes.data())) {
+                return std::nullopt;
+            }
+        }
+        return address;
+    }
+
+    uint8_t bits() const noexcept
+    {
+        return family == AddressFamilyV::IPv4 ? 32 : 128;
+    }
+
+    // The first `length` bits are the same
+    bool prefix_of(const IPFilterAddress& other, uint8_t length) const noexcept
+    {
+        if (family != other.family) {
+            return false;
+        }
+        std::size_t bytes_length = length / 8;
+        if (std::memcmp(bytes.data(), other.bytes.data(), bytes_length) != 0) {
+            return false;
+        }
+        auto rest = length % 8;
+        if (rest == 0) {
+            return true;
+        }
+        auto mask = static_cast<uint8_t>(0xFF << (8 - rest));
+        return ((bytes[bytes_length] ^ other.bytes[bytes_length]) & mask) == 0;
+    }
+
+    bool operator== (const IPFilterAddress& other) const noexcept
+    {
+        return family == other.family && bytes == other.bytes;
+    }
+
+    bool operator!= (const IPFilterAddress& other) const noexcept
+    {
+        return !(*this == other);
+    }
+};
+
+// Both boundaries included
+struct IPFilterPortRange
+{
+    uint16_t first;
+    uint16_t last;
+};
+
+// IP header fields, and the TCP or ICMP ones, of a packet classified by IPFilter
+struct IPFilterPacket
+{
+    uint8_t direction {IPFilterDirectionV::In};
+    IPFilterAddress src;
+    IPFilterAddress dst;
+    uint8_t protocol {0};
+    uint16_t src_port {0};
+    uint16_t dst_port {0};
+
+    // The fragment offset is not zero
+    bool fragment {false};
+    // IPOptionV, TcpOptionV and TcpFlagV bits present in the packet
+    uint8_t ip_options {0};
+    uint8_t tcp_options {0};
+    uint8_t tcp_flags {0};
+    uint8_t icmp_type {0};
+};
+
+// Source or destination of an IPFilter
+struct IPFilterEndpoint
+{
+    struct KindV
+    {
+        enum Value : uint8_t
+        {
+            Any = 0,
+            // The addresses assigned to the terminal
+            Assigned = 1,
+            Prefix = 2,
+        };
+    };
+
+    uint8_t kind {KindV::Any};
+    // "!": the address does not match
+    bool negated {false};
+    // Prefix: the address with the bits after prefix_length cleared
+    IPFilterAddress address;
+    uint8_t prefix_length {0};
+    // Empty - any port
+    std::vector<IPFilterPortRange> ports;
+
+    bool matches_address(const IPFilterAddress& other,
+        const std::vector<IPFilterAddress>& assigned) const noexcept
+    {
+        bool matched = true;
+        if (kind == KindV::Assigned) {
+            matched = std::find(assigned.begin(), assigned.end(), other) != assigned.end();
+        }
+        else if (kind == KindV::Prefix) {
+            matched = address.prefix_of(other, prefix_length);
+        }
+        return matched != negated;
+    }
+
+    bool matches_port(uint16_t port) const noexcept
+    {
+        if (ports.empty()) {
+            return true;
+        }
+        return std::any_of(ports.begin(), ports.end(),
+            [port](const auto& range) { return port >= range.first && port <= range.last; });
+    }
+};
+
+/*
+ * IPFilterRule (RFC 6733 4.3.1) in binary form
+ *
+ *     action dir proto from src to dst [options]
+ *
+ * The rule is parsed once, matching a packet only compares numbers. The options which are not
+ * about addresses, ports and protocol are kept as bit masks: `*_set` bits must be present in the
+ * packet and `*_clear` bits must not ("!" in the rule).
+ */
+struct IPFilter
+{
+    uint8_t action {IPFilterActionV::Permit};
+    uint8_t direction {IPFilterDirectionV::In};
+    // "ip" - any protocol
+    std::optional<uint8_t> protocol;
+    IPFilterEndpoint src;
+    IPFilterEndpoint dst;
+
+    bool frag {false};
+    bool established {false};
+    bool setup {false};
+    uint8_t ip_options_set {0};
+    uint8_t ip_options_clear {0};
+    uint8_t tcp_options_set {0};
+    uint8_t tcp_options_clear {0};
+    uint8_t tcp_flags_set {0};
+    uint8_t tcp_flags_clear {0};
+    // None - any ICMP type
+    std::bitset<256> icmp_types;
+
+    static std::optional<IPFilter> parse(std::string_view rule);
+
+    bool has_options() const noexcept
+    {
+        return frag || has_tcp_options() || ip_options_set != 0 || ip_options_clear != 0
+            || icmp_types.any();
+    }
+
+    // Everything but the direction, the protocol, the addresses and the ports
+    bool matches_options(const IPFilterPacket& packet) const noexcept
+    {
+        if (frag && !packet.fragment) {
+            return false;
+        }
+        if ((packet.ip_options & ip_options_set) != ip_options_set
+            || (packet.ip_options & ip_options_clear) != 0) {
+            return false;
+        }
+        if (has_tcp_options()) {
+            auto flags = packet.tcp_flags;
+            if (packet.protocol != IPProtocolV::Tcp
+                || (established && (flags & (TcpFlagV::Rst | TcpFlagV::Ack)) == 0)
+                || (setup && ((flags & TcpFlagV::Syn) == 0 || (flags & TcpFlagV::Ack) != 0))
+                || (flags & tcp_flags_set) != tcp_flags_set || (flags & tcp_flags_clear) != 0
+                || (packet.tcp_options & tcp_options_set) != tcp_options_set
+                || (packet.tcp_options & tcp_options_clear) != 0) {
+                return false;
+            }
+        }
+        if (icmp_types.any()
+            && (packet.protocol != IPProtocolV::Icmp || !icmp_types.test(packet.icmp_type))) {
+            return false;
+        }
+        return true;
+    }
+
+    // `assigned` - the addresses assigned to the terminal
+    bool matches(const IPFilterPacket& packet,
+        const std::vector<IPFilterAddress>& assigned = {}) const noexcept
+    {
+        return packet.direction == direction
+            && (!protocol.has_value() || *protocol == packet.protocol)
+            && src.matches_address(packet.src, assigned) && src.matches_port(packet.src_port)
+            && dst.matches_address(packet.dst, assigned) && dst.matches_port(packet.dst_port)
+            && matches_options(packet);
+    }
+
+private:
+    bool has_tcp_options() const noexcept
+    {
+        return established || setup || tcp_flags_set != 0 || tcp_flags_clear != 0
+            || tcp_options_set != 0 || tcp_options_clear != 0;
+    }
+};
+
+namespace detail {
+
+/*
+ * Single pass parser of IPFilterRule, keywords are case-insensitive. Besides the binary form the
+ * text of the action, the direction, the protocol and the addresses is kept.
+ */
+class IPFilterParser
+{
+public:
+    bool parse(std::string_view rule)
+    {
+        m_rule = rule;
+        m_pos = 0;
+        m_filter = IPFilter {};
+
+        m_action = next();
+        if (iequals(m_action, "permit")) {
+            m_filter.action = IPFilterActionV::Permit;
+        }
+        else if (iequals(m_action, "deny")) {
+            m_filter.action = IPFilterActionV::Deny;
+        }
+        else {
+            return false;
+        }
+
+        m_direction = next();
+        if (iequals(m_direction, "in")) {
+            m_filter.direction = IPFilterDirectionV::In;
+        }
+        else if (iequals(m_direction, "out")) {
+            m_filter.direction = IPFilterDirectionV::Out;
+        }
+        else {
+            return false;
+        }
+
+        m_protocol = next();
+        if (!parse_protocol(m_protocol)) {
+            return false;
+        }
+
+        if (!iequals(next(), "from") || !parse_endpoint(m_filter.src, m_src)) {
+            return false;
+        }
+        if (!iequals(next(), "to") || !parse_endpoint(m_filter.dst, m_dst)) {
+            return false;
+        }
+
+        for (auto option = next(); !option.empty(); option = next()) {
+            if (!parse_option(option)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    const IPFilter& filter() const noexcept
+    {
+        return m_filter;
+    }
+
+    IPFilter& filter() noexcept
+    {
+        return m_filter;
+    }
+
+    // Views into the parsed rule
+
+    std::string_view action() const noexcept
+    {
+        return m_action;
+    }
+
+    std::string_view direction() const noexcept
+    {
+        return m_direction;
+    }
+
+    std::string_view protocol() const noexcept
+    {
+        return m_protocol;
+    }
+
+    std::string_view src() const noexcept
+    {
+        return m_src;
+    }
+
+    std::string_view dst() const noexcept
+    {
+        return m_dst;
+    }
+
+    // Separator of the tokens
+    static bool is_space(char c) noexcept
+    {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+    }
+
+private:
+    static bool iequals(std::string_view token, std::string_view literal) noexcept
+    {
+        if (token.size() != literal.size()) {
+            return false;
+        }
+        for (std::size_t i = 0; i < token.size(); ++i) {
+            auto c = token[i];
+            if ((c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c) != literal[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Decimal number of at most `max`
+    template<typename T>
+    static bool to_number(std::string_view text, T max, T& value) noexcept
+    {
+        if (text.empty() || text.size() > 5) {
+            return false;
+        }
+        uint32_t number = 0;
+        for (auto c : text) {
+            if (!is_digit(c)) {
+                return false;
+            }
+            number = number * 10 + static_cast<uint32_t>(c - '0');
+        }
+        if (number > max) {
+            return false;
+        }
+        value = static_cast<T>(number);
+        return true;
+    }
+
+    std::string_view peek() const noexcept
+    {
+        auto pos = m_pos;
+        while (pos < m_rule.size() && is_space(m_rule[pos])) {
+            ++pos;
+        }
+        auto begin = pos;
+        while (pos < m_rule.size() && !is_space(m_rule[pos])) {
+            ++pos;
+        }
+        return m_rule.substr(begin, pos - begin);
+    }
+
+    std::string_view next() noexcept
+    {
+        auto token = peek();
+        m_pos = static_cast<std::size_t>(token.data() - m_rule.data()) + token.size();
+        return token;
+    }
+
+    bool parse_protocol(std::string_view token) noexcept
+    {
+        static constexpr std::pair<std::string_view, uint8_t> names[] = {
+            {"icmp", IPProtocolV::Icmp},
+            {"tcp", IPProtocolV::Tcp},
+            {"udp", IPProtocolV::Udp},
+            {"sctp", IPProtocolV::Sctp},
+        };
+        if (iequals(token, "ip")) {
+            m_filter.protocol = std::nullopt;
+            return true;
+        }
+        for (const auto& [name, number] : names) {
+            if (iequals(token, name)) {
+                m_filter.protocol = number;
+                return true;
+            }
+        }
+        uint8_t number = 0;
+        if (!to_number(token, uint8_t {255}, number)) {
+            return false;
+        }
+        m_filter.protocol = number;
+        return true;
+    }
+
+    // [!]any | [!]assigned | [!]ipno[/bits] [ports]
+    bool parse_endpoint(IPFilterEndpoint& endpoint, std::string_view& text)
+    {
+        auto token = next();
+        const auto* begin = token.data();
+        if (!token.empty() && token.front() == '!') {
+            endpoint.negated = true;
+            token.remove_prefix(1);
+            if (token.empty()) {
+                token = next();
+            }
+        }
+        if (token.empty()) {
+            return false;
+        }
+        text = m_rule.substr(static_cast<std::size_t>(begin - m_rule.data()),
+            static_cast<std::size_t>(token.data() - begin) + token.size());
+
+        if (iequals(token, "any")) {
+            endpoint.kind = IPFilterEndpoint::KindV::Any;
+        }
+        else if (iequals(token, "assigned")) {
+            endpoint.kind = IPFilterEndpoint::KindV::Assigned;
+        }
+        else if (!parse_prefix(endpoint, token)) {
+            return false;
+        }
+
+        auto ports = peek();
+        if (!ports.empty() && is_digit(ports.front())) {
+            next();
+            return parse_ports(endpoint, ports);
+        }
+        return true;
+    }
+
+    static bool parse_prefix(IPFilterEndpoint& endpoint, std::string_view token) noexcept
+    {
+        auto slash = token.find('/');
+        auto address = IPFilterAddress::parse(token.substr(0, slash));
+        if (!address.has_value()) {
+            return false;
+        }
+        auto length = address->bits();
+        if (slash != std::string_view::npos
+            && !to_number(token.substr(slash + 1), address->bits(), length)) {
+            return false;
+        }
+
+        // Host bits cleared
+        for (std::size_t bit = length; bit < address->bits(); ++bit) {
+            address->bytes[bit / 8] &= static_cast<uint8_t>(~(0x80 >> (bit % 8)));
+        }
+        endpoint.kind = IPFilterEndpoint::KindV::Prefix;
+        endpoint.address = *address;
+        endpoint.prefix_length = length;
+        return true;
+    }
+
+    // {port|port-port}[,ports]
+    static bool parse_ports(IPFilterEndpoint& endpoint, std::string_view token)
+    {
+        while (true) {
+            auto comma = token.find(',');
+            auto item = token.substr(0, comma);
+            auto dash = item.find('-');
+            IPFilterPortRange range {};
+            if (!to_number(item.substr(0, dash), uint16_t {65535}, range.first)) {
+                return false;
+            }
+            range.last = range.first;
+            if (dash != std::string_view::npos
+                && (!to_number(item.substr(dash + 1), uint16_t {65535}, range.last)
+                    || range.last < range.first)) {
+                return false;
+            }
+            endpoint.ports.push_back(range);
+            if (comma == std::string_view::npos) {
+                return true;
+            }
+            token.remove_prefix(comma + 1);
+        }
+    }
+
+    // Comma separated list of [!]name, the names are mapped to bits
+    template<std::size_t N>
+    static bool parse_flags(std::string_view token,
+        const std::pair<std::string_view, uint8_t> (&names)[N], uint8_t& set, uint8_t& clear)
+    {
+        while (true) {
+            auto comma = token.find(',');
+            auto item = token.substr(0, comma);
+            auto* mask = &set;
+            if (!item.empty() && item.front() == '!') {
+                mask = &clear;
+                item.remove_prefix(1);
+            }
+            auto it = std::find_if(std::begin(names), std::end(names),
+                [item](const auto& name) { return iequals(item, name.first); });
+            if (it == std::end(names)) {
+                return false;
+            }
+            *mask = static_cast<uint8_t>(*mask | it->second);
+            if (comma == std::string_view::npos) {
+                return true;
+            }
+            token.remove_prefix(comma + 1);
+        }
+    }
+
+    // A number or one of the types listed by RFC 6733 4.3.1, named as by ipfw
+    static bool to_icmp_type(std::string_view text, uint8_t& type)
+    {
+        static constexpr std::pair<std::string_view, uint8_t> names[] = {
+            {"echoreply", 0},
+            {"unreach", 3},
+            {"squench", 4},
+            {"redirect", 5},
+            {"echo", 8},
+            {"routeradv", 9},
+            {"routersol", 10},
+            {"timex", 11},
+            {"paramprob", 12},
+            {"tstamp", 13},
+            {"tstampreply", 14},
+            {"inforeq", 15},
+            {"inforeply", 16},
+            {"maskreq", 17},
+            {"maskreply", 18},
+        };
+
+        auto it = std::find_if(std::begin(names), std::end(names),
+            [text](const auto& name) { return iequals(text, name.first); });
+        if (it != std::end(names)) {
+            type = it->second;
+            return true;
+        }
+        return to_number(text, uint8_t {255}, type);
+    }
+
+    // {type|type-type}[,types]
+    static bool parse_icmp_types(std::string_view token, std::bitset<256>& types)
+    {
+        while (true) {
+            auto comma = token.find(',');
+            auto item = token.substr(0, comma);
+            auto dash = item.find('-');
+            uint8_t first = 0;
+            if (!to_icmp_type(item.substr(0, dash), first)) {
+                return false;
+            }
+            uint8_t last = first;
+            if (dash != std::string_view::npos
+                && (!to_icmp_type(item.substr(dash + 1), last) || last < first)) {
+                return false;
+            }
+            for (auto type = std::size_t {first}; type <= last; ++type) {
+                types.set(type);
+            }
+            if (comma == std::string_view::npos) {
+                return true;
+            }
+            token.remove_prefix(comma + 1);
+        }
+    }
+
+    bool parse_option(std::string_view option)
+    {
+        static constexpr std::pair<std::string_view, uint8_t> ip_options[] = {
+            {"ssrr", IPOptionV::Ssrr},
+            {"lsrr", IPOptionV::Lsrr},
+            {"rr", IPOptionV::Rr},
+            {"ts", IPOptionV::Ts},
+        };
+        static constexpr std::pair<std::string_view, uint8_t> tcp_options[] = {
+            {"mss", TcpOptionV::Mss},
+            {"window", TcpOptionV::Window},
+            {"sack", TcpOptionV::Sack},
+            {"ts", TcpOptionV::Ts},
+            {"cc", TcpOptionV::Cc},
+        };
+        static constexpr std::pair<std::string_view, uint8_t> tcp_flags[] = {
+            {"fin", TcpFlagV::Fin},
+            {"syn", TcpFlagV::Syn},
+            {"rst", TcpFlagV::Rst},
+            {"psh", TcpFlagV::Psh},
+            {"ack", TcpFlagV::Ack},
+            {"urg", TcpFlagV::Urg},
+        };
+
+        auto& f = m_filter;
+        if (iequals(option, "frag")) {
+            f.frag = true;
+            return true;
+        }
+        if (iequals(option, "established")) {
+            f.established = true;
+            return true;
+        }
+        if (iequals(option, "setup")) {
+            f.setup = true;
+            return true;
+        }
+        if (iequals(option, "ipoptions")) {
+            return parse_flags(next(), ip_options, f.ip_options_set, f.ip_options_clear);
+        }
+        if (iequals(option, "tcpoptions")) {
+            return parse_flags(next(), tcp_options, f.tcp_options_set, f.tcp_options_clear);
+        }
+        if (iequals(option, "tcpflags")) {
+            return parse_flags(next(), tcp_flags, f.tcp_flags_set, f.tcp_flags_clear);
+        }
+        if (iequals(option, "icmptypes")) {
+            return parse_icmp_types(next(), f.icmp_types);
+        }
+        return false;
+    }
+
+    std::string_view m_rule;
+    std::size_t m_pos {0};
+    IPFilter m_filter;
+
+    std::string_view m_action;
+    std::string_view m_direction;
+    std::string_view m_protocol;
+    std::string_view m_src;
+    std::string_view m_dst;
+};
+
+} // namespace detail
+
+inline std::optional<IPFilter> IPFilter::parse(std::string_view rule)
+{
+    detail::IPFilterParser parser;
+    if (!parser.parse(rule)) {
+        return std::nullopt;
+    }
+    return std::move(parser.filter());
+}
+
+} // namespace diameter::message::avp::value
+
+#endif
@@ -2,19 +2,29 @@
 #define DIAMETER_MESSAGE_AVP_VALUE_IP_FILTER_RULE_H
 
 #include <cstdint>
-#include <regex>
+#include <optional>
 #include <string>
+#include <string_view>
+
+#include <diameter/message/avp/value/ip_filter.h>
 
 namespace diameter::message::avp::value {
 
+/*
+ * IPFilterRule (RFC 6733 4.3.1), see IPFilter for the binary form.
+ *
+ * The rule is parsed once, by the constructor, which keeps the offsets of the parts into value():
+ * the accessors return views into value() without parsing it again. A rule longer than 65534
+ * characters is invalid.
+ */
 class IPFilterRuleBase
 {
 public:
     using value_type = std::string;
-    using action_type = std::string;
-    using direction_type = std::string;
-    using protocol_type = std::string;
-    using address_type = std::string;
+    using action_type = std::string_view;
+    using direction_type = std::string_view;
+    using protocol_type = std::string_view;
+    using address_type = std::string_view;
 
     IPFilterRuleBase() = default;
 
@@ -26,47 +36,29 @@ public:
     IPFilterRuleBase(const value_type& val)
         : m_value(val)
     {
+        parse();
     }
 
+    /*
+     * Whether the rule parsed (RFC 6733 4.3.1), see IPFilter. The text of the action, the
+     * direction, the protocol and the addresses is available whenever the rule is valid.
+     */
     bool validate()
     {
-        static const std::regex r1(
-            R"(^(permit|deny)\s+(in|out)\s+(ip|tcp|udp|icmp)\s+from\s+(any|(?:\d{1,3}\.){3}\d{1,3}(?:\/\d{1,2})?|(?:[a-fA-F0-9:]+)(?:\/\d{1,3})?)(?:\s+\d{1,5}(?:-\d{1,5})?)?\s+to\s+(any|(?:\d{1,3}\.){3}\d{1,3}(?:\/\d{1,2})?|(?:[a-fA-F0-9:]+)(?:\/\d{1,3})?)(?:\s+\d{1,5}(?:-\d{1,5})?)?$)",
-            std::regex_constants::icase);
-
-        std::smatch match;
-        m_is_validated = std::regex_match(m_value, match, r1);
-        if (!m_is_validated) {
-            return m_is_validated;
-        }
-        for (std::size_t i = 0; i < match.size(); ++i) {
-            if (!match[i].matched)
-                continue;
-            std::string piece = match[i].str();
-            switch (i) {
-                case 1:
-                    m_action = piece;
-                    break;
-                case 2:
-                    m_direction = piece;
-                    break;
-                case 3:
-                    m_protocol = piece;
-                    break;
-                case 4:
-                    m_src = piece;
-                    break;
-                case 5:
-                    m_dst = piece;
-                    break;
-                default:
-                    break;
-            }
+        return m_direction != invalid;
+    }
+
+    // The binary form of the rule, built on each call, std::nullopt at once for a rule known to
+    // be invalid
+    std::optional<IPFilter> filter() const
+    {
+        if (m_direction == invalid) {
+            return std::nullopt;
         }
-        return m_is_validated;
+        return IPFilter::parse(m_value);
     }
 
-    value_type value() const noexcept
+    const value_type& value() const noexcept
     {
         return m_value;
     }
@@ -76,37 +68,85 @@ public:
         return m_value.size();
     }
 
-    action_type action() const noexcept
+    // The parts are empty if the rule is invalid
+
+    action_type action() const
     {
-        return m_action;
+        return m_direction != invalid ? token(0) : action_type();
     }
 
-    direction_type direction() const noexcept
+    direction_type direction() const
     {
-        return m_direction;
+        return m_direction != invalid ? token(m_direction) : direction_type();
     }
-    protocol_type protocol() const noexcept
+
+    protocol_type protocol() const
     {
-        return m_protocol;
+        return m_direction != invalid ? token(m_protocol) : protocol_type();
     }
-    address_type src() const noexcept
+
+    address_type src() const
     {
-        return m_src;
+        return m_direction != invalid ? endpoint(m_src) : address_type();
     }
-    address_type dst() const noexcept
+
+    address_type dst() const
     {
-        return m_dst;
+        return m_direction != invalid ? endpoint(m_dst) : address_type();
     }
 
 private:
-    value_type m_value;
+    // m_direction of an invalid rule
+    static constexpr uint16_t invalid = UINT16_MAX;
+
+    void parse()
+    {
+        detail::IPFilterParser parser;
+        if (m_value.size() >= invalid || !parser.parse(m_value)) {
+            return;
+        }
+        m_protocol = offset(parser.protocol());
+        m_src = offset(parser.src());
+        m_dst = offset(parser.dst());
+        m_direction = offset(parser.direction());
+    }
 
-    bool m_is_validated {false};
-    action_type m_action;
-    direction_type m_direction;
-    protocol_type m_protocol;
-    address_type m_src;
-    address_type m_dst;
+    uint16_t offset(std::string_view part) const noexcept
+    {
+        return static_cast<uint16_t>(part.data() - m_value.data());
+    }
+
+    // The token at or after pos
+    std::string_view token(std::size_t pos) const noexcept
+    {
+        std::string_view rule(m_value);
+        while (pos < rule.size() && detail::IPFilterParser::is_space(rule[pos])) {
+            ++pos;
+        }
+        auto begin = pos;
+        while (pos < rule.size() && !detail::IPFilterParser::is_space(rule[pos])) {
+            ++pos;
+        }
+        return rule.substr(begin, pos - begin);
+    }
+
+    // The address at pos, with its '!' which may be a token of its own
+    std::string_view endpoint(std::size_t pos) const noexcept
+    {
+        auto address = token(pos);
+        if (address == "!") {
+            address = token(pos + 1);
+        }
+        return std::string_view(m_value).substr(pos,
+            static_cast<std::size_t>(address.data() - m_value.data()) + address.size() - pos);
+    }
+
+    value_type m_value;
+    // Offsets of the parts into m_value, the action is the first token
+    uint16_t m_direction {invalid};
+    uint16_t m_protocol {0};
+    uint16_t m_src {0};
+    uint16_t m_dst {0};
 };
 
 } // namespace diameter::message::avp::value
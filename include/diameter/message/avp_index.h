@@ -0,0 +1,250 @@
+#ifndef DIAMETER_MESSAGE_AVP_INDEX_H
+#define DIAMETER_MESSAGE_AVP_INDEX_H
+
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+#include <diameter/message/avp/avp.h>
+#include <diameter/message/span.h>
+
+namespace diameter::message {
+
+/*
+ * Lookup index over a list of AVPs.
+ *
+ * The index maps (code, vendor id) to all occurrences of the AVP, in the order they appear in the
+ * list, and answers find/find_all with a single probe of an open addressing hash table. AVPs
+ * holding a Grouped value get their own nested index, which is used by find_path. The decoder
+ * keeps values raw: the AVPs known to be Grouped are decoded as Grouped by
+ * netpacker::get<Message>(possition, last, index, is_grouped), so that they are indexed as nested.
+ *
+ * The index stores pointers to the AVPs, it is invalidated by any modification of the indexed
+ * list (or of the nested Grouped lists).
+ *
+ * Path syntax: AVP codes separated by '/', every code may be followed by a vendor id after '@'
+ * and by the zero based occurrence number in brackets, e.g. "456[1]/437/421" or
+ * "873@10415/874@10415/2@10415".
+ */
+class AvpIndex
+{
+public:
+    using Range = Span<const avp::AVP* const>;
+
+    AvpIndex() = default;
+
+    AvpIndex(AvpIndex const&) = default;
+    AvpIndex& operator= (AvpIndex const&) = default;
+    AvpIndex(AvpIndex&&) = default;
+    AvpIndex& operator= (AvpIndex&&) = default;
+
+    explicit AvpIndex(const avp::AvpList& avps)
+    {
+        build(avps);
+    }
+
+    void build(const avp::AvpList& avps)
+    {
+        std::size_t capacity = 4;
+        while (capacity < avps.size() * 2) {
+            capacity <<= 1;
+        }
+        m_mask = capacity - 1;
+        m_slots.assign(capacity, Slot {});
+        m_entries.assign(avps.size(), nullptr);
+        m_children.clear();
+        m_child_of.assign(avps.size(), npos);
+
+        // Count occurrences of every key
+        for (const auto& avp : avps) {
+            auto& slot = m_slots[probe(avp.code, avp.vendor_id)];
+            if (!slot.used) {
+                slot.used = true;
+                slot.code = avp.code;
+                slot.vendor_id = avp.vendor_id.value_or(0);
+                slot.has_vendor_id = avp.vendor_id.has_value();
+            }
+            ++slot.count;
+        }
+
+        // Assign every key a contiguous run of entries
+        uint32_t first = 0;
+        for (auto& slot : m_slots) {
+            slot.first = first;
+            first += slot.count;
+            slot.count = 0;
+        }
+
+        for (const auto& avp : avps) {
+            auto& slot = m_slots[probe(avp.code, avp.vendor_id)];
+            auto pos = slot.first + slot.count++;
+            m_entries[pos] = &avp;
+            if (const auto* grouped = std::get_if<avp::Grouped>(&avp.value)) {
+                m_child_of[pos] = static_cast<uint32_t>(m_children.size());
+                m_children.emplace_back(**grouped);
+            }
+        }
+    }
+
+    const avp::AVP* find(avp::Code code,
+        std::optional<avp::VendorId> vendor_id = std::nullopt) const noexcept
+    {
+        auto all = find_all(code, vendor_id);
+        return all.empty() ? nullptr : all.front();
+    }
+
+    Range find_all(avp::Code code,
+        std::optional<avp::VendorId> vendor_id = std::nullopt) const noexcept
+    {
+        if (m_slots.empty()) {
+            return Range();
+        }
+        const auto& slot = m_slots[probe(code, vendor_id)];
+        return Range(m_entries.data() + slot.first, slot.count);
+    }
+
+    // Index of the Grouped AVP found by find/find_all, nullptr if the value is not Grouped
+    const AvpIndex* child(const avp::AVP* avp) const noexcept
+    {
+        if (avp == nullptr) {
+            return nullptr;
+        }
+        auto all = find_all(avp->code, avp->vendor_id);
+        for (std::size_t i = 0; i < all.size(); ++i) {
+            if (all[i] == avp) {
+                auto pos = static_cast<std::size_t>(all.data() - m_entries.data()) + i;
+                return m_child_of[pos] == npos ? nullptr : &m_children[m_child_of[pos]];
+            }
+        }
+        return nullptr;
+    }
+
+    // Throws std::invalid_argument if the path is malformed
+    const avp::AVP* find_path(std::string_view path) const
+    {
+        const AvpIndex* index = this;
+        const avp::AVP* avp = nullptr;
+        while (true) {
+            auto end = path.find('/');
+            auto step = parse_step(path.substr(0, end));
+            if (index == nullptr) {
+                return nullptr;
+            }
+
+            auto all = index->find_all(step.code, step.vendor_id);
+            if (step.occurrence >= all.size()) {
+                return nullptr;
+            }
+            avp = all[step.occurrence];
+            if (end == std::string_view::npos) {
+                return avp;
+            }
+
+            auto pos = static_cast<std::size_t>(all.data() - index->m_entries.data())
+                + step.occurrence;
+            index = index->m_child_of[pos] == npos ? nullptr
+                                                   : &index->m_children[index->m_child_of[pos]];
+            path.remove_prefix(end + 1);
+        }
+    }
+
+    // Number of indexed AVPs at the top level
+    std::size_t size() const noexcept
+    {
+        return m_entries.size();
+    }
+
+private:
+    static constexpr uint32_t npos = std::numeric_limits<uint32_t>::max();
+
+    struct Slot
+    {
+        avp::Code code {0};
+        avp::VendorId vendor_id {0};
+        bool has_vendor_id {false};
+        bool used {false};
+        uint32_t first {0};
+        uint32_t count {0};
+    };
+
+    struct Step
+    {
+        avp::Code code {0};
+        std::optional<avp::VendorId> vendor_id;
+        std::size_t occurrence {0};
+    };
+
+    // Slot of the key, or the unused slot where it would be inserted
+    std::size_t probe(avp::Code code, std::optional<avp::VendorId> vendor_id) const noexcept
+    {
+        auto vendor = vendor_id.value_or(0);
+        auto hash = (code * 0x9e3779b1u) ^ (vendor * 0x85ebca6bu) ^ (vendor_id ? 1u : 0u);
+        auto pos = static_cast<std::size_t>(hash ^ (hash >> 15)) & m_mask;
+        while (true) {
+            const auto& slot = m_slots[pos];
+            if (!slot.used) {
+                return pos;
+            }
+            if (slot.code == code && slot.vendor_id == vendor
+                && slot.has_vendor_id == vendor_id.has_value()) {
+                return pos;
+            }
+            pos = (pos + 1) & m_mask;
+        }
+    }
+
+    static Step parse_step(std::string_view step)
+    {
+        Step result;
+        std::size_t pos = 0;
+        result.code = parse_number<avp::Code>(step, pos);
+        if (pos < step.size() && step[pos] == '@') {
+            ++pos;
+            result.vendor_id = parse_number<avp::VendorId>(step, pos);
+        }
+        if (pos < step.size() && step[pos] == '[') {
+            ++pos;
+            result.occurrence = parse_number<std::size_t>(step, pos);
+            if (pos >= step.size() || step[pos] != ']') {
+                throw std::invalid_argument("AvpIndex: invalid path");
+            }
+            ++pos;
+        }
+        if (pos != step.size()) {
+            throw std::invalid_argument("AvpIndex: invalid path");
+        }
+        return result;
+    }
+
+    template<typename T>
+    static T parse_number(std::string_view str, std::size_t& pos)
+    {
+        auto start = pos;
+        uint64_t value = 0;
+        while (pos < str.size() && str[pos] >= '0' && str[pos] <= '9') {
+            value = value * 10 + static_cast<uint64_t>(str[pos] - '0');
+            if (value > std::numeric_limits<T>::max()) {
+                throw std::invalid_argument("AvpIndex: invalid path");
+            }
+            ++pos;
+        }
+        if (pos == start) {
+            throw std::invalid_argument("AvpIndex: invalid path");
+        }
+        return static_cast<T>(value);
+    }
+
+    std::vector<Slot> m_slots;
+    std::size_t m_mask {0};
+    std::vector<const avp::AVP*> m_entries;
+    std::vector<AvpIndex> m_children;
+    std::vector<uint32_t> m_child_of;
+};
+
+} // namespace diameter::message
+
+#endif
@@ -1,20 +1,35 @@
 #ifndef DIAMETER_MESSAGE_FLAGS_FLAGS_H
 #define DIAMETER_MESSAGE_FLAGS_FLAGS_H
 
-#include <bitset>
 #include <cstddef>
-#include <stdexcept>
+#include <cstdint>
 #include <type_traits>
 
 namespace diameter::message::flags {
 
+namespace detail {
+
+// The smallest unsigned integer of at least N bits
+template<std::size_t N>
+using FlagsStorage = std::conditional_t<N <= 8, uint8_t,
+    std::conditional_t<N <= 16, uint16_t,
+    std::conditional_t<N <= 32, uint32_t, uint64_t>>>;
+
+} // namespace detail
+
+/*
+ * Set of flags indexed by the bit numbers of EnumT, stored in the smallest unsigned integer which
+ * holds N bits: the flags of an AVP or of a message header take one byte.
+ */
 template<typename EnumT, std::size_t N>
 class Flags
 {
     static_assert(std::is_enum_v<EnumT>, "Flags can only be specialized for enum types");
+    static_assert(N <= 64, "Flags: too many flags");
 
 public:
     using UnderlyingT = typename std::make_unsigned_t<typename std::underlying_type_t<EnumT>>;
+    using StorageT = detail::FlagsStorage<N>;
 
     Flags() = default;
 
@@ -24,18 +39,18 @@ public:
     Flags& operator= (Flags&&) = default;
 
     Flags(UnderlyingT value)
-        : bits_ {value}
+        : bits_ {static_cast<StorageT>(value & mask)}
     {
     }
 
     Flags(EnumT e)
+        : bits_ {bit(e)}
     {
-        bits_.set(underlying(e), true);
     }
 
     Flags& set(EnumT e, bool value = true) noexcept
     {
-        bits_.set(underlying(e), value);
+        bits_ = static_cast<StorageT>(value ? bits_ | bit(e) : bits_ & ~bit(e));
         return *this;
     }
 
@@ -47,92 +62,88 @@ public:
 
     Flags& reset() noexcept
     {
-        bits_.reset();
+        bits_ = 0;
         return *this;
     }
 
     bool all() const noexcept
     {
-        return bits_.all();
+        return bits_ == mask;
     }
 
     bool any() const noexcept
     {
-        return bits_.any();
+        return bits_ != 0;
     }
 
     bool none() const noexcept
     {
-        return bits_.none();
+        return bits_ == 0;
     }
 
     constexpr std::size_t size() const
     {
-        if constexpr (N <= 8) {
-            return sizeof(uint8_t);
-        }
-        else if constexpr (N <= 16) {
-            return sizeof(uint16_t);
-        }
-        else if constexpr (N <= 32) {
-            return sizeof(uint32_t);
-        }
-        else if constexpr (N <= 64) {
-            return sizeof(uint64_t);
-        }
-        else {
-            throw std::runtime_error("Too big flag value");
-        }
+        return sizeof(StorageT);
     }
 
     std::size_t count() const noexcept
     {
-        return bits_.count();
+        std::size_t count = 0;
+        for (auto bits = bits_; bits != 0; bits = static_cast<StorageT>(bits & (bits - 1))) {
+            ++count;
+        }
+        return count;
     }
 
     uint64_t to_ullong() const noexcept
     {
-        return bits_.to_ullong();
+        return bits_;
     }
 
     UnderlyingT data() const noexcept
     {
-        return static_cast<UnderlyingT>(bits_.to_ullong());
+        return static_cast<UnderlyingT>(bits_);
     }
 
     constexpr bool operator[] (EnumT e) const
     {
-        return bits_[underlying(e)];
+        return (bits_ & bit(e)) != 0;
     }
 
     Flags operator| (const Flags& other) const noexcept
     {
-        return Flags(bits_ | other.bits_);
+        return from_bits(static_cast<StorageT>(bits_ | other.bits_));
     }
 
     Flags operator& (const Flags& other) const noexcept
     {
-        return Flags(bits_ & other.bits_);
+        return from_bits(static_cast<StorageT>(bits_ & other.bits_));
     }
 
     Flags operator^ (const Flags& other) const noexcept
     {
-        return Flags(bits_ ^ other.bits_);
+        return from_bits(static_cast<StorageT>(bits_ ^ other.bits_));
     }
 
 private:
-    Flags(std::bitset<N> value)
-        : bits_ {value}
+    static constexpr StorageT mask = N == 64
+        ? static_cast<StorageT>(~uint64_t {0})
+        : static_cast<StorageT>((uint64_t {1} << N) - 1);
+
+    static constexpr StorageT bit(EnumT e)
     {
+        return static_cast<StorageT>(StorageT {1} << static_cast<UnderlyingT>(e));
     }
 
-    static constexpr UnderlyingT underlying(EnumT e)
+    static Flags from_bits(StorageT bits) noexcept
     {
-        return static_cast<UnderlyingT>(e);
+        Flags flags;
+        flags.bits_ = bits;
+        return flags;
     }
 
 private:
-    std::bitset<N> bits_;
+    StorageT bits_ {0};
 };
 
 } // namespace diameter::message::flags
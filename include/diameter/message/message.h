@@ -1,8 +1,6 @@
 #ifndef DIAMETER_MESSAGE_MESSAGE_H
 #define DIAMETER_MESSAGE_MESSAGE_H
 
-#include <list>
-
 #include <diameter/message/avp/avp.h>
 #include <diameter/message/header/header.h>
 
@@ -11,7 +9,7 @@ namespace diameter::message {
 struct Message
 {
     header::Header header;
-    std::list<avp::AVP> avps;
+    avp::AvpList avps;
 
     Message() = default;
 
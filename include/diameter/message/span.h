@@ -0,0 +1,154 @@
+#ifndef DIAMETER_MESSAGE_SPAN_H
+#define DIAMETER_MESSAGE_SPAN_H
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+
+namespace diameter::message {
+
+/*
+ * Non-owning view over a contiguous sequence of objects (a C++17 stand-in for std::span with a
+ * dynamic extent). Used to reference bytes of a receive buffer without copying them.
+ */
+template<typename T>
+class Span
+{
+public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+    using iterator = T*;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+    constexpr Span() noexcept = default;
+
+    constexpr Span(Span const&) noexcept = default;
+    constexpr Span& operator= (Span const&) noexcept = default;
+
+    constexpr Span(pointer data, size_type size) noexcept
+        : m_data(data),
+          m_size(size)
+    {
+    }
+
+    constexpr Span(pointer first, pointer last) noexcept
+        : m_data(first),
+          m_size(static_cast<size_type>(last - first))
+    {
+    }
+
+    template<std::size_t N>
+    constexpr Span(element_type (&array)[N]) noexcept
+        : m_data(array),
+          m_size(N)
+    {
+    }
+
+    template<typename Container,
+             typename = std::enable_if_t<
+             std::is_convertible_v<decltype(std::data(std::declval<Container&>())), pointer>
+             && !std::is_array_v<Container>>>
+    constexpr Span(Container& container) noexcept
+        : m_data(std::data(container)),
+          m_size(std::size(container))
+    {
+    }
+
+    template<typename U,
+             typename = std::enable_if_t<
+             !std::is_same_v<U, T> && std::is_convertible_v<U (*)[], T (*)[]>>>
+    constexpr Span(Span<U> const& other) noexcept
+        : m_data(other.data()),
+          m_size(other.size())
+    {
+    }
+
+    constexpr pointer data() const noexcept
+    {
+        return m_data;
+    }
+
+    constexpr size_type size() const noexcept
+    {
+        return m_size;
+    }
+
+    constexpr bool empty() const noexcept
+    {
+        return m_size == 0;
+    }
+
+    constexpr iterator begin() const noexcept
+    {
+        return m_data;
+    }
+
+    constexpr iterator end() const noexcept
+    {
+        return m_data + m_size;
+    }
+
+    constexpr reverse_iterator rbegin() const noexcept
+    {
+        return reverse_iterator(end());
+    }
+
+    constexpr reverse_iterator rend() const noexcept
+    {
+        return reverse_iterator(begin());
+    }
+
+    constexpr reference operator[] (size_type idx) const noexcept
+    {
+        assert(idx < m_size);
+        return m_data[idx];
+    }
+
+    constexpr reference front() const noexcept
+    {
+        assert(!empty());
+        return m_data[0];
+    }
+
+    constexpr reference back() const noexcept
+    {
+        assert(!empty());
+        return m_data[m_size - 1];
+    }
+
+    constexpr Span first(size_type count) const noexcept
+    {
+        assert(count <= m_size);
+        return Span(m_data, count);
+    }
+
+    constexpr Span last(size_type count) const noexcept
+    {
+        assert(count <= m_size);
+        return Span(m_data + (m_size - count), count);
+    }
+
+    constexpr Span subspan(size_type offset, size_type count = npos) const noexcept
+    {
+        assert(offset <= m_size);
+        return Span(m_data + offset, count == npos ? m_size - offset : count);
+    }
+
+private:
+    pointer m_data {nullptr};
+    size_type m_size {0};
+};
+
+using ByteSpan = Span<const uint8_t>;
+
+} // namespace diameter::message
+
+#endif
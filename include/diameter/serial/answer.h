@@ -0,0 +1,206 @@
+#ifndef DIAMETER_SERIAL_ANSWER_H
+#define DIAMETER_SERIAL_ANSWER_H
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include <netpacker/netpacker.h>
+
+#include <diameter/application/base/avp.h>
+#include <diameter/message/avp/avp.h>
+#include <diameter/message/avp/value/detail/fqdn.h>
+#include <diameter/message/span.h>
+#include <diameter/serial/avp/avp.h>
+#include <diameter/serial/detail/byte_order.h>
+#include <diameter/serial/record.h>
+#include <diameter/serial/view/view.h>
+
+namespace diameter::serial {
+
+/*
+ * Encoded answer being built at the end of a buffer, see AnswerBuilder::make_answer().
+ *
+ * The AVPs are appended to the buffer as they are added, the Message Length is set by finish().
+ * The buffer grows only past its capacity: a buffer reused with enough capacity does not
+ * allocate. The writer refers to the buffer, which must outlive it.
+ */
+class AnswerWriter
+{
+public:
+    AnswerWriter(AnswerWriter const&) = delete;
+    AnswerWriter& operator= (AnswerWriter const&) = delete;
+    AnswerWriter(AnswerWriter&&) = default;
+    AnswerWriter& operator= (AnswerWriter&&) = delete;
+
+    // An AVP of the AvpDef with a value of a record member type, see serial/record.h
+    template<typename Def, typename T>
+    AnswerWriter& add(const T& value)
+    {
+        return add(Def::code, Def::vendor, Def::flag_bits, value);
+    }
+
+    template<typename T>
+    AnswerWriter& add(message::avp::Code code, message::avp::VendorId vendor_id,
+        uint8_t flag_bits, const T& value)
+    {
+        auto* p = grow(record::detail::avp_size(flag_bits, record::value_size(value)));
+        record::detail::PutVisitor {p}(code, vendor_id, flag_bits, value);
+        return *this;
+    }
+
+    AnswerWriter& add(const message::avp::AVP& avp)
+    {
+        auto size = avp.size();
+        auto* p = grow(size);
+        netpacker::put(p, p + size, avp);
+        return *this;
+    }
+
+    // An encoded AVP, e.g. of the request, as it is
+    AnswerWriter& add(const view::AvpView& avp)
+    {
+        auto raw = avp.raw();
+        std::memcpy(grow(raw.size()), raw.data(), raw.size());
+        return *this;
+    }
+
+    // Sets the Message Length, returns the encoded answer
+    message::ByteSpan finish() noexcept
+    {
+        auto size = m_out.size() - m_begin;
+        detail::store_u24(m_out.data() + m_begin + 1, static_cast<uint32_t>(size));
+        return message::ByteSpan(m_out.data() + m_begin, size);
+    }
+
+private:
+    friend class AnswerBuilder;
+
+    explicit AnswerWriter(std::vector<uint8_t>& out) noexcept
+        : m_out(out),
+          m_begin(out.size())
+    {
+    }
+
+    uint8_t* grow(std::size_t size)
+    {
+        auto offset = m_out.size();
+        m_out.resize(offset + size);
+        return m_out.data() + offset;
+    }
+
+    std::vector<uint8_t>& m_out;
+    std::size_t m_begin;
+};
+
+/*
+ * Derives answers from encoded requests, RFC 6733 6.2: the header of the request with the 'R' and
+ * 'T' flags cleared, the 'P' flag kept and the same Hop-by-Hop and End-to-End Identifiers, the
+ * 'E' flag set for a protocol error (3xxx). The Session-Id of the request is copied first, then
+ * come the Result-Code, the Origin-Host and Origin-Realm of the node and the Proxy-Info AVPs of
+ * the request in their order.
+ *
+ * The request is a MessageView: it is neither decoded nor copied, the AVPs which are copied are
+ * copied as they are encoded. The Origin-Host and Origin-Realm AVPs are encoded once, by the
+ * constructor, which throws std::invalid_argument if they are not FQDNs. The builder is immutable
+ * and shared by the threads.
+ */
+class AnswerBuilder
+{
+public:
+    AnswerBuilder() = default;
+
+    AnswerBuilder(AnswerBuilder const&) = default;
+    AnswerBuilder& operator= (AnswerBuilder const&) = default;
+    AnswerBuilder(AnswerBuilder&&) = default;
+    AnswerBuilder& operator= (AnswerBuilder&&) = default;
+
+    AnswerBuilder(std::string_view origin_host, std::string_view origin_realm)
+    {
+        namespace base = application::base;
+
+        if (!message::avp::value::detail::is_fqdn(origin_host)
+            || !message::avp::value::detail::is_fqdn(origin_realm)) {
+            throw std::invalid_argument("AnswerBuilder: invalid Origin-Host or Origin-Realm");
+        }
+        AnswerWriter writer(m_origin);
+        writer.add<base::avp::OriginHost>(origin_host);
+        writer.add<base::avp::OriginRealm>(origin_realm);
+    }
+
+    /*
+     * Appends the beginning of the answer to `request` to `out` and returns the writer of its
+     * other AVPs. A result code of 0 leaves out the Result-Code, e.g. for an Experimental-Result.
+     *
+     * The size of the beginning is reserved before anything is written, so the AVPs are copied
+     * from the request after `out` has grown. The request may lie in `out` only if its capacity
+     * holds the beginning already, otherwise std::invalid_argument is thrown: growing `out` would
+     * free the request. The AVPs of such a request added to the writer later must fit the
+     * capacity as well.
+     */
+    AnswerWriter make_answer(const view::MessageView& request, uint32_t result_code,
+        std::vector<uint8_t>& out) const
+    {
+        namespace base = application::base;
+        constexpr uint8_t error_bit = 0x20;
+        // 'R', 'E' and 'T'
+        constexpr uint8_t cleared_bits = 0x80 | error_bit | 0x10;
+
+        auto session_id = request.find(base::avp::SessionId::code);
+        auto size = view::MessageView::header_size + m_origin.size();
+        if (session_id) {
+            size += session_id->size();
+        }
+        if (result_code != 0) {
+            size += record::detail::avp_size(base::avp::ResultCode::flag_bits,
+                record::value_size(result_code));
+        }
+        for (const auto& avp : request.avps()) {
+            if (avp.code() == base::avp::ProxyInfo::code && !avp.is_vendor_specific()) {
+                size += avp.size();
+            }
+        }
+        std::less<const uint8_t*> before;
+        const auto* first = request.data().data();
+        if (!before(first, out.data()) && before(first, out.data() + out.capacity())
+            && out.capacity() - out.size() < size) {
+            throw std::invalid_argument("AnswerBuilder: the request is in the growing buffer");
+        }
+        out.reserve(out.size() + size);
+
+        AnswerWriter writer(out);
+        auto* header = writer.grow(view::MessageView::header_size);
+        std::memcpy(header, request.data().data(), view::MessageView::header_size);
+        header[4] = static_cast<uint8_t>(header[4] & ~cleared_bits);
+        if (result_code >= 3000 && result_code < 4000) {
+            header[4] = static_cast<uint8_t>(header[4] | error_bit);
+        }
+
+        if (session_id) {
+            writer.add(*session_id);
+        }
+        if (result_code != 0) {
+            writer.add<base::avp::ResultCode>(result_code);
+        }
+        if (!m_origin.empty()) {
+            std::memcpy(writer.grow(m_origin.size()), m_origin.data(), m_origin.size());
+        }
+        for (const auto& avp : request.avps()) {
+            if (avp.code() == base::avp::ProxyInfo::code && !avp.is_vendor_specific()) {
+                writer.add(avp);
+            }
+        }
+        return writer;
+    }
+
+private:
+    // The encoded Origin-Host and Origin-Realm AVPs
+    std::vector<uint8_t> m_origin;
+};
+
+} // namespace diameter::serial
+
+#endif
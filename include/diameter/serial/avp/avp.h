@@ -1,13 +1,20 @@
 #ifndef DIAMETER_SERIAL_AVP_AVP_H
 #define DIAMETER_SERIAL_AVP_AVP_H
 
+#include <algorithm>
+#include <array>
 #include <exception>
+#include <iterator>
+#include <memory_resource>
+#include <optional>
+#include <variant>
 
 #include <netpacker/netpacker.h>
 
 #include <diameter/message/avp/avp.h>
 #include <diameter/message/type_traits.h>
 #include <diameter/serial/avp/flags.h>
+#include <diameter/serial/detail/bytes.h>
 #include <diameter/serial/error.h>
 
 // RFC 6733
@@ -30,45 +37,111 @@ namespace diameter::serial::avp {
 template<typename To>
 To value_as(const message::avp::Value& value);
 
+template<typename T, typename OutputIt>
+OutputIt put_value(OutputIt possition, OutputIt last, const T& value);
+
+}
+
+namespace diameter::serial::detail {
+
+// The AVP header, up to the data
+struct AvpHeader
+{
+    message::avp::Code code {0};
+    message::avp::Flags flags;
+    std::optional<message::avp::VendorId> vendor_id;
+    // Length of the data, and of the padding which follows it
+    std::size_t data_length {0};
+    std::size_t padding {0};
+};
+
+template<typename InputIt>
+AvpHeader get_avp_header(InputIt& possition, InputIt last)
+{
+    namespace dma = message::avp;
+
+    AvpHeader header;
+    header.code = netpacker::get<dma::Code>(possition, last);
+    header.flags = netpacker::get<dma::Flags>(possition, last);
+
+    auto length = netpacker::get<dma::Length>(possition, last, 3);
+    header.padding = dma::AVP::padding(length);
+    if (length < 8) {
+        throw InvalidAvpLength("Invalid avp length: too small");
+    }
+    length -= 8;
+
+    if (header.flags[dma::Flag::VendorSpecific]) {
+        if (length < 4) {
+            throw InvalidAvpLength("Invalid avp length: too small for vendor specific");
+        }
+        header.vendor_id = netpacker::get<dma::VendorId>(possition, last);
+        length -= 4;
+    }
+    header.data_length = length;
+    return header;
 }
 
+} // namespace diameter::serial::detail
+
 namespace netpacker {
 
+// The raw value is allocated from the memory resource
 template <typename T,
           typename InputIt,
           diameter::message::is_diameter_message_avp_value<T>* dummy = nullptr>
-T get(InputIt& possition, InputIt last, typename std::iterator_traits<InputIt>::difference_type len)
+T get(InputIt& possition, InputIt last, typename std::iterator_traits<InputIt>::difference_type len,
+    std::pmr::memory_resource* resource)
 {
     namespace dma = diameter::message::avp;
-    auto raw_data = get<dma::OctetString::value_type>(possition, last, len);
+    auto raw_data = dma::OctetString::value_type(resource);
+    diameter::serial::detail::get_bytes(possition, last, static_cast<std::size_t>(len), raw_data);
     auto value = dma::OctetString(std::move(raw_data));
     return T {std::move(value)};
 }
 
+template <typename T,
+          typename InputIt,
+          diameter::message::is_diameter_message_avp_value<T>* dummy = nullptr>
+T get(InputIt& possition, InputIt last, typename std::iterator_traits<InputIt>::difference_type len)
+{
+    return get<T>(possition, last, len, std::pmr::get_default_resource());
+}
+
 template <typename OutputIt,
             typename T,
             diameter::message::is_diameter_message_avp_value<T>* dummy = nullptr>
 OutputIt put(OutputIt possition, OutputIt last, const T& value)
 {
-    namespace dma = diameter::message::avp;
-    namespace dsa = diameter::serial::avp;
-    const auto& octet_string_avp = dsa::value_as<dma::OctetString>(value);
-    return put(possition, last, *octet_string_avp);
+    // Every alternative is written straight into the output, without an intermediate OctetString
+    return std::visit(
+        [&](const auto& arg) {
+            return diameter::serial::avp::put_value(possition, last, arg);
+        },
+        value);
 }
 
 template <typename T,
           typename InputIt,
           diameter::message::is_diameter_message_avp_address<T>* dummy = nullptr>
-T get(InputIt& possition, InputIt last)
+T get(InputIt& possition, InputIt last,
+    std::pmr::memory_resource* resource = std::pmr::get_default_resource())
 {
     namespace dma = diameter::message::avp;
 
-    auto address_family = get<typename T::value_type::address_family_type>(possition, last);
-    auto address_value
-        = get<typename T::value_type::value_type>(possition, last, std::distance(possition, last));
+    using AddressBase = typename T::value_type;
 
-    auto value = dma::Address(address_family, address_value);
-    return T {std::move(value)};
+    auto address_family = get<typename AddressBase::address_family_type>(possition, last);
+    auto size = static_cast<std::size_t>(std::distance(possition, last));
+    if (size <= AddressBase::inline_capacity) {
+        std::array<uint8_t, AddressBase::inline_capacity> bytes;
+        std::copy(possition, last, bytes.begin());
+        possition = last;
+        return T {dma::Address(address_family, diameter::message::ByteSpan(bytes.data(), size))};
+    }
+    auto address_value = std::pmr::vector<uint8_t>(resource);
+    diameter::serial::detail::get_bytes(possition, last, size, address_value);
+    return T {dma::Address(address_family, diameter::message::ByteSpan(address_value), resource)};
 }
 
 
@@ -77,11 +150,15 @@ template <typename OutputIt,
             diameter::message::is_diameter_message_avp<T>* dummy = nullptr>
 OutputIt put(OutputIt possition, OutputIt last, const T& value)
 {
+    namespace dma = diameter::message::avp;
+
     auto pos = put(possition, last, value.code);
     pos = put(pos, last, value.flags);
-    pos = put(pos, last, value.length(), 3);
+    // The length is known once the value is written
+    auto length_pos = pos;
+    pos = skipbytes(pos, last, 3);
 
-    if (value.flags[diameter::message::avp::Flag::VendorSpecific]) {
+    if (value.flags[dma::Flag::VendorSpecific]) {
         if (!value.vendor_id.has_value()) {
             throw diameter::serial::InvalidAvpVendorId();
         }
@@ -89,37 +166,34 @@ OutputIt put(OutputIt possition, OutputIt last, const T& value)
     }
 
     pos = put(pos, last, value.value);
-    pos = skipbytes(pos, last, value.padding());
+
+    auto length = static_cast<dma::Length>(std::distance(possition, pos));
+    put(length_pos, last, length, 3);
+    pos = skipbytes(pos, last, dma::AVP::padding(length));
     return pos;
 }
 
+// The value is allocated from the memory resource
 template <typename T,
             typename InputIt,
             diameter::message::is_diameter_message_avp<T>* dummy = nullptr>
-T get(InputIt& possition, InputIt last)
+T get(InputIt& possition, InputIt last, std::pmr::memory_resource* resource)
 {
-    T value;
-    value.code = get<decltype(value.code)>(possition, last);
-    value.flags = get<decltype(value.flags)>(possition, last);
-
-    auto length = get<diameter::message::avp::Length>(possition, last, 3);
-    if (length < 8) {
-        throw diameter::serial::InvalidAvpLength("Invalid avp length: too small");
-    }
-    length -= 8;
-
-    if (value.flags[diameter::message::avp::Flag::VendorSpecific]) {
-        if (length < 4) {
-            throw diameter::serial::InvalidAvpLength(
-                "Invalid avp length: too small for vendor specific");
-        }
-        value.vendor_id = get<diameter::message::avp::VendorId>(possition, last);
-        length -= 4;
-    }
+    auto header = diameter::serial::detail::get_avp_header(possition, last);
+    auto value = get<diameter::message::avp::Value>(possition, last,
+        static_cast<typename std::iterator_traits<InputIt>::difference_type>(header.data_length),
+        resource);
+    possition = skipbytes(possition, last, header.padding);
+    // Constructed from the value, assigning it would copy it to the default resource
+    return T {header.code, header.flags, header.vendor_id, std::move(value)};
+}
 
-    value.value = get<diameter::message::avp::Value>(possition, last, length);
-    possition = skipbytes(possition, last, value.padding());
-    return value;
+template <typename T,
+            typename InputIt,
+            diameter::message::is_diameter_message_avp<T>* dummy = nullptr>
+T get(InputIt& possition, InputIt last)
+{
+    return get<T>(possition, last, std::pmr::get_default_resource());
 }
 
 } // namespace netpacker
@@ -160,16 +234,16 @@ To cast(const From& value)
         else if constexpr (std::is_same_v<std::decay_t<To>, std::decay_t<message::avp::Address>>) {
             // OctetString -> Address
             auto pos = from_raw_value.begin();
-            auto raw_value = netpacker::get<message::avp::Address>(pos, from_raw_value.end());
+            auto raw_value = netpacker::get<message::avp::Address>(pos, from_raw_value.end(),
+                from_raw_value.get_allocator().resource());
             return To(std::move(raw_value));
         }
         else if constexpr (
             std::is_same_v<std::decay_t<To>, std::decay_t<message::avp::UTF8String>>) {
             // OctetString -> UTF8String
-            auto pos = from_raw_value.begin();
-            auto raw_value = netpacker::get<typename To::value_type>(pos, from_raw_value.end(),
-                std::distance(pos, from_raw_value.end()));
-            return To(raw_value);
+            auto raw_value = typename To::value_type(from_raw_value.begin(), from_raw_value.end(),
+                from_raw_value.get_allocator().resource());
+            return To(std::move(raw_value));
         }
         else if constexpr (
             std::is_same_v<std::decay_t<To>, std::decay_t<message::avp::DiameterIdentity>>) {
@@ -209,16 +283,18 @@ To cast(const From& value)
         }
         else if constexpr (std::is_same_v<std::decay_t<To>, std::decay_t<message::avp::Grouped>>) {
             // OctetString -> Grouped
+            // The nested AVPs share the memory resource of the OctetString
+            auto resource = from_raw_value.get_allocator().resource();
             auto pos = from_raw_value.begin();
             auto alen = from_raw_value.size();
-            typename To::value_type raw_value;
+            typename To::value_type raw_value(resource);
             while (alen > 0) {
                 auto avp = netpacker::get<typename To::value_type::value_type>(pos,
-                    from_raw_value.end());
+                    from_raw_value.end(), resource);
                 alen -= avp.size();
-                raw_value.emplace_back(avp);
+                raw_value.emplace_back(std::move(avp));
             }
-            return To(raw_value);
+            return To(std::move(raw_value));
         }
     }
     else if constexpr (std::is_arithmetic_v<RawValue>) {
@@ -245,7 +321,7 @@ To cast(const From& value)
             typename To::value_type octet_string_v(value.size());
             auto pos = octet_string_v.begin();
             pos = netpacker::put(pos, octet_string_v.end(), from_raw_value.address_family());
-            pos = netpacker::put(pos, octet_string_v.end(), from_raw_value.value());
+            pos = detail::put_bytes(pos, octet_string_v.end(), from_raw_value.value());
             return To(octet_string_v);
         }
     }
@@ -254,7 +330,7 @@ To cast(const From& value)
         if constexpr (std::is_same_v<To, std::decay_t<message::avp::OctetString>>) {
             // UTF8String -> OctetString
             typename To::value_type octet_string_v(value.size());
-            netpacker::put(octet_string_v.begin(), octet_string_v.end(), from_raw_value);
+            detail::put_bytes(octet_string_v.begin(), octet_string_v.end(), from_raw_value);
             return To(octet_string_v);
         }
     }
@@ -320,6 +396,40 @@ To value_as(const message::avp::Value& value)
         value);
 }
 
+// Writes the value of a known type, without the AVP header and padding. Nothing is allocated,
+// Grouped AVPs are written recursively in place.
+template<typename T, typename OutputIt>
+OutputIt put_value(OutputIt possition, OutputIt last, const T& value)
+{
+    namespace dma = message::avp;
+    using RawValue = typename T::value_type;
+    if constexpr (std::is_arithmetic_v<RawValue>) {
+        return netpacker::put(possition, last, *value);
+    }
+    else if constexpr (std::is_same_v<T, dma::OctetString> || std::is_same_v<T, dma::UTF8String>) {
+        return detail::put_bytes(possition, last, *value);
+    }
+    else if constexpr (std::is_same_v<T, dma::Time> || std::is_same_v<T, dma::Enumerated>) {
+        return netpacker::put(possition, last, value->value());
+    }
+    else if constexpr (std::is_same_v<T, dma::DiameterIdentity>
+        || std::is_same_v<T, dma::DiameterURI> || std::is_same_v<T, dma::IPFilterRule>) {
+        return detail::put_bytes(possition, last, value->value());
+    }
+    else if constexpr (std::is_same_v<T, dma::Address>) {
+        auto pos = netpacker::put(possition, last, value->address_family());
+        return detail::put_bytes(pos, last, value->value());
+    }
+    else {
+        static_assert(std::is_same_v<T, dma::Grouped>, "put_value: unsupported value type");
+        auto pos = possition;
+        for (const auto& avp : *value) {
+            pos = netpacker::put(pos, last, avp);
+        }
+        return pos;
+    }
+}
+
 } // namespace diameter::serial::avp
 
 #endif
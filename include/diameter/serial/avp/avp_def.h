@@ -0,0 +1,159 @@
+#ifndef DIAMETER_SERIAL_AVP_AVP_DEF_H
+#define DIAMETER_SERIAL_AVP_AVP_DEF_H
+
+#include <algorithm>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include <netpacker/netpacker.h>
+
+#include <diameter/message/avp/avp.h>
+#include <diameter/message/avp/avp_def.h>
+#include <diameter/message/avp/value/detail/fqdn.h>
+#include <diameter/serial/avp/avp.h>
+
+// Typed access to AVPs described by message::avp::AvpDef, e.g.
+//
+//     using namespace diameter::application::base;
+//     auto session_id = serial::avp::get<avp::SessionId>(msg.avps);
+//     serial::avp::set<avp::ResultCode>(answer.avps, uint32_t{2001});
+//     pos = serial::avp::put<avp::OriginHost>(pos, last, origin_host);
+//     auto origin_realm = serial::avp::get<avp::OriginRealm>(msg.avps, identities);
+
+namespace diameter::serial::avp {
+
+// Encodes the AVP: the constexpr header, the value, the AVP Length and the padding
+template<typename Def, typename OutputIt>
+OutputIt put(OutputIt possition, OutputIt last, const typename Def::value_type& value)
+{
+    namespace dma = message::avp;
+
+    if (static_cast<std::size_t>(std::distance(possition, last)) < Def::header_length) {
+        throw netpacker::BufferOverflow();
+    }
+    auto pos = std::copy(Def::header.begin(), Def::header.end(), possition);
+    pos = put_value(pos, last, value);
+
+    auto length = static_cast<dma::Length>(std::distance(possition, pos));
+    netpacker::put(std::next(possition, 5), last, length, 3);
+    return netpacker::skipbytes(pos, last, dma::AVP::padding(length));
+}
+
+template<typename Def>
+const message::avp::AVP* find(const message::avp::AvpList& avps)
+{
+    auto it = std::find_if(avps.begin(), avps.end(), Def::matches);
+    return it != avps.end() ? &*it : nullptr;
+}
+
+// The value of the AVP, converted from the raw value of a decoded AVP
+template<typename Def>
+typename Def::value_type get(const message::avp::AVP& avp)
+{
+    using T = typename Def::value_type;
+    if (const auto* value = std::get_if<T>(&avp.value)) {
+        return *value;
+    }
+    return value_as<T>(avp.value);
+}
+
+// The value of the first matching AVP of the list
+template<typename Def>
+std::optional<typename Def::value_type> get(const message::avp::AvpList& avps)
+{
+    if (const auto* avp = find<Def>(avps)) {
+        return get<Def>(*avp);
+    }
+    return std::nullopt;
+}
+
+namespace detail {
+
+// The value referring to the entry of the text, a copy of the text if it is not in the table
+inline message::avp::DiameterIdentity find_identity(std::string_view text,
+    const message::avp::value::IdentityTable& table)
+{
+    if (const auto* entry = table.find(text)) {
+        return message::avp::DiameterIdentity(*entry);
+    }
+    return message::avp::DiameterIdentity(std::string(text));
+}
+
+} // namespace detail
+
+// The DiameterIdentity value looked up in the table: an identity already in the table is taken
+// without allocation, an identity which is not in it is copied. The table is not modified, values
+// from the wire do not fill it, see intern()
+template<typename Def>
+message::avp::DiameterIdentity get(const message::avp::AVP& avp,
+    const message::avp::value::IdentityTable& table)
+{
+    namespace dma = message::avp;
+    static_assert(std::is_same_v<typename Def::value_type, dma::DiameterIdentity>,
+        "get: the table is only for DiameterIdentity values");
+
+    if (const auto* value = std::get_if<dma::OctetString>(&avp.value)) {
+        const auto& bytes = **value;
+        return detail::find_identity(
+            std::string_view(reinterpret_cast<const char*>(bytes.data()), bytes.size()), table);
+    }
+    if (const auto* value = std::get_if<dma::DiameterIdentity>(&avp.value)) {
+        if ((*value)->entry() != nullptr && (*value)->entry()->table == &table) {
+            return *value;
+        }
+        return detail::find_identity((*value)->value(), table);
+    }
+    return detail::find_identity(value_as<dma::DiameterIdentity>(avp.value)->value(), table);
+}
+
+template<typename Def>
+std::optional<message::avp::DiameterIdentity> get(const message::avp::AvpList& avps,
+    const message::avp::value::IdentityTable& table)
+{
+    if (const auto* avp = find<Def>(avps)) {
+        return get<Def>(*avp, table);
+    }
+    return std::nullopt;
+}
+
+// Replaces the values of all matching AVPs of the list with DiameterIdentity values of the table,
+// e.g. the Route-Record AVPs after decoding, so loop detection compares table entries. A value
+// which is not in the table is added only if it is an FQDN and while the table has room: the
+// entries are never removed, intern the AVPs of trusted peers and look the others up with get()
+template<typename Def>
+void intern(message::avp::AvpList& avps, message::avp::value::IdentityTable& table)
+{
+    namespace dma = message::avp;
+
+    for (auto& avp : avps) {
+        if (Def::matches(avp)) {
+            auto value = get<Def>(avp, table);
+            if (value->entry() == nullptr && dma::value::detail::is_fqdn(value->value())) {
+                value = dma::DiameterIdentity(std::string_view(value->value()), table);
+            }
+            avp.value = std::move(value);
+        }
+    }
+}
+
+// Replaces the value of the first matching AVP of the list or appends the AVP
+template<typename Def>
+message::avp::AVP& set(message::avp::AvpList& avps, typename Def::value_type value)
+{
+    auto it = std::find_if(avps.begin(), avps.end(), Def::matches);
+    if (it == avps.end()) {
+        return avps.emplace_back(Def::make(std::move(value)));
+    }
+    it->flags = Def::flags();
+    it->value = std::move(value);
+    return *it;
+}
+
+} // namespace diameter::serial::avp
+
+#endif
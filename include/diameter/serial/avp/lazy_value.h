@@ -0,0 +1,93 @@
+#ifndef DIAMETER_SERIAL_AVP_LAZY_VALUE_H
+#define DIAMETER_SERIAL_AVP_LAZY_VALUE_H
+
+#include <forward_list>
+#include <utility>
+#include <variant>
+
+#include <diameter/message/avp/avp.h>
+#include <diameter/serial/avp/avp.h>
+
+namespace diameter::serial::avp {
+
+/*
+ * AVP value which is converted to a typed alternative on first access.
+ *
+ * LazyValue keeps the value as it was decoded (normally an OctetString) and converts it with
+ * value_as<T> only when get<T>() is called for the first time. The result is cached, so later
+ * reads of the same type return a reference to the cached value without parsing the bytes again.
+ * Every type read is cached: a reference returned by get() stays valid until reset() or the
+ * destruction of the LazyValue. A conversion which throws leaves the cache as it was. Values
+ * which are never read are never converted.
+ *
+ * The AVP keeps a plain Value, the one which is encoded: a LazyValue wraps the value of a decoded
+ * AVP, e.g. LazyValue(std::move(avp.value)).
+ *
+ * The cache is filled from const accessors, so a LazyValue must not be read concurrently from
+ * several threads without external synchronization.
+ */
+class LazyValue
+{
+public:
+    LazyValue() = default;
+
+    LazyValue(LazyValue const&) = default;
+    LazyValue& operator= (LazyValue const&) = default;
+    LazyValue(LazyValue&&) = default;
+    LazyValue& operator= (LazyValue&&) = default;
+
+    explicit LazyValue(message::avp::Value raw)
+        : m_raw(std::move(raw))
+    {
+    }
+
+    template<typename T>
+    const T& get() const
+    {
+        if (auto* raw = std::get_if<T>(&m_raw)) {
+            return *raw;
+        }
+        if (const auto* cached = find<T>()) {
+            return *cached;
+        }
+        // The nodes of the list are not moved, the references to the other types stay valid
+        return std::get<T>(m_cached.emplace_front(std::in_place_type<T>, value_as<T>(m_raw)));
+    }
+
+    template<typename T>
+    bool is_cached() const noexcept
+    {
+        return find<T>() != nullptr;
+    }
+
+    const message::avp::Value& raw() const noexcept
+    {
+        return m_raw;
+    }
+
+    void reset(message::avp::Value raw)
+    {
+        m_raw = std::move(raw);
+        m_cached.clear();
+    }
+
+private:
+    template<typename T>
+    const T* find() const noexcept
+    {
+        for (const auto& cached : m_cached) {
+            if (const auto* value = std::get_if<T>(&cached)) {
+                return value;
+            }
+        }
+        return nullptr;
+    }
+
+    message::avp::Value m_raw;
+    // One value per type read, a few at most
+    mutable std::forward_list<message::avp::Value> m_cached;
+};
+
+} // namespace diameter::serial::avp
+
+#endif
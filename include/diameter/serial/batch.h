@@ -0,0 +1,209 @@
+#ifndef DIAMETER_SERIAL_BATCH_H
+#define DIAMETER_SERIAL_BATCH_H
+
+#include <cstdint>
+#include <vector>
+
+#include <diameter/message/header/application_id.h>
+#include <diameter/message/header/command_code.h>
+#include <diameter/message/header/hop_by_hop.h>
+#include <diameter/message/span.h>
+#include <diameter/serial/decode_error.h>
+#include <diameter/serial/detail/byte_order.h>
+#include <diameter/serial/view/message.h>
+
+namespace diameter::serial {
+
+/*
+ * Descriptor of one message found by FrameBatch, enough to dispatch it without decoding
+ */
+struct Frame
+{
+    static constexpr uint8_t request_bit = 0x80;
+
+    // The whole message, Message Length bytes
+    message::ByteSpan data;
+    uint8_t command_flags {0};
+    message::header::CommandCode command_code {0};
+    message::header::ApplicationId application_id {0};
+    message::header::HopByHopIdentifier hop_by_hop {0};
+
+    bool is_request() const noexcept
+    {
+        return (command_flags & request_bit) != 0;
+    }
+
+    // Validates the AVPs of the frame, the header is checked by FrameBatch::scan()
+    DecodeResult<view::MessageView> view() const noexcept
+    {
+        const auto header_size = view::MessageView::header_size;
+        const auto* first = data.data();
+        if (auto error = view::check_avps(first + header_size, first + data.size(), header_size)) {
+            return error;
+        }
+        return view::MessageView(data, view::MessageView::checked);
+    }
+};
+
+/*
+ * Splits a buffer of back-to-back messages (e.g. the result of one socket read) into frames.
+ *
+ * scan() works in two passes. The first one only follows the Message Length chain to find the
+ * frames. The second one checks the headers of all found frames at once: version, length and
+ * flags are folded into one flag without branches, so the loop stays tight; only if it reports a
+ * problem the first invalid frame is looked up. AVPs are not checked, Frame::view() does it.
+ *
+ * The batch is meant to be reused: the storage of the frames is kept between the calls.
+ */
+class FrameBatch
+{
+public:
+    static constexpr std::size_t default_max_message_length = 65536;
+
+    explicit FrameBatch(std::size_t max_message_length = default_max_message_length)
+        : m_max_message_length(max_message_length)
+    {
+    }
+
+    FrameBatch(FrameBatch const&) = default;
+    FrameBatch& operator= (FrameBatch const&) = default;
+    FrameBatch(FrameBatch&&) = default;
+    FrameBatch& operator= (FrameBatch&&) = default;
+
+    /*
+     * Finds the complete, valid frames at the start of `data` and returns the number of bytes they
+     * occupy. A trailing incomplete message is left for the next call. Scanning stops at the
+     * first invalid header, which is reported by error() with its offset in `data`.
+     */
+    std::size_t scan(message::ByteSpan data)
+    {
+        m_frames.clear();
+        m_error = DecodeError {};
+
+        const auto* p = data.data();
+        const auto size = data.size();
+        std::size_t offset = 0;
+
+        // Pass 1: the Message Length chain
+        while (size - offset >= view::MessageView::header_size) {
+            std::size_t length = detail::load_u24(p + offset + 1);
+            if (length < view::MessageView::header_size || length > m_max_message_length) {
+                m_error = header_error(p + offset, offset);
+                break;
+            }
+            if (length > size - offset) {
+                break;
+            }
+            m_frames.push_back(Frame {data.subspan(offset, length)});
+            offset += length;
+        }
+
+        // Pass 2: the headers
+        uint32_t invalid = 0;
+        for (auto& frame : m_frames) {
+            const auto* h = frame.data.data();
+            const auto length = frame.data.size();
+            frame.command_flags = h[4];
+            frame.command_code = detail::load_u24(h + 5);
+            frame.application_id = detail::load_u32(h + 8);
+            frame.hop_by_hop = detail::load_u32(h + 12);
+            invalid |= static_cast<uint32_t>(h[0] != message::header::ProtocolVersionV::V01)
+                | static_cast<uint32_t>((length & 3) != 0)
+                | static_cast<uint32_t>((h[4] & error_in_request) == error_in_request);
+        }
+
+        if (invalid != 0) {
+            for (std::size_t i = 0; i < m_frames.size(); ++i) {
+                auto frame_offset = static_cast<std::size_t>(m_frames[i].data.data() - p);
+                if (auto error = header_error(m_frames[i].data.data(), frame_offset)) {
+                    m_error = error;
+                    m_frames.resize(i);
+                    offset = frame_offset;
+                    break;
+                }
+            }
+        }
+
+        m_consumed = offset;
+        return m_consumed;
+    }
+
+    const std::vector<Frame>& frames() const noexcept
+    {
+        return m_frames;
+    }
+
+    std::vector<Frame>::const_iterator begin() const noexcept
+    {
+        return m_frames.begin();
+    }
+
+    std::vector<Frame>::const_iterator end() const noexcept
+    {
+        return m_frames.end();
+    }
+
+    std::size_t size() const noexcept
+    {
+        return m_frames.size();
+    }
+
+    bool empty() const noexcept
+    {
+        return m_frames.empty();
+    }
+
+    const Frame& operator[] (std::size_t i) const noexcept
+    {
+        return m_frames[i];
+    }
+
+    // Bytes occupied by the frames of the last scan
+    std::size_t consumed() const noexcept
+    {
+        return m_consumed;
+    }
+
+    // Invalid header which stopped the last scan, if any; the stream is out of sync after it
+    const DecodeError& error() const noexcept
+    {
+        return m_error;
+    }
+
+    std::size_t max_message_length() const noexcept
+    {
+        return m_max_message_length;
+    }
+
+private:
+    // Request and Error bits, RFC 6733 3: 'E' MUST NOT be set in requests
+    static constexpr uint8_t error_in_request = 0xA0;
+
+    DecodeError header_error(const uint8_t* h, std::size_t offset) const noexcept
+    {
+        std::size_t length = detail::load_u24(h + 1);
+        if (h[0] != message::header::ProtocolVersionV::V01) {
+            return DecodeError {DecodeErrorV::UnsupportedVersion, offset, 0,
+                "Invalid protocol version"};
+        }
+        if (length < view::MessageView::header_size || (length & 3) != 0
+            || length > m_max_message_length) {
+            return DecodeError {DecodeErrorV::InvalidMessageLength, offset + 1, 0,
+                "Invalid message length"};
+        }
+        if ((h[4] & error_in_request) == error_in_request) {
+            return DecodeError {DecodeErrorV::InvalidHeaderBits, offset + 4, 0,
+                "Error bit set in request"};
+        }
+        return DecodeError {};
+    }
+
+    std::size_t m_max_message_length;
+    std::vector<Frame> m_frames;
+    std::size_t m_consumed {0};
+    DecodeError m_error;
+};
+
+} // namespace diameter::serial
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef DIAMETER_SERIAL_DECODE_H
+#define DIAMETER_SERIAL_DECODE_H
+
+#include <memory_resource>
+
+#include <diameter/message/message.h>
+#include <diameter/message/span.h>
+#include <diameter/serial/decode_error.h>
+#include <diameter/serial/view/message.h>
+
+namespace diameter::serial {
+
+/*
+ * Non-throwing decoding of a message.
+ *
+ * The message is checked in place first, so a malformed message is reported without throwing and
+ * without allocating; the error maps to the Result-Code of the answer. Only a well-formed message
+ * is materialized, from the memory resource.
+ */
+inline DecodeResult<message::Message> try_decode(message::ByteSpan data,
+    std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+{
+    auto view = view::MessageView::try_parse(data);
+    if (!view) {
+        return view.error();
+    }
+    return view->to_message(resource);
+}
+
+} // namespace diameter::serial
+
+#endif
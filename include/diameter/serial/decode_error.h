@@ -0,0 +1,194 @@
+#ifndef DIAMETER_SERIAL_DECODE_ERROR_H
+#define DIAMETER_SERIAL_DECODE_ERROR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+#include <netpacker/error.h>
+
+#include <diameter/application/base/result_code.h>
+#include <diameter/message/avp/code.h>
+#include <diameter/serial/error.h>
+
+namespace diameter::serial {
+
+// Default limit of the nesting of Grouped AVPs, the deepest grammars of 3GPP are far below it
+inline constexpr std::size_t max_nesting_depth = 16;
+
+struct DecodeErrorV
+{
+    enum Value : uint8_t
+    {
+        None                  = 0,
+        Truncated             = 1, // The buffer is shorter than the header or the Message Length
+        UnsupportedVersion    = 2,
+        InvalidMessageLength  = 3,
+        InvalidHeaderBits     = 4, // Invalid combination of command flags, 'E' set in a request
+        InvalidAvpLength      = 5,
+        // Grammar of the command, the decoding of serial/record.h
+        MissingAvp            = 6,
+        AvpNotAllowed         = 7,
+        AvpOccursTooManyTimes = 8,
+        // Grouped AVPs nested deeper than the limit of the decoding
+        NestingTooDeep        = 9,
+    };
+};
+
+/*
+ * Failure of the non-throwing decode path.
+ *
+ * `offset` is the position of the offending field from the start of the message: the header
+ * field for header errors, the AVP header for AVP errors, the end of the message for a missing
+ * AVP. `avp_code` is the code of the offending AVP, or 0 if the error is not related to an AVP
+ * (or its code could not be read). `reason` is a static string, nothing is allocated.
+ */
+struct DecodeError
+{
+    DecodeErrorV::Value code {DecodeErrorV::None};
+    std::size_t offset {0};
+    message::avp::Code avp_code {0};
+    const char* reason {""};
+
+    explicit operator bool() const noexcept
+    {
+        return code != DecodeErrorV::None;
+    }
+
+    // RFC 6733 7.1 Result-Code to answer with
+    application::base::ResultCodeV::Value result_code() const noexcept
+    {
+        using application::base::ResultCodeV;
+        switch (code) {
+            case DecodeErrorV::None:
+                return ResultCodeV::Success;
+            case DecodeErrorV::UnsupportedVersion:
+                return ResultCodeV::UnsupportedVersion;
+            case DecodeErrorV::InvalidHeaderBits:
+                return ResultCodeV::InvalidHdrBits;
+            case DecodeErrorV::InvalidAvpLength:
+                return ResultCodeV::InvalidAvpLength;
+            case DecodeErrorV::MissingAvp:
+                return ResultCodeV::MissingAvp;
+            case DecodeErrorV::AvpNotAllowed:
+                return ResultCodeV::AvpNotAllowed;
+            case DecodeErrorV::AvpOccursTooManyTimes:
+                return ResultCodeV::AvpOccursTooManyTimes;
+            case DecodeErrorV::NestingTooDeep:
+                return ResultCodeV::InvalidAvpValue;
+            case DecodeErrorV::Truncated:
+            case DecodeErrorV::InvalidMessageLength:
+            default:
+                return ResultCodeV::InvalidMessageLength;
+        }
+    }
+};
+
+// Throws the exception of the throwing decode path which corresponds to the error
+[[noreturn]] inline void throw_decode_error(const DecodeError& error)
+{
+    switch (error.code) {
+        case DecodeErrorV::UnsupportedVersion:
+            throw InvalidProtocolVersion();
+        case DecodeErrorV::InvalidMessageLength:
+            throw InvalidMessageLength();
+        case DecodeErrorV::InvalidHeaderBits:
+            throw InvalidHeaderBits();
+        case DecodeErrorV::InvalidAvpLength:
+            throw InvalidAvpLength(error.reason);
+        case DecodeErrorV::MissingAvp:
+        case DecodeErrorV::AvpNotAllowed:
+        case DecodeErrorV::AvpOccursTooManyTimes:
+            throw InvalidAvpOccurrence(error.reason);
+        case DecodeErrorV::NestingTooDeep:
+            throw InvalidAvpNesting();
+        case DecodeErrorV::None:
+        case DecodeErrorV::Truncated:
+        default:
+            throw netpacker::EndOfBuffer();
+    }
+}
+
+/*
+ * Either a decoded value or the DecodeError which prevented decoding it
+ */
+template<typename T>
+class DecodeResult
+{
+public:
+    using value_type = T;
+
+    DecodeResult(T value)
+        : m_value(std::move(value))
+    {
+    }
+
+    DecodeResult(DecodeError error) noexcept
+        : m_error(error)
+    {
+    }
+
+    DecodeResult(DecodeResult const&) = default;
+    DecodeResult& operator= (DecodeResult const&) = default;
+    DecodeResult(DecodeResult&&) = default;
+    DecodeResult& operator= (DecodeResult&&) = default;
+
+    bool has_value() const noexcept
+    {
+        return m_value.has_value();
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return has_value();
+    }
+
+    T& value() & noexcept
+    {
+        return *m_value;
+    }
+
+    const T& value() const& noexcept
+    {
+        return *m_value;
+    }
+
+    T&& value() && noexcept
+    {
+        return std::move(*m_value);
+    }
+
+    T& operator* () noexcept
+    {
+        return *m_value;
+    }
+
+    const T& operator* () const noexcept
+    {
+        return *m_value;
+    }
+
+    T* operator->() noexcept
+    {
+        return &*m_value;
+    }
+
+    const T* operator->() const noexcept
+    {
+        return &*m_value;
+    }
+
+    const DecodeError& error() const noexcept
+    {
+        return m_error;
+    }
+
+private:
+    std::optional<T> m_value;
+    DecodeError m_error;
+};
+
+} // namespace diameter::serial
+
+#endif
@@ -0,0 +1,51 @@
+#ifndef DIAMETER_SERIAL_DETAIL_BYTE_ORDER_H
+#define DIAMETER_SERIAL_DETAIL_BYTE_ORDER_H
+
+#include <cstdint>
+
+// Unchecked big-endian (network byte order) access to raw buffers. Callers are responsible for
+// bounds checking; these helpers are used on the paths which work with contiguous memory directly.
+
+namespace diameter::serial::detail {
+
+inline uint32_t load_u24(const uint8_t* p) noexcept
+{
+    return (static_cast<uint32_t>(p[0]) << 16) | (static_cast<uint32_t>(p[1]) << 8)
+        | static_cast<uint32_t>(p[2]);
+}
+
+inline uint32_t load_u32(const uint8_t* p) noexcept
+{
+    return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16)
+        | (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+}
+
+inline uint64_t load_u64(const uint8_t* p) noexcept
+{
+    return (static_cast<uint64_t>(load_u32(p)) << 32) | static_cast<uint64_t>(load_u32(p + 4));
+}
+
+inline void store_u24(uint8_t* p, uint32_t value) noexcept
+{
+    p[0] = static_cast<uint8_t>(value >> 16);
+    p[1] = static_cast<uint8_t>(value >> 8);
+    p[2] = static_cast<uint8_t>(value);
+}
+
+inline void store_u32(uint8_t* p, uint32_t value) noexcept
+{
+    p[0] = static_cast<uint8_t>(value >> 24);
+    p[1] = static_cast<uint8_t>(value >> 16);
+    p[2] = static_cast<uint8_t>(value >> 8);
+    p[3] = static_cast<uint8_t>(value);
+}
+
+inline void store_u64(uint8_t* p, uint64_t value) noexcept
+{
+    store_u32(p, static_cast<uint32_t>(value >> 32));
+    store_u32(p + 4, static_cast<uint32_t>(value));
+}
+
+} // namespace diameter::serial::detail
+
+#endif
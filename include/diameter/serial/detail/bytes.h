@@ -0,0 +1,41 @@
+#ifndef DIAMETER_SERIAL_DETAIL_BYTES_H
+#define DIAMETER_SERIAL_DETAIL_BYTES_H
+
+#include <cstdint>
+#include <iterator>
+
+#include <netpacker/error.h>
+
+// Bounds checked copying of octet sequences between buffers and containers. Unlike the netpacker
+// container overloads these work with any container of octets or characters, including the
+// allocator-aware ones of the message model: the target container keeps its own allocator.
+
+namespace diameter::serial::detail {
+
+template<typename Container, typename InputIt>
+void get_bytes(InputIt& possition, InputIt last, std::size_t len, Container& value)
+{
+    if (static_cast<std::size_t>(std::distance(possition, last)) < len) {
+        throw netpacker::EndOfBuffer();
+    }
+    auto end = std::next(possition, static_cast<std::ptrdiff_t>(len));
+    value.insert(value.end(), possition, end);
+    possition = end;
+}
+
+template<typename OutputIt, typename Container>
+OutputIt put_bytes(OutputIt possition, OutputIt last, const Container& value)
+{
+    if (static_cast<std::size_t>(std::distance(possition, last)) < value.size()) {
+        throw netpacker::BufferOverflow();
+    }
+    for (auto octet : value) {
+        *possition = static_cast<uint8_t>(octet);
+        ++possition;
+    }
+    return possition;
+}
+
+} // namespace diameter::serial::detail
+
+#endif
@@ -0,0 +1,251 @@
+#ifndef DIAMETER_SERIAL_DICTIONARY_H
+#define DIAMETER_SERIAL_DICTIONARY_H
+
+#include <cstdint>
+#include <cstring>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <type_traits>
+
+#include <diameter/dictionary/dictionary.h>
+#include <diameter/message/message.h>
+#include <diameter/message/span.h>
+#include <diameter/serial/decode_error.h>
+#include <diameter/serial/detail/byte_order.h>
+#include <diameter/serial/view/avp.h>
+#include <diameter/serial/view/message.h>
+
+// Dictionary-aware decoding: the value of every AVP known to the dictionary is decoded straight
+// into the alternative of its type, Grouped values are expanded recursively, so the message needs
+// no value_as<T> pass. AVPs which are not in the dictionary keep an OctetString value. The
+// dictionary is a dictionary::Dictionary loaded at runtime or a generated one (tools/dictgen),
+// whose lookup is a switch inlined into the decoding loop.
+
+namespace diameter::serial {
+
+/*
+ * The value of the type decoded from the data field of an AVP, std::nullopt if the size of the
+ * data does not fit the type. Not for Grouped values, see decode_avps().
+ */
+inline std::optional<message::avp::Value> decode_value(dictionary::AvpTypeV::Value type,
+    message::ByteSpan data, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+{
+    namespace dma = message::avp;
+    using dictionary::AvpTypeV;
+
+    const auto* p = data.data();
+    auto size = data.size();
+    auto text = [&] {
+        return std::string(reinterpret_cast<const char*>(p), size);
+    };
+    switch (type) {
+        case AvpTypeV::Integer32:
+            if (size == 4) {
+                return dma::Value(dma::Integer32(static_cast<int32_t>(detail::load_u32(p))));
+            }
+            break;
+        case AvpTypeV::Integer64:
+            if (size == 8) {
+                return dma::Value(dma::Integer64(static_cast<int64_t>(detail::load_u64(p))));
+            }
+            break;
+        case AvpTypeV::Unsigned32:
+            if (size == 4) {
+                return dma::Value(dma::Unsigned32(detail::load_u32(p)));
+            }
+            break;
+        case AvpTypeV::Unsigned64:
+            if (size == 8) {
+                return dma::Value(dma::Unsigned64(detail::load_u64(p)));
+            }
+            break;
+        case AvpTypeV::Float32:
+            if (size == 4) {
+                auto bits = detail::load_u32(p);
+                float value;
+                std::memcpy(&value, &bits, sizeof(value));
+                return dma::Value(dma::Float32(value));
+            }
+            break;
+        case AvpTypeV::Float64:
+            if (size == 8) {
+                auto bits = detail::load_u64(p);
+                double value;
+                std::memcpy(&value, &bits, sizeof(value));
+                return dma::Value(dma::Float64(value));
+            }
+            break;
+        case AvpTypeV::Address:
+            if (size >= 2) {
+                auto family = static_cast<uint16_t>(p[0] << 8 | p[1]);
+                return dma::Value(dma::Address(family, message::ByteSpan(p + 2, size - 2),
+                    resource));
+            }
+            break;
+        case AvpTypeV::Time:
+            if (size == 4) {
+                return dma::Value(dma::Time(detail::load_u32(p)));
+            }
+            break;
+        case AvpTypeV::UTF8String:
+            return dma::Value(dma::UTF8String(
+                dma::UTF8String::value_type(reinterpret_cast<const char*>(p), size, resource)));
+        case AvpTypeV::DiameterIdentity:
+            return dma::Value(dma::DiameterIdentity(text()));
+        case AvpTypeV::DiameterURI:
+            return dma::Value(dma::DiameterURI(text()));
+        case AvpTypeV::Enumerated:
+            if (size == 4) {
+                return dma::Value(dma::Enumerated(static_cast<int32_t>(detail::load_u32(p))));
+            }
+            break;
+        case AvpTypeV::IPFilterRule:
+            return dma::Value(dma::IPFilterRule(text()));
+        case AvpTypeV::OctetString:
+        case AvpTypeV::Grouped:
+        default:
+            return dma::Value(dma::OctetString(
+                dma::OctetString::value_type(data.begin(), data.end(), resource)));
+    }
+    return std::nullopt;
+}
+
+/*
+ * Predicate of the AVPs which are Grouped in the dictionary, for the decoding which builds an
+ * AvpIndex, see netpacker::get<Message>(possition, last, index, is_grouped). The dictionary must
+ * outlive the predicate.
+ */
+template<typename Dictionary>
+auto grouped_avps(const Dictionary& dictionary) noexcept
+{
+    static_assert(dictionary::is_dictionary_v<Dictionary>, "grouped_avps: not a dictionary");
+
+    return [&dictionary](message::avp::Code code, std::optional<message::avp::VendorId> vendor_id) {
+        const auto* definition = dictionary.find(code, vendor_id.value_or(0));
+        return definition != nullptr && definition->type == dictionary::AvpTypeV::Grouped;
+    };
+}
+
+namespace detail {
+
+/*
+ * decode_avps() of a range whose AVP headers are `checked` already, e.g. by MessageView. The
+ * header of every AVP of a nested range is checked as it is decoded, the data is walked once.
+ * `depth` is the number of Grouped levels which may still be expanded.
+ */
+template<typename Dictionary>
+DecodeError decode_avps(const Dictionary& dictionary, const uint8_t* first, const uint8_t* last,
+    std::size_t offset, message::avp::AvpList& avps, std::size_t depth, bool checked)
+{
+    namespace dma = message::avp;
+    using dictionary::AvpTypeV;
+
+    auto* resource = avps.get_allocator().resource();
+    for (const auto* p = first; p != last;) {
+        auto avp_offset = offset + static_cast<std::size_t>(p - first);
+        if (!checked) {
+            if (auto error = view::check_avp(p, last, avp_offset)) {
+                return error;
+            }
+        }
+        view::AvpView view(p);
+        p += view.size();
+
+        // Constructed with the value, assigning it would copy it to the default resource
+        auto make = [&](dma::Value value) {
+            avps.emplace_back(dma::AVP {view.code(), view.flags(), view.vendor_id(),
+                std::move(value)});
+        };
+        const auto* definition = dictionary.find(view.code(), view.vendor_id().value_or(0));
+        auto data = view.data();
+        if (definition == nullptr) {
+            make(dma::OctetString(
+                dma::OctetString::value_type(data.begin(), data.end(), resource)));
+            continue;
+        }
+        if (definition->type == AvpTypeV::Grouped) {
+            if (depth == 0) {
+                return DecodeError {DecodeErrorV::NestingTooDeep, avp_offset, view.code(),
+                    "Invalid avp: grouped avps nested too deep"};
+            }
+            auto nested = dma::AvpList(resource);
+            auto data_offset = avp_offset + (view.size() - view.padding() - data.size());
+            if (auto error = decode_avps(dictionary, data.data(), data.data() + data.size(),
+                    data_offset, nested, depth - 1, false)) {
+                return error;
+            }
+            make(dma::Grouped(std::move(nested)));
+            continue;
+        }
+        auto value = decode_value(definition->type, data, resource);
+        if (!value) {
+            return DecodeError {DecodeErrorV::InvalidAvpLength, avp_offset, view.code(),
+                "Invalid avp length: the value does not fit the type"};
+        }
+        make(std::move(*value));
+    }
+    return DecodeError {};
+}
+
+} // namespace detail
+
+/*
+ * Decodes the AVPs of [first, last) into `avps`, typed by the dictionary. `offset` is the position
+ * of `first` in the message, for the errors. A value whose size does not fit its type, or a
+ * Grouped value which is not a well-formed list of AVPs, is reported as InvalidAvpLength
+ * (RFC 6733 7.1.5, DIAMETER_INVALID_AVP_LENGTH) with the offset of the offending AVP, nested
+ * AVPs included. Grouped AVPs nested deeper than `max_depth` levels are reported as
+ * NestingTooDeep, the recursion is bounded whatever the message.
+ */
+template<typename Dictionary>
+DecodeError decode_avps(const Dictionary& dictionary, const uint8_t* first, const uint8_t* last,
+    std::size_t offset, message::avp::AvpList& avps, std::size_t max_depth = max_nesting_depth)
+{
+    static_assert(dictionary::is_dictionary_v<Dictionary>, "decode_avps: not a dictionary");
+
+    return detail::decode_avps(dictionary, first, last, offset, avps, max_depth, false);
+}
+
+/*
+ * Non-throwing decoding of a message with typed values, see try_decode(ByteSpan, resource).
+ * `max_depth` limits the nesting of Grouped AVPs, see decode_avps().
+ */
+template<typename Dictionary,
+    typename = std::enable_if_t<dictionary::is_dictionary_v<Dictionary>>>
+DecodeResult<message::Message> try_decode(message::ByteSpan data, const Dictionary& dictionary,
+    std::pmr::memory_resource* resource = std::pmr::get_default_resource(),
+    std::size_t max_depth = max_nesting_depth)
+{
+    auto view = view::MessageView::try_parse(data);
+    if (!view) {
+        return view.error();
+    }
+    message::Message msg {view->header(), message::avp::AvpList(resource)};
+    const auto* avps = view->avps().data().data();
+    auto size = view->avps().data().size();
+    // The AVPs of the message are checked by try_parse()
+    if (auto error = detail::decode_avps(dictionary, avps, avps + size,
+            view::MessageView::header_size, msg.avps, max_depth, true)) {
+        return error;
+    }
+    return msg;
+}
+
+// Decodes the message with typed values, throws the exceptions of the throwing decode path
+template<typename Dictionary,
+    typename = std::enable_if_t<dictionary::is_dictionary_v<Dictionary>>>
+message::Message decode(message::ByteSpan data, const Dictionary& dictionary,
+    std::pmr::memory_resource* resource = std::pmr::get_default_resource(),
+    std::size_t max_depth = max_nesting_depth)
+{
+    auto result = try_decode(data, dictionary, resource, max_depth);
+    if (!result) {
+        throw_decode_error(result.error());
+    }
+    return std::move(*result);
+}
+
+} // namespace diameter::serial
+
+#endif
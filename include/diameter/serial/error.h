@@ -2,7 +2,6 @@
 #define DIAMETER_SERIAL_ERROR_H
 
 #include <exception>
-#include <string>
 
 namespace diameter::serial {
 
@@ -37,19 +36,59 @@ public:
     }
 };
 
+class InvalidHeaderBits : public Exception
+{
+public:
+    InvalidHeaderBits() noexcept = default;
+
+    const char* what() const noexcept override
+    {
+        return "Invalid header bits";
+    }
+};
+
 class InvalidAvpLength : public Exception
 {
 public:
-    explicit InvalidAvpLength(const std::string& message)
+    // The message is not copied, it must have static storage duration
+    explicit InvalidAvpLength(const char* message) noexcept
         : what_message(message) {};
 
     const char* what() const noexcept override
     {
-        return what_message.c_str();
+        return what_message;
     }
 
 private:
-    std::string what_message;
+    const char* what_message;
+};
+
+// An AVP missing, not allowed or repeated against the grammar of the command
+class InvalidAvpOccurrence : public Exception
+{
+public:
+    // The message is not copied, it must have static storage duration
+    explicit InvalidAvpOccurrence(const char* message) noexcept
+        : what_message(message) {};
+
+    const char* what() const noexcept override
+    {
+        return what_message;
+    }
+
+private:
+    const char* what_message;
+};
+
+class InvalidAvpNesting : public Exception
+{
+public:
+    InvalidAvpNesting() noexcept = default;
+
+    const char* what() const noexcept override
+    {
+        return "Invalid avp: grouped avps nested too deep";
+    }
 };
 
 class InvalidAvpVendorId : public Exception
@@ -66,16 +105,17 @@ public:
 class InvalidAvpValueCast : public Exception
 {
 public:
-    explicit InvalidAvpValueCast(const std::string& message)
+    // The message is not copied, it must have static storage duration
+    explicit InvalidAvpValueCast(const char* message) noexcept
         : what_message(message) {};
 
     const char* what() const noexcept override
     {
-        return what_message.c_str();
+        return what_message;
     }
 
 private:
-    std::string what_message;
+    const char* what_message;
 };
 
 } // namespace diameter::serial
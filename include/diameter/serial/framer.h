@@ -0,0 +1,191 @@
+#ifndef DIAMETER_SERIAL_FRAMER_H
+#define DIAMETER_SERIAL_FRAMER_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include <diameter/message/header/header.h>
+#include <diameter/message/span.h>
+#include <diameter/serial/detail/byte_order.h>
+#include <diameter/serial/error.h>
+#include <diameter/serial/view/message.h>
+
+namespace diameter::serial {
+
+/*
+ * Incremental framer which cuts a stream of bytes (e.g. TCP) into Diameter messages.
+ *
+ * The framer owns a fixed size buffer. Bytes are appended either by reading from a socket straight
+ * into the writable area returned by prepare() and calling commit(), or by copying a chunk with
+ * feed(). Complete messages are returned by next() as views into the buffer.
+ *
+ * The buffer works as a ring with contiguous frames: when all buffered bytes are consumed the
+ * cursors return to the start of the buffer, so nothing is moved in the common case. Only when the
+ * tail of the buffer is too small for the rest of a partially received message, the partial
+ * message is moved to the front.
+ *
+ * Version and Message Length are checked as soon as the first four bytes of a header arrive,
+ * lengths below the header size or above max_message_length() are rejected with
+ * InvalidMessageLength. After an exception the stream is out of sync and the framer must be reset
+ * (normally the connection is closed).
+ *
+ * Views returned by next() stay valid until the following call to prepare(), feed() or reset().
+ */
+class Framer
+{
+public:
+    static constexpr std::size_t default_max_message_length = 65536;
+
+    explicit Framer(std::size_t max_message_length = default_max_message_length,
+        std::size_t capacity = 0)
+        : m_max_message_length(max_message_length),
+          m_buffer(std::max(capacity, max_message_length))
+    {
+        if (m_max_message_length < header_size) {
+            throw std::invalid_argument("Framer: max message length is less than header size");
+        }
+    }
+
+    Framer(Framer const&) = delete;
+    Framer& operator= (Framer const&) = delete;
+    Framer(Framer&&) = default;
+    Framer& operator= (Framer&&) = default;
+
+    // Writable area at the end of the buffered data, empty if the buffer is full
+    message::Span<uint8_t> prepare()
+    {
+        if (m_buffer.size() - m_write < required()) {
+            compact();
+        }
+        return message::Span<uint8_t>(m_buffer.data() + m_write, m_buffer.size() - m_write);
+    }
+
+    // Marks `size` bytes of the area returned by prepare() as received
+    void commit(std::size_t size)
+    {
+        if (size > m_buffer.size() - m_write) {
+            throw std::out_of_range("Framer: commit beyond the prepared area");
+        }
+        m_write += size;
+    }
+
+    // Copies as much of `chunk` as fits into the buffer, returns the number of copied bytes
+    std::size_t feed(message::ByteSpan chunk)
+    {
+        auto area = prepare();
+        auto size = std::min(area.size(), chunk.size());
+        if (size != 0) {
+            std::memcpy(area.data(), chunk.data(), size);
+            commit(size);
+        }
+        return size;
+    }
+
+    // Next complete message, or nullopt if more bytes are needed
+    std::optional<message::ByteSpan> next()
+    {
+        auto length = pending_length();
+        if (!length.has_value() || m_write - m_read < *length) {
+            return std::nullopt;
+        }
+
+        auto frame = message::ByteSpan(m_buffer.data() + m_read, *length);
+        consume(*length);
+        return frame;
+    }
+
+    // Number of received bytes which are not returned by next() yet
+    std::size_t buffered() const noexcept
+    {
+        return m_write - m_read;
+    }
+
+    // Received bytes which are not returned by next() yet, e.g. for FrameBatch::scan()
+    message::ByteSpan pending() const noexcept
+    {
+        return message::ByteSpan(m_buffer.data() + m_read, m_write - m_read);
+    }
+
+    // Drops `size` bytes of pending() which are processed elsewhere
+    void consume(std::size_t size)
+    {
+        if (size > m_write - m_read) {
+            throw std::out_of_range("Framer: consume beyond the buffered data");
+        }
+        m_read += size;
+        if (m_read == m_write) {
+            m_read = 0;
+            m_write = 0;
+        }
+    }
+
+    std::size_t capacity() const noexcept
+    {
+        return m_buffer.size();
+    }
+
+    std::size_t max_message_length() const noexcept
+    {
+        return m_max_message_length;
+    }
+
+    void reset() noexcept
+    {
+        m_read = 0;
+        m_write = 0;
+    }
+
+private:
+    static constexpr std::size_t header_size = view::MessageView::header_size;
+    // Version and Message Length
+    static constexpr std::size_t length_prefix_size = 4;
+
+    // Message Length of the first buffered message, if its prefix is received
+    std::optional<std::size_t> pending_length() const
+    {
+        if (m_write - m_read < length_prefix_size) {
+            return std::nullopt;
+        }
+        const auto* p = m_buffer.data() + m_read;
+        if (p[0] != message::header::ProtocolVersionV::V01) {
+            throw InvalidProtocolVersion();
+        }
+        std::size_t length = detail::load_u24(p + 1);
+        if (length < header_size || length > m_max_message_length) {
+            throw InvalidMessageLength();
+        }
+        return length;
+    }
+
+    // Space needed after the write cursor to complete the first buffered message
+    std::size_t required() const
+    {
+        auto length = pending_length();
+        auto total = length.has_value() ? *length : header_size;
+        auto buffered = m_write - m_read;
+        return total > buffered ? total - buffered : 1;
+    }
+
+    void compact() noexcept
+    {
+        auto buffered = m_write - m_read;
+        if (m_read != 0 && buffered != 0) {
+            std::memmove(m_buffer.data(), m_buffer.data() + m_read, buffered);
+        }
+        m_read = 0;
+        m_write = buffered;
+    }
+
+    std::size_t m_max_message_length;
+    std::vector<uint8_t> m_buffer;
+    std::size_t m_read {0};
+    std::size_t m_write {0};
+};
+
+} // namespace diameter::serial
+
+#endif
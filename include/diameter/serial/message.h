@@ -1,9 +1,55 @@
 #ifndef DIAMETER_SERIAL_MESSAGE_H
 #define DIAMETER_SERIAL_MESSAGE_H
 
+#include <iterator>
+#include <memory_resource>
+#include <optional>
+
 #include <netpacker/netpacker.h>
 
+#include <diameter/message/avp_index.h>
+#include <diameter/message/header/message_length.h>
 #include <diameter/message/type_traits.h>
+#include <diameter/serial/avp/avp.h>
+#include <diameter/serial/decode_error.h>
+#include <diameter/serial/error.h>
+#include <diameter/serial/view/message.h>
+
+namespace diameter::serial::detail {
+
+// The AVP with a Grouped value decoded from the wire if `is_grouped(code, vendor_id)`, a raw value
+// otherwise. The nested AVPs are allocated from the memory resource
+template<typename InputIt, typename IsGrouped>
+message::avp::AVP get_avp(InputIt& possition, InputIt last, const IsGrouped& is_grouped,
+    std::pmr::memory_resource* resource, std::size_t depth)
+{
+    namespace dma = message::avp;
+
+    auto header = get_avp_header(possition, last);
+    auto length = static_cast<typename std::iterator_traits<InputIt>::difference_type>(
+        header.data_length);
+    if (!is_grouped(header.code, header.vendor_id)) {
+        auto value = netpacker::get<dma::Value>(possition, last, length, resource);
+        possition = netpacker::skipbytes(possition, last, header.padding);
+        return dma::AVP {header.code, header.flags, header.vendor_id, std::move(value)};
+    }
+
+    if (depth == 0) {
+        throw InvalidAvpNesting();
+    }
+    if (std::distance(possition, last) < length) {
+        throw netpacker::EndOfBuffer();
+    }
+    auto data_last = std::next(possition, length);
+    auto nested = dma::AvpList(resource);
+    while (possition != data_last) {
+        nested.emplace_back(get_avp(possition, data_last, is_grouped, resource, depth - 1));
+    }
+    possition = netpacker::skipbytes(possition, last, header.padding);
+    return dma::AVP {header.code, header.flags, header.vendor_id, dma::Grouped(std::move(nested))};
+}
+
+} // namespace diameter::serial::detail
 
 namespace netpacker {
 
@@ -16,25 +62,80 @@ OutputIt put(OutputIt possition, OutputIt last, const T& value)
     for (const auto& avp : value.avps) {
         pos = put(pos, last, avp);
     }
+
+    // Message Length follows the one byte Version
+    auto length = static_cast<diameter::message::header::MessageLength>(
+        std::distance(possition, pos));
+    put(std::next(possition), last, length, 3);
     return pos;
 }
 
+// The AVP list and the values are allocated from the memory resource, e.g. a per-request
+// std::pmr::monotonic_buffer_resource
 template <typename T,
           typename InputIt,
           diameter::message::is_diameter_message<T>* dummy = nullptr>
-T get(InputIt& possition, InputIt last)
+T get(InputIt& possition, InputIt last, std::pmr::memory_resource* resource)
 {
-    T value;
-    value.header = get<decltype(value.header)>(possition, last);
+    T value {get<decltype(T::header)>(possition, last), decltype(T::avps)(resource)};
 
     auto alen = value.header.length;
     // TODO: What to do if length low than possition-last ?
-    while (alen > 20) {
-        auto avp = get<diameter::message::avp::AVP>(possition, last);
+    while (alen > diameter::serial::view::MessageView::header_size) {
+        auto avp = get<diameter::message::avp::AVP>(possition, last, resource);
         alen -= avp.size();
-        value.avps.emplace_back(avp);
+        value.avps.emplace_back(std::move(avp));
+    }
+
+    return value;
+}
+
+template <typename T,
+          typename InputIt,
+          diameter::message::is_diameter_message<T>* dummy = nullptr>
+T get(InputIt& possition, InputIt last)
+{
+    return get<T>(possition, last, std::pmr::get_default_resource());
+}
+
+// Decodes the message and builds the lookup index of its AVPs. The values stay raw, except the
+// ones of the AVPs for which `is_grouped(code, vendor_id)` is true: they are decoded as Grouped
+// straight from the wire, into the memory resource, so their AVPs are indexed as nested. See
+// serial::grouped_avps() for the predicate of a dictionary. Throws InvalidAvpNesting past
+// serial::max_nesting_depth levels
+template <typename T,
+          typename InputIt,
+          typename IsGrouped,
+          diameter::message::is_diameter_message<T>* dummy = nullptr>
+T get(InputIt& possition, InputIt last, diameter::message::AvpIndex& index,
+    const IsGrouped& is_grouped,
+    std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+{
+    namespace ds = diameter::serial;
+
+    T value {get<decltype(T::header)>(possition, last), decltype(T::avps)(resource)};
+    auto length = static_cast<std::ptrdiff_t>(value.header.length)
+        - static_cast<std::ptrdiff_t>(ds::view::MessageView::header_size);
+    if (length < 0 || std::distance(possition, last) < length) {
+        throw netpacker::EndOfBuffer();
+    }
+    auto avps_last = std::next(possition, length);
+    while (possition != avps_last) {
+        value.avps.emplace_back(ds::detail::get_avp(possition, avps_last, is_grouped, resource,
+            ds::max_nesting_depth));
     }
+    index.build(value.avps);
+    return value;
+}
 
+// Decodes the message and builds the lookup index of its top level AVPs, the values stay raw
+template <typename T,
+          typename InputIt,
+          diameter::message::is_diameter_message<T>* dummy = nullptr>
+T get(InputIt& possition, InputIt last, diameter::message::AvpIndex& index)
+{
+    auto value = get<T>(possition, last);
+    index.build(value.avps);
     return value;
 }
 
@@ -0,0 +1,322 @@
+#ifndef DIAMETER_SERIAL_MESSAGE_TEMPLATE_H
+#define DIAMETER_SERIAL_MESSAGE_TEMPLATE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+#include <netpacker/netpacker.h>
+
+#include <diameter/message/avp/avp.h>
+#include <diameter/message/header/end_to_end.h>
+#include <diameter/message/header/hop_by_hop.h>
+#include <diameter/message/message.h>
+#include <diameter/message/span.h>
+#include <diameter/serial/avp/avp.h>
+#include <diameter/serial/detail/byte_order.h>
+#include <diameter/serial/header/header.h>
+#include <diameter/serial/message.h>
+#include <diameter/serial/view/message.h>
+
+namespace diameter::serial {
+
+class MessageTemplate;
+
+/*
+ * Encoded message produced by MessageTemplate::instantiate(), with the variable fields of the
+ * template patched in place.
+ *
+ * A value of a different length moves the bytes which follow it and fixes up the Message Length
+ * and the AVP Length of the AVP and of every enclosing Grouped AVP, padding included.
+ */
+class TemplateInstance
+{
+public:
+    using Field = std::size_t;
+
+    TemplateInstance() = default;
+
+    TemplateInstance(TemplateInstance const&) = default;
+    TemplateInstance& operator= (TemplateInstance const&) = default;
+    TemplateInstance(TemplateInstance&&) = default;
+    TemplateInstance& operator= (TemplateInstance&&) = default;
+
+    TemplateInstance& hop_by_hop(message::header::HopByHopIdentifier value)
+    {
+        detail::store_u32(header() + 12, value);
+        return *this;
+    }
+
+    TemplateInstance& end_to_end(message::header::EndToEndIdentifier value)
+    {
+        detail::store_u32(header() + 16, value);
+        return *this;
+    }
+
+    // Unsigned32, Integer32 (as two's complement), Enumerated, Time
+    TemplateInstance& set(Field field, uint32_t value)
+    {
+        detail::store_u32(fixed(field, sizeof(value)), value);
+        return *this;
+    }
+
+    // Unsigned64, Integer64 (as two's complement)
+    TemplateInstance& set(Field field, uint64_t value)
+    {
+        detail::store_u64(fixed(field, sizeof(value)), value);
+        return *this;
+    }
+
+    // Integer32, Enumerated; a plain int literal is taken as a 32-bit value
+    TemplateInstance& set(Field field, int32_t value)
+    {
+        return set(field, static_cast<uint32_t>(value));
+    }
+
+    // Integer64
+    TemplateInstance& set(Field field, int64_t value)
+    {
+        return set(field, static_cast<uint64_t>(value));
+    }
+
+    // OctetString, UTF8String, DiameterIdentity...
+    TemplateInstance& set(Field field, message::ByteSpan value)
+    {
+        resize(field, value.size());
+        if (!value.empty()) {
+            std::memcpy(m_data.data() + m_avps[field].begin + m_avps[field].header_length,
+                value.data(), value.size());
+        }
+        return *this;
+    }
+
+    TemplateInstance& set(Field field, std::string_view value)
+    {
+        return set(field,
+            message::ByteSpan(reinterpret_cast<const uint8_t*>(value.data()), value.size()));
+    }
+
+    message::ByteSpan data() const noexcept
+    {
+        return message::ByteSpan(m_data.data(), m_data.size());
+    }
+
+    std::size_t size() const noexcept
+    {
+        return m_data.size();
+    }
+
+private:
+    friend class MessageTemplate;
+
+    // Encoded AVP: [begin, end) with the padding, the header is `header_length` bytes
+    struct Avp
+    {
+        std::size_t begin;
+        std::size_t end;
+        uint32_t header_length;
+        bool grouped;
+    };
+
+    // A default constructed instance has no message until MessageTemplate::instantiate()
+    uint8_t* header()
+    {
+        if (m_data.size() < view::MessageView::header_size) {
+            throw std::invalid_argument("TemplateInstance: no message instantiated");
+        }
+        return m_data.data();
+    }
+
+    uint8_t* fixed(Field field, std::size_t size)
+    {
+        const auto& avp = m_avps.at(field);
+        if (avp.grouped || value_length(avp) != size) {
+            throw std::invalid_argument("TemplateInstance: value size does not match the field");
+        }
+        return m_data.data() + avp.begin + avp.header_length;
+    }
+
+    std::size_t value_length(const Avp& avp) const noexcept
+    {
+        return detail::load_u24(m_data.data() + avp.begin + 5) - avp.header_length;
+    }
+
+    // Makes room for a value of `size` bytes and zeroes the new padding
+    void resize(Field field, std::size_t size)
+    {
+        const auto target = m_avps.at(field);
+        if (target.grouped) {
+            throw std::invalid_argument("TemplateInstance: Grouped AVP can not be set");
+        }
+        using message::avp::AVP;
+        using message::avp::Length;
+        auto old_length = static_cast<Length>(target.header_length + value_length(target));
+        auto new_length = static_cast<Length>(target.header_length + size);
+        auto old_size = static_cast<std::ptrdiff_t>(old_length + AVP::padding(old_length));
+        auto new_size = static_cast<std::ptrdiff_t>(new_length + AVP::padding(new_length));
+        auto delta = new_size - old_size;
+
+        auto at = m_data.begin() + static_cast<std::ptrdiff_t>(target.begin) + old_size;
+        if (delta > 0) {
+            m_data.insert(at, static_cast<std::size_t>(delta), uint8_t {0});
+        }
+        else if (delta < 0) {
+            m_data.erase(at + delta, at);
+        }
+
+        for (auto& avp : m_avps) {
+            if (avp.begin > target.begin) {
+                avp.begin = shift(avp.begin, delta);
+                avp.end = shift(avp.end, delta);
+            }
+            else if (avp.end > target.begin) {
+                // The AVP itself or an enclosing Grouped AVP
+                avp.end = shift(avp.end, delta);
+                if (avp.begin != target.begin) {
+                    add_u24(avp.begin + 5, delta);
+                }
+            }
+        }
+        add_u24(1, delta);
+        detail::store_u24(m_data.data() + target.begin + 5, new_length);
+
+        // Padding of the new value
+        auto value_end = m_data.begin() + static_cast<std::ptrdiff_t>(target.begin + new_length);
+        std::fill(value_end, value_end + (new_size - new_length), uint8_t {0});
+    }
+
+    static std::size_t shift(std::size_t offset, std::ptrdiff_t delta) noexcept
+    {
+        return static_cast<std::size_t>(static_cast<std::ptrdiff_t>(offset) + delta);
+    }
+
+    void add_u24(std::size_t offset, std::ptrdiff_t delta) noexcept
+    {
+        auto* p = m_data.data() + offset;
+        detail::store_u24(p, static_cast<uint32_t>(shift(detail::load_u24(p), delta)));
+    }
+
+    std::vector<uint8_t> m_data;
+    std::vector<Avp> m_avps;
+};
+
+/*
+ * Message encoded once, to produce messages which differ only in a few fields: hop-by-hop and
+ * end-to-end identifiers, Session-Id, Result-Code, granted units... (DWA, CEA, CCA)
+ *
+ *     MessageTemplate cca(msg);
+ *     auto session_id = cca.field(263);
+ *     auto cc_time = cca.field(cca.field(cca.field(456), 431), 420);
+ *
+ *     TemplateInstance answer;
+ *     cca.instantiate(answer)
+ *         .hop_by_hop(request.hop_by_hop)
+ *         .end_to_end(request.end_to_end)
+ *         .set(session_id, request_session_id)
+ *         .set(cc_time, uint32_t{3600});
+ *
+ * Producing an instance is a copy of the encoded bytes plus the patches. The offsets of all AVPs
+ * are recorded when the template is built, so any AVP can be used as a field.
+ */
+class MessageTemplate
+{
+public:
+    using Field = TemplateInstance::Field;
+
+    MessageTemplate() = default;
+
+    MessageTemplate(MessageTemplate const&) = default;
+    MessageTemplate& operator= (MessageTemplate const&) = default;
+    MessageTemplate(MessageTemplate&&) = default;
+    MessageTemplate& operator= (MessageTemplate&&) = default;
+
+    explicit MessageTemplate(message::Message msg)
+    {
+        auto size = msg.size();
+        m_prototype.m_data.resize(size);
+        netpacker::put(m_prototype.m_data.begin(), m_prototype.m_data.end(), msg);
+        record(msg.avps, msg.header.size(), npos);
+    }
+
+    // First top level AVP with the code and vendor id
+    Field field(message::avp::Code code,
+        std::optional<message::avp::VendorId> vendor_id = std::nullopt) const
+    {
+        return find(npos, code, vendor_id);
+    }
+
+    // First AVP with the code and vendor id inside the Grouped AVP `parent`
+    Field field(Field parent, message::avp::Code code,
+        std::optional<message::avp::VendorId> vendor_id = std::nullopt) const
+    {
+        return find(parent, code, vendor_id);
+    }
+
+    // Resets the instance to the encoded template, reusing its storage
+    TemplateInstance& instantiate(TemplateInstance& instance) const
+    {
+        instance.m_data.assign(m_prototype.m_data.begin(), m_prototype.m_data.end());
+        instance.m_avps.assign(m_prototype.m_avps.begin(), m_prototype.m_avps.end());
+        return instance;
+    }
+
+    TemplateInstance instantiate() const
+    {
+        return m_prototype;
+    }
+
+    message::ByteSpan data() const noexcept
+    {
+        return m_prototype.data();
+    }
+
+private:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    struct Key
+    {
+        message::avp::Code code;
+        std::optional<message::avp::VendorId> vendor_id;
+        std::size_t parent;
+    };
+
+    void record(const message::avp::AvpList& avps, std::size_t offset, std::size_t parent)
+    {
+        for (const auto& avp : avps) {
+            auto index = m_keys.size();
+            const auto* grouped = std::get_if<message::avp::Grouped>(&avp.value);
+            uint32_t header_length = avp.flags[message::avp::Flag::VendorSpecific] ? 12 : 8;
+            m_keys.push_back(Key {avp.code, avp.vendor_id, parent});
+            m_prototype.m_avps.push_back(TemplateInstance::Avp {
+                offset, offset + avp.size(), header_length, grouped != nullptr});
+            if (grouped != nullptr) {
+                record(**grouped, offset + header_length, index);
+            }
+            offset += avp.size();
+        }
+    }
+
+    Field find(std::size_t parent, message::avp::Code code,
+        std::optional<message::avp::VendorId> vendor_id) const
+    {
+        for (std::size_t i = 0; i < m_keys.size(); ++i) {
+            const auto& key = m_keys[i];
+            if (key.parent == parent && key.code == code && key.vendor_id == vendor_id) {
+                return i;
+            }
+        }
+        throw std::invalid_argument("MessageTemplate: no such AVP in the template");
+    }
+
+    TemplateInstance m_prototype;
+    std::vector<Key> m_keys;
+};
+
+} // namespace diameter::serial
+
+#endif
@@ -0,0 +1,498 @@
+#ifndef DIAMETER_SERIAL_RECORD_H
+#define DIAMETER_SERIAL_RECORD_H
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include <diameter/dictionary/schema.h>
+#include <diameter/message/header/header.h>
+#include <diameter/message/span.h>
+#include <diameter/serial/decode_error.h>
+#include <diameter/serial/detail/byte_order.h>
+#include <diameter/serial/view/view.h>
+
+// Decoding and encoding of the message structs generated by diameter_dictgen, e.g.
+// dictionaries::dcca::record::CreditControlRequest: one member per rule of the grammar of the
+// command, read from and written to the wire without Message and AVP.
+//
+// The members are typed by the AVP: uint32_t (Unsigned32, Time), int32_t (Integer32,
+// Enumerated), uint64_t, int64_t, float, double, std::string_view (UTF8String, DiameterIdentity,
+// DiameterURI, IPFilterRule), message::ByteSpan (OctetString, Address as encoded) and
+// view::AvpRange (Grouped). A rule of at most one AVP is a value, or a std::optional if the AVP
+// may be absent; other rules are a std::vector. The AVPs which are not in the grammar are kept in
+// `avps`. A record is:
+//
+//     struct Record
+//     {
+//         static constexpr const dictionary::CommandSchema& schema = ...;
+//
+//         message::header::Header header;
+//         ... members ...
+//         std::vector<view::AvpView> avps;
+//
+//         // Stores the AVP of the rule at `index` of the schema, false if its value is invalid
+//         bool decode(std::size_t index, const view::AvpView& avp);
+//
+//         // visitor(code, vendor_id, flag_bits, member) for every member in the order of the rules
+//         template<typename Self, typename Visitor>
+//         static void visit(Self& self, Visitor&& visitor);
+//     };
+
+namespace diameter::serial::record {
+
+/*
+ * Header of a new message of the command: version 1, the 'R' flag for a request and the 'P' flag
+ * for the commands of an application, which are proxiable unlike those of the base protocol.
+ */
+inline message::header::Header make_header(message::header::CommandCode command_code,
+    message::header::ApplicationId application_id, bool request) noexcept
+{
+    using message::header::CommandFlag;
+
+    message::header::Header header;
+    header.version = message::header::ProtocolVersionV::V01;
+    header.length = 0;
+    header.command_code = command_code;
+    header.application_id = application_id;
+    header.hop_by_hop = 0;
+    header.end_to_end = 0;
+    header.command_flags = message::header::CommandFlags(uint8_t {0});
+    header.command_flags.set(CommandFlag::Request, request);
+    header.command_flags.set(CommandFlag::Proxiable, application_id != 0);
+    return header;
+}
+
+// Values of the AVPs, false if the size of the data does not fit the type
+
+inline bool get(const view::AvpView& avp, uint32_t& value) noexcept
+{
+    auto data = avp.data();
+    if (data.size() != sizeof(value)) {
+        return false;
+    }
+    value = serial::detail::load_u32(data.data());
+    return true;
+}
+
+inline bool get(const view::AvpView& avp, int32_t& value) noexcept
+{
+    uint32_t bits = 0;
+    if (!get(avp, bits)) {
+        return false;
+    }
+    value = static_cast<int32_t>(bits);
+    return true;
+}
+
+inline bool get(const view::AvpView& avp, uint64_t& value) noexcept
+{
+    auto data = avp.data();
+    if (data.size() != sizeof(value)) {
+        return false;
+    }
+    value = serial::detail::load_u64(data.data());
+    return true;
+}
+
+inline bool get(const view::AvpView& avp, int64_t& value) noexcept
+{
+    uint64_t bits = 0;
+    if (!get(avp, bits)) {
+        return false;
+    }
+    value = static_cast<int64_t>(bits);
+    return true;
+}
+
+inline bool get(const view::AvpView& avp, float& value) noexcept
+{
+    uint32_t bits = 0;
+    if (!get(avp, bits)) {
+        return false;
+    }
+    std::memcpy(&value, &bits, sizeof(value));
+    return true;
+}
+
+inline bool get(const view::AvpView& avp, double& value) noexcept
+{
+    uint64_t bits = 0;
+    if (!get(avp, bits)) {
+        return false;
+    }
+    std::memcpy(&value, &bits, sizeof(value));
+    return true;
+}
+
+inline bool get(const view::AvpView& avp, std::string_view& value) noexcept
+{
+    auto data = avp.data();
+    value = std::string_view(reinterpret_cast<const char*>(data.data()), data.size());
+    return true;
+}
+
+inline bool get(const view::AvpView& avp, message::ByteSpan& value) noexcept
+{
+    value = avp.data();
+    return true;
+}
+
+// The nested AVPs are checked, not decoded
+inline bool get(const view::AvpView& avp, view::AvpRange& value) noexcept
+{
+    auto data = avp.data();
+    if (view::check_avps(data.begin(), data.end())) {
+        return false;
+    }
+    value = view::AvpRange(data, view::AvpRange::checked);
+    return true;
+}
+
+template<typename T>
+bool get(const view::AvpView& avp, std::optional<T>& value)
+{
+    T decoded {};
+    if (!get(avp, decoded)) {
+        return false;
+    }
+    value = decoded;
+    return true;
+}
+
+template<typename T>
+bool get(const view::AvpView& avp, std::vector<T>& values)
+{
+    T decoded {};
+    if (!get(avp, decoded)) {
+        return false;
+    }
+    values.push_back(decoded);
+    return true;
+}
+
+// Size of the data of the AVPs and its encoding, `p` has room for it
+
+template<typename T>
+std::size_t value_size(const T&) noexcept
+{
+    return sizeof(T);
+}
+
+inline std::size_t value_size(std::string_view value) noexcept
+{
+    return value.size();
+}
+
+inline std::size_t value_size(message::ByteSpan value) noexcept
+{
+    return value.size();
+}
+
+inline std::size_t value_size(const view::AvpRange& value) noexcept
+{
+    return value.data().size();
+}
+
+inline uint8_t* put(uint8_t* p, uint32_t value) noexcept
+{
+    serial::detail::store_u32(p, value);
+    return p + sizeof(value);
+}
+
+inline uint8_t* put(uint8_t* p, int32_t value) noexcept
+{
+    return put(p, static_cast<uint32_t>(value));
+}
+
+inline uint8_t* put(uint8_t* p, uint64_t value) noexcept
+{
+    serial::detail::store_u64(p, value);
+    return p + sizeof(value);
+}
+
+inline uint8_t* put(uint8_t* p, int64_t value) noexcept
+{
+    return put(p, static_cast<uint64_t>(value));
+}
+
+inline uint8_t* put(uint8_t* p, float value) noexcept
+{
+    uint32_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(value));
+    return put(p, bits);
+}
+
+inline uint8_t* put(uint8_t* p, double value) noexcept
+{
+    uint64_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(value));
+    return put(p, bits);
+}
+
+inline uint8_t* put(uint8_t* p, std::string_view value) noexcept
+{
+    if (!value.empty()) {
+        std::memcpy(p, value.data(), value.size());
+    }
+    return p + value.size();
+}
+
+inline uint8_t* put(uint8_t* p, message::ByteSpan value) noexcept
+{
+    if (!value.empty()) {
+        std::memcpy(p, value.data(), value.size());
+    }
+    return p + value.size();
+}
+
+inline uint8_t* put(uint8_t* p, const view::AvpRange& value) noexcept
+{
+    return put(p, value.data());
+}
+
+namespace detail {
+
+constexpr uint8_t vendor_bit = 0x80;
+
+inline std::size_t avp_size(uint8_t flag_bits, std::size_t value_size) noexcept
+{
+    auto header_size = (flag_bits & vendor_bit) != 0
+        ? view::AvpView::vendor_header_size
+        : view::AvpView::header_size;
+    return (header_size + value_size + 3) & ~std::size_t {3};
+}
+
+// Size of the AVPs of a member: none for an empty optional or vector
+struct SizeVisitor
+{
+    std::size_t size {0};
+
+    template<typename T>
+    void operator() (message::avp::Code, message::avp::VendorId, uint8_t flag_bits,
+        const T& value) noexcept
+    {
+        size += avp_size(flag_bits, value_size(value));
+    }
+
+    template<typename T>
+    void operator() (message::avp::Code code, message::avp::VendorId vendor_id, uint8_t flag_bits,
+        const std::optional<T>& value) noexcept
+    {
+        if (value) {
+            (*this)(code, vendor_id, flag_bits, *value);
+        }
+    }
+
+    template<typename T>
+    void operator() (message::avp::Code code, message::avp::VendorId vendor_id, uint8_t flag_bits,
+        const std::vector<T>& values) noexcept
+    {
+        for (const auto& value : values) {
+            (*this)(code, vendor_id, flag_bits, value);
+        }
+    }
+};
+
+struct PutVisitor
+{
+    uint8_t* p;
+
+    template<typename T>
+    void operator() (message::avp::Code code, message::avp::VendorId vendor_id, uint8_t flag_bits,
+        const T& value) noexcept
+    {
+        auto* first = p;
+        serial::detail::store_u32(p, code);
+        p[4] = flag_bits;
+        p += view::AvpView::header_size;
+        if ((flag_bits & vendor_bit) != 0) {
+            serial::detail::store_u32(p, vendor_id);
+            p += sizeof(vendor_id);
+        }
+        p = put(p, value);
+        serial::detail::store_u24(first + 5, static_cast<uint32_t>(p - first));
+        while ((p - first) % 4 != 0) {
+            *p++ = 0;
+        }
+    }
+
+    template<typename T>
+    void operator() (message::avp::Code code, message::avp::VendorId vendor_id, uint8_t flag_bits,
+        const std::optional<T>& value) noexcept
+    {
+        if (value) {
+            (*this)(code, vendor_id, flag_bits, *value);
+        }
+    }
+
+    template<typename T>
+    void operator() (message::avp::Code code, message::avp::VendorId vendor_id, uint8_t flag_bits,
+        const std::vector<T>& values) noexcept
+    {
+        for (const auto& value : values) {
+            (*this)(code, vendor_id, flag_bits, value);
+        }
+    }
+};
+
+struct ClearVisitor
+{
+    template<typename T>
+    void operator() (message::avp::Code, message::avp::VendorId, uint8_t, T& value) noexcept
+    {
+        value = T {};
+    }
+
+    // Keeps the capacity
+    template<typename T>
+    void operator() (message::avp::Code, message::avp::VendorId, uint8_t,
+        std::vector<T>& values) noexcept
+    {
+        values.clear();
+    }
+};
+
+} // namespace detail
+
+/*
+ * Resets the members of the record for the decoding of another message; the vectors keep their
+ * capacity, so a record reused by a connection stops allocating.
+ */
+template<typename Record>
+void clear(Record& record) noexcept
+{
+    Record::visit(record, detail::ClearVisitor {});
+    record.avps.clear();
+}
+
+/*
+ * Decodes the message in `data` into `record`, which refers to `data`: the buffer must outlive
+ * it. The message is checked as MessageView does, then each AVP is stored into the member of its
+ * rule, found by CommandSchema::find(), and counted on the stack. Besides the errors of
+ * MessageView, an AVP of a Fixed rule not at its position or a missing AVP is MissingAvp, an AVP
+ * which is not in the grammar without "* [ AVP ]" is AvpNotAllowed, an AVP past the maximum of
+ * its rule is AvpOccursTooManyTimes and a value which does not fit its member is InvalidAvpLength.
+ *
+ * The header is not checked against the command of the record: dispatch on the header of a
+ * MessageView first. Only the vectors of the record allocate.
+ */
+template<typename Record>
+DecodeError try_decode(message::ByteSpan data, Record& record)
+{
+    const auto& schema = Record::schema;
+
+    if (auto error = view::check_message(data)) {
+        return error;
+    }
+    clear(record);
+    view::MessageView msg(data, view::MessageView::checked);
+    record.header = msg.header();
+
+    std::array<uint32_t, dictionary::CommandSchema::max_rules> counts {};
+    std::size_t position = 0;
+    const auto* begin = msg.data().data();
+    for (const auto& avp : msg.avps()) {
+        auto offset = static_cast<std::size_t>(avp.raw().data() - begin);
+        auto code = avp.code();
+        auto vendor_id = avp.vendor_id().value_or(0);
+        if (position < schema.fixed) {
+            const auto& fixed = schema.rules[position];
+            if (code != fixed.code || vendor_id != fixed.vendor_id) {
+                return DecodeError {DecodeErrorV::MissingAvp, offset, fixed.code,
+                    "Missing avp: not at the position of a fixed avp"};
+            }
+        }
+        ++position;
+
+        auto index = schema.find(code, vendor_id);
+        if (!index || schema.rules[*index].max == 0) {
+            if (!schema.any_avp || index) {
+                return DecodeError {DecodeErrorV::AvpNotAllowed, offset, code,
+                    "Avp not allowed"};
+            }
+            record.avps.push_back(avp);
+            continue;
+        }
+        if (++counts[*index] > schema.rules[*index].max) {
+            return DecodeError {DecodeErrorV::AvpOccursTooManyTimes, offset, code,
+                "Avp occurs too many times"};
+        }
+        if (!record.decode(*index, avp)) {
+            return DecodeError {DecodeErrorV::InvalidAvpLength, offset, code,
+                "Invalid avp length: the value does not fit the type"};
+        }
+    }
+    for (std::size_t i = 0; i < schema.size; ++i) {
+        const auto& rule = schema.rules[i];
+        if (counts[i] < rule.min) {
+            return DecodeError {DecodeErrorV::MissingAvp, msg.length(), rule.code,
+                "Missing avp"};
+        }
+    }
+    return DecodeError {};
+}
+
+// Decodes a new record, throws the exceptions of the throwing decode path
+template<typename Record>
+Record decode(message::ByteSpan data)
+{
+    Record record;
+    if (auto error = try_decode(data, record)) {
+        throw_decode_error(error);
+    }
+    return record;
+}
+
+// Size of the encoded message
+template<typename Record>
+std::size_t size(const Record& record) noexcept
+{
+    detail::SizeVisitor visitor {view::MessageView::header_size};
+    Record::visit(record, visitor);
+    for (const auto& avp : record.avps) {
+        visitor.size += avp.size();
+    }
+    return visitor.size;
+}
+
+/*
+ * Encodes the message into `data`, which has room for size(record) bytes, and returns the end of
+ * the message. The members are written in the order of the grammar, then `avps`, the Message
+ * Length is set; the rest of the header is written as it is.
+ */
+template<typename Record>
+uint8_t* encode(const Record& record, uint8_t* data) noexcept
+{
+    const auto& header = record.header;
+    data[0] = header.version;
+    data[4] = header.command_flags.data();
+    serial::detail::store_u24(data + 5, header.command_code);
+    serial::detail::store_u32(data + 8, header.application_id);
+    serial::detail::store_u32(data + 12, header.hop_by_hop);
+    serial::detail::store_u32(data + 16, header.end_to_end);
+
+    detail::PutVisitor visitor {data + view::MessageView::header_size};
+    Record::visit(record, visitor);
+    for (const auto& avp : record.avps) {
+        visitor.p = put(visitor.p, avp.raw());
+    }
+    serial::detail::store_u24(data + 1, static_cast<uint32_t>(visitor.p - data));
+    return visitor.p;
+}
+
+// Appends the encoded message to `out`
+template<typename Record>
+void encode(const Record& record, std::vector<uint8_t>& out)
+{
+    auto offset = out.size();
+    out.resize(offset + size(record));
+    encode(record, out.data() + offset);
+}
+
+} // namespace diameter::serial::record
+
+#endif
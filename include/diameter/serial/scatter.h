@@ -0,0 +1,223 @@
+#ifndef DIAMETER_SERIAL_SCATTER_H
+#define DIAMETER_SERIAL_SCATTER_H
+
+#include <sys/uio.h>
+
+#include <climits>
+#include <cstdint>
+#include <stdexcept>
+#include <variant>
+#include <vector>
+
+#include <netpacker/netpacker.h>
+
+#include <diameter/message/message.h>
+#include <diameter/serial/avp/avp.h>
+#include <diameter/serial/detail/byte_order.h>
+#include <diameter/serial/error.h>
+#include <diameter/serial/header/header.h>
+
+namespace diameter::serial {
+
+/*
+ * Encodes a message into an iovec list ready for writev() / sendmsg().
+ *
+ * The header, the AVP headers, the padding and the small values are written into a scratch buffer
+ * owned by the encoder. OctetString and UTF8String payloads of at least `threshold` bytes are not
+ * copied: their iovec entries point into the message. Lengths are back-patched in the scratch
+ * buffer, so the message is still encoded in one pass.
+ *
+ * The iovec list is valid until the next encode() and as long as the message is neither changed
+ * nor destroyed. The encoder is meant to be reused: its buffers keep their capacity.
+ */
+class ScatterEncoder
+{
+public:
+    static constexpr std::size_t default_threshold = 512;
+#ifdef IOV_MAX
+    static constexpr std::size_t default_max_iovecs = IOV_MAX;
+#else
+    static constexpr std::size_t default_max_iovecs = 1024;
+#endif
+
+    explicit ScatterEncoder(std::size_t threshold = default_threshold,
+        std::size_t max_iovecs = default_max_iovecs)
+        : m_threshold(threshold),
+          m_max_iovecs(max_iovecs)
+    {
+        if (max_iovecs == 0) {
+            throw std::invalid_argument("ScatterEncoder: invalid max_iovecs");
+        }
+    }
+
+    ScatterEncoder(ScatterEncoder const&) = delete;
+    ScatterEncoder& operator= (ScatterEncoder const&) = delete;
+    ScatterEncoder(ScatterEncoder&&) = default;
+    ScatterEncoder& operator= (ScatterEncoder&&) = default;
+
+    const std::vector<iovec>& encode(const message::Message& msg)
+    {
+        m_scratch.clear();
+        m_segments.clear();
+        m_iovecs.clear();
+        m_size = 0;
+        m_run = 0;
+
+        auto header_offset = grow(msg.header.size());
+        netpacker::put(scratch(header_offset), m_scratch.end(), msg.header);
+        for (const auto& avp : msg.avps) {
+            put(avp);
+        }
+        if (m_size > max_length) {
+            throw InvalidMessageLength();
+        }
+        // Message Length follows the one byte Version
+        detail::store_u24(m_scratch.data() + header_offset + 1, static_cast<uint32_t>(m_size));
+        close_run();
+
+        // The scratch buffer does not move any more
+        m_iovecs.reserve(m_segments.size());
+        for (const auto& segment : m_segments) {
+            const auto* base = segment.external != nullptr
+                ? segment.external
+                : m_scratch.data() + segment.offset;
+            m_iovecs.push_back(iovec {const_cast<uint8_t*>(base), segment.length});
+        }
+        return m_iovecs;
+    }
+
+    const std::vector<iovec>& iovecs() const noexcept
+    {
+        return m_iovecs;
+    }
+
+    // Total length of the last encoded message
+    std::size_t size() const noexcept
+    {
+        return m_size;
+    }
+
+    // Bytes copied into the scratch buffer by the last encode()
+    std::size_t copied() const noexcept
+    {
+        return m_scratch.size();
+    }
+
+    std::size_t threshold() const noexcept
+    {
+        return m_threshold;
+    }
+
+    std::size_t max_iovecs() const noexcept
+    {
+        return m_max_iovecs;
+    }
+
+private:
+    // Message Length and AVP Length are 24-bit
+    static constexpr std::size_t max_length = 0xFFFFFF;
+
+    // Bytes [offset, offset + length) of the scratch buffer, or `length` bytes at `external`
+    struct Segment
+    {
+        const uint8_t* external;
+        std::size_t offset;
+        std::size_t length;
+    };
+
+    void put(const message::avp::AVP& avp)
+    {
+        namespace dma = message::avp;
+
+        auto start = m_size;
+        auto header_length = avp.flags[dma::Flag::VendorSpecific] ? 12 : 8;
+        auto header_offset = grow(static_cast<std::size_t>(header_length));
+        auto pos = scratch(header_offset);
+        pos = netpacker::put(pos, m_scratch.end(), avp.code);
+        pos = netpacker::put(pos, m_scratch.end(), avp.flags);
+        pos = netpacker::skipbytes(pos, m_scratch.end(), 3);
+        if (avp.flags[dma::Flag::VendorSpecific]) {
+            if (!avp.vendor_id.has_value()) {
+                throw InvalidAvpVendorId();
+            }
+            netpacker::put(pos, m_scratch.end(), avp.vendor_id.value());
+        }
+
+        if (const auto* grouped = std::get_if<dma::Grouped>(&avp.value)) {
+            for (const auto& child : **grouped) {
+                put(child);
+            }
+        }
+        else if (const auto* octet_string = std::get_if<dma::OctetString>(&avp.value);
+                 octet_string != nullptr && is_referenced((*octet_string)->size())) {
+            reference((*octet_string)->data(), (*octet_string)->size());
+        }
+        else if (const auto* utf8_string = std::get_if<dma::UTF8String>(&avp.value);
+                 utf8_string != nullptr && is_referenced((*utf8_string)->size())) {
+            reference(reinterpret_cast<const uint8_t*>((*utf8_string)->data()),
+                (*utf8_string)->size());
+        }
+        else {
+            auto size = std::visit([](auto&& arg) -> std::size_t { return arg.size(); },
+                avp.value);
+            auto value_offset = grow(size);
+            netpacker::put(scratch(value_offset), m_scratch.end(), avp.value);
+        }
+
+        if (m_size - start > max_length) {
+            throw InvalidAvpLength("Invalid avp length: too large");
+        }
+        auto length = static_cast<dma::Length>(m_size - start);
+        detail::store_u24(m_scratch.data() + header_offset + 5, length);
+        grow(dma::AVP::padding(length));
+    }
+
+    // Appends `size` zeroed bytes to the scratch buffer and returns their offset
+    std::size_t grow(std::size_t size)
+    {
+        auto offset = m_scratch.size();
+        m_scratch.resize(offset + size);
+        m_size += size;
+        return offset;
+    }
+
+    std::vector<uint8_t>::iterator scratch(std::size_t offset)
+    {
+        return m_scratch.begin() + static_cast<std::ptrdiff_t>(offset);
+    }
+
+    // Whether a payload is referenced in place: large enough and the list has room for the run
+    // before it, the payload and the run after it
+    bool is_referenced(std::size_t size) const noexcept
+    {
+        return size >= m_threshold && m_segments.size() + 3 <= m_max_iovecs;
+    }
+
+    void reference(const uint8_t* data, std::size_t size)
+    {
+        close_run();
+        m_segments.push_back(Segment {data, 0, size});
+        m_size += size;
+    }
+
+    // Ends the scratch bytes written since the last referenced payload
+    void close_run()
+    {
+        if (m_scratch.size() > m_run) {
+            m_segments.push_back(Segment {nullptr, m_run, m_scratch.size() - m_run});
+            m_run = m_scratch.size();
+        }
+    }
+
+    std::size_t m_threshold;
+    std::size_t m_max_iovecs;
+    std::vector<uint8_t> m_scratch;
+    std::vector<Segment> m_segments;
+    std::vector<iovec> m_iovecs;
+    std::size_t m_size {0};
+    std::size_t m_run {0};
+};
+
+} // namespace diameter::serial
+
+#endif
@@ -2,8 +2,20 @@
 #define DIAMETER_SERIAL_SERIAL_H
 
 #include <diameter/serial/avp/avp.h>
+#include <diameter/serial/avp/avp_def.h>
+#include <diameter/serial/avp/lazy_value.h>
+#include <diameter/serial/batch.h>
+#include <diameter/serial/decode.h>
+#include <diameter/serial/decode_error.h>
+#include <diameter/serial/dictionary.h>
 #include <diameter/serial/error.h>
+#include <diameter/serial/framer.h>
 #include <diameter/serial/header/header.h>
 #include <diameter/serial/message.h>
+#include <diameter/serial/answer.h>
+#include <diameter/serial/message_template.h>
+#include <diameter/serial/record.h>
+#include <diameter/serial/scatter.h>
+#include <diameter/serial/view/view.h>
 
 #endif
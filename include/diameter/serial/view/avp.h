@@ -0,0 +1,312 @@
+#ifndef DIAMETER_SERIAL_VIEW_AVP_H
+#define DIAMETER_SERIAL_VIEW_AVP_H
+
+#include <cstdint>
+#include <iterator>
+#include <memory_resource>
+#include <optional>
+
+#include <diameter/message/avp/avp.h>
+#include <diameter/message/span.h>
+#include <diameter/serial/decode_error.h>
+#include <diameter/serial/detail/byte_order.h>
+#include <diameter/serial/error.h>
+
+namespace diameter::serial::view {
+
+class AvpRange;
+
+/*
+ * Non-owning view of an encoded AVP.
+ *
+ * The view only holds a pointer to the first byte of the AVP header, all fields are read from the
+ * buffer on access. The AVP must be validated before a view is created (see AvpRange), so the
+ * accessors never check bounds.
+ */
+class AvpView
+{
+public:
+    static constexpr message::avp::Length header_size = 8;
+    static constexpr message::avp::Length vendor_header_size = 12;
+
+    AvpView() = default;
+
+    AvpView(AvpView const&) = default;
+    AvpView& operator= (AvpView const&) = default;
+
+    explicit AvpView(const uint8_t* data) noexcept
+        : m_data(data)
+    {
+    }
+
+    message::avp::Code code() const noexcept
+    {
+        return detail::load_u32(m_data);
+    }
+
+    message::avp::Flags flags() const noexcept
+    {
+        return message::avp::Flags(m_data[4]);
+    }
+
+    bool is_vendor_specific() const noexcept
+    {
+        return (m_data[4] & 0x80) != 0;
+    }
+
+    bool is_mandatory() const noexcept
+    {
+        return (m_data[4] & 0x40) != 0;
+    }
+
+    std::optional<message::avp::VendorId> vendor_id() const noexcept
+    {
+        if (is_vendor_specific()) {
+            return detail::load_u32(m_data + header_size);
+        }
+        return std::nullopt;
+    }
+
+    // AVP Length field: header and data without padding
+    message::avp::Length length() const noexcept
+    {
+        return detail::load_u24(m_data + 5);
+    }
+
+    message::avp::Length padding() const noexcept
+    {
+        auto pad = length() % 4;
+        return pad ? 4 - pad : 0;
+    }
+
+    // Length of the AVP on the wire with padding
+    message::avp::Length size() const noexcept
+    {
+        return length() + padding();
+    }
+
+    // Data field of the AVP
+    message::ByteSpan data() const noexcept
+    {
+        auto offset = is_vendor_specific() ? vendor_header_size : header_size;
+        return message::ByteSpan(m_data + offset, length() - offset);
+    }
+
+    // Whole encoded AVP with padding, e.g. for forwarding it unchanged
+    message::ByteSpan raw() const noexcept
+    {
+        return message::ByteSpan(m_data, size());
+    }
+
+    // Data field interpreted as a list of AVPs; validates the nested AVP chain
+    AvpRange grouped() const;
+
+    // Materializes the AVP with an OctetString value, as netpacker::get<AVP> does
+    message::avp::AVP to_avp(
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const
+    {
+        auto payload = data();
+        return message::avp::AVP {code(), flags(), vendor_id(),
+            message::avp::OctetString(
+                message::avp::OctetString::value_type(payload.begin(), payload.end(), resource))};
+    }
+
+private:
+    const uint8_t* m_data {nullptr};
+};
+
+/*
+ * Checks the header of the AVP at `first`, which ends before `last`. The offset of the AVP is
+ * reported as `offset`.
+ */
+inline DecodeError check_avp(const uint8_t* first, const uint8_t* last,
+    std::size_t offset = 0) noexcept
+{
+    auto remain = static_cast<std::size_t>(last - first);
+    auto error = DecodeError {DecodeErrorV::InvalidAvpLength, offset, 0, ""};
+    if (remain < AvpView::header_size) {
+        if (remain >= sizeof(message::avp::Code)) {
+            error.avp_code = detail::load_u32(first);
+        }
+        error.reason = "Invalid avp length: truncated avp header";
+        return error;
+    }
+    AvpView avp(first);
+    error.avp_code = avp.code();
+    auto length = avp.length();
+    if (length < AvpView::header_size) {
+        error.reason = "Invalid avp length: too small";
+        return error;
+    }
+    if (avp.is_vendor_specific() && length < AvpView::vendor_header_size) {
+        error.reason = "Invalid avp length: too small for vendor specific";
+        return error;
+    }
+    if (avp.size() > remain) {
+        error.reason = "Invalid avp length: out of bounds";
+        return error;
+    }
+    return DecodeError {};
+}
+
+/*
+ * Checks that [first, last) is a sequence of well-formed padded AVPs. The offset of the failing
+ * AVP is reported relative to `first` plus `offset`.
+ */
+inline DecodeError check_avps(const uint8_t* first, const uint8_t* last,
+    std::size_t offset = 0) noexcept
+{
+    const auto* begin = first;
+    while (first != last) {
+        if (auto error = check_avp(first, last,
+                offset + static_cast<std::size_t>(first - begin))) {
+            return error;
+        }
+        first += AvpView(first).size();
+    }
+    return DecodeError {};
+}
+
+/*
+ * Checks that [first, last) is a sequence of well-formed padded AVPs, throws InvalidAvpLength
+ */
+inline void validate_avps(const uint8_t* first, const uint8_t* last)
+{
+    if (auto error = check_avps(first, last)) {
+        throw_decode_error(error);
+    }
+}
+
+/*
+ * Forward range over a validated chain of AVPs
+ */
+class AvpRange
+{
+public:
+    class iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = AvpView;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const AvpView*;
+        using reference = const AvpView&;
+
+        iterator() = default;
+
+        explicit iterator(const uint8_t* position) noexcept
+            : m_avp(position),
+              m_position(position)
+        {
+        }
+
+        reference operator* () const noexcept
+        {
+            return m_avp;
+        }
+
+        pointer operator->() const noexcept
+        {
+            return &m_avp;
+        }
+
+        iterator& operator++ () noexcept
+        {
+            m_position += m_avp.size();
+            m_avp = AvpView(m_position);
+            return *this;
+        }
+
+        iterator operator++ (int) noexcept
+        {
+            auto tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        bool operator== (const iterator& other) const noexcept
+        {
+            return m_position == other.m_position;
+        }
+
+        bool operator!= (const iterator& other) const noexcept
+        {
+            return m_position != other.m_position;
+        }
+
+    private:
+        AvpView m_avp;
+        const uint8_t* m_position {nullptr};
+    };
+
+    AvpRange() = default;
+
+    AvpRange(AvpRange const&) = default;
+    AvpRange& operator= (AvpRange const&) = default;
+
+    // Tag of the constructor which skips the validation of an already checked chain
+    struct Checked
+    {
+    };
+    static constexpr Checked checked {};
+
+    // Validates the AVP chain
+    explicit AvpRange(message::ByteSpan data)
+        : m_data(data)
+    {
+        validate_avps(m_data.begin(), m_data.end());
+    }
+
+    AvpRange(message::ByteSpan data, Checked) noexcept
+        : m_data(data)
+    {
+    }
+
+    iterator begin() const noexcept
+    {
+        return iterator(m_data.begin());
+    }
+
+    iterator end() const noexcept
+    {
+        return iterator(m_data.end());
+    }
+
+    bool empty() const noexcept
+    {
+        return m_data.empty();
+    }
+
+    std::size_t count() const noexcept
+    {
+        return static_cast<std::size_t>(std::distance(begin(), end()));
+    }
+
+    message::ByteSpan data() const noexcept
+    {
+        return m_data;
+    }
+
+    std::optional<AvpView> find(message::avp::Code code,
+        std::optional<message::avp::VendorId> vendor_id = std::nullopt) const noexcept
+    {
+        for (const auto& avp : *this) {
+            if (avp.code() == code && avp.vendor_id() == vendor_id) {
+                return avp;
+            }
+        }
+        return std::nullopt;
+    }
+
+private:
+    message::ByteSpan m_data;
+};
+
+inline AvpRange AvpView::grouped() const
+{
+    return AvpRange(data());
+}
+
+} // namespace diameter::serial::view
+
+#endif
@@ -0,0 +1,167 @@
+#ifndef DIAMETER_SERIAL_VIEW_MESSAGE_H
+#define DIAMETER_SERIAL_VIEW_MESSAGE_H
+
+#include <cstdint>
+#include <memory_resource>
+#include <optional>
+
+#include <diameter/message/header/header.h>
+#include <diameter/message/message.h>
+#include <diameter/message/span.h>
+#include <diameter/serial/decode_error.h>
+#include <diameter/serial/detail/byte_order.h>
+#include <diameter/serial/error.h>
+#include <diameter/serial/view/avp.h>
+
+namespace diameter::serial::view {
+
+/*
+ * Checks the header and the chain of top level AVPs of an encoded message, `data` may hold more
+ * bytes than the message. Never throws nor allocates.
+ */
+inline DecodeError check_message(message::ByteSpan data) noexcept;
+
+/*
+ * Non-owning view of an encoded Diameter message.
+ *
+ * The constructor validates the header and the chain of top level AVPs in place, nothing is
+ * copied or allocated. AVPs are exposed as AvpView objects which point into the original buffer,
+ * so the buffer must outlive the view.
+ */
+class MessageView
+{
+public:
+    static constexpr std::size_t header_size = 20;
+
+    MessageView() = default;
+
+    MessageView(MessageView const&) = default;
+    MessageView& operator= (MessageView const&) = default;
+
+    // `data` may hold more bytes than the message, only the first header.length bytes are viewed
+    explicit MessageView(message::ByteSpan data)
+    {
+        if (auto error = check_message(data)) {
+            throw_decode_error(error);
+        }
+        parse(data);
+    }
+
+    // Tag of the constructor which skips the validation of an already checked message
+    struct Checked
+    {
+    };
+    static constexpr Checked checked {};
+
+    MessageView(message::ByteSpan data, Checked) noexcept
+    {
+        parse(data);
+    }
+
+    // Non-throwing construction, the error carries the failing offset and the Result-Code
+    static DecodeResult<MessageView> try_parse(message::ByteSpan data) noexcept
+    {
+        if (auto error = check_message(data)) {
+            return error;
+        }
+        return MessageView(data, checked);
+    }
+
+    MessageView(const uint8_t* data, std::size_t size)
+        : MessageView(message::ByteSpan(data, size))
+    {
+    }
+
+    const message::header::Header& header() const noexcept
+    {
+        return m_header;
+    }
+
+    message::header::MessageLength length() const noexcept
+    {
+        return m_header.length;
+    }
+
+    // Encoded message, header.length bytes
+    message::ByteSpan data() const noexcept
+    {
+        return m_data;
+    }
+
+    const AvpRange& avps() const noexcept
+    {
+        return m_avps;
+    }
+
+    std::optional<AvpView> find(message::avp::Code code,
+        std::optional<message::avp::VendorId> vendor_id = std::nullopt) const noexcept
+    {
+        return m_avps.find(code, vendor_id);
+    }
+
+    // Materializes the message, as netpacker::get<Message> does
+    message::Message to_message(
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const
+    {
+        message::Message msg {m_header, message::avp::AvpList(resource)};
+        for (const auto& avp : m_avps) {
+            msg.avps.emplace_back(avp.to_avp(resource));
+        }
+        return msg;
+    }
+
+private:
+    // `data` is already checked
+    void parse(message::ByteSpan data) noexcept
+    {
+        const auto* p = data.data();
+        m_header.version = p[0];
+        m_header.length = detail::load_u24(p + 1);
+        m_header.command_flags = message::header::CommandFlags(p[4]);
+        m_header.command_code = detail::load_u24(p + 5);
+        m_header.application_id = detail::load_u32(p + 8);
+        m_header.hop_by_hop = detail::load_u32(p + 12);
+        m_header.end_to_end = detail::load_u32(p + 16);
+
+        m_data = data.first(m_header.length);
+        m_avps = AvpRange(m_data.subspan(header_size), AvpRange::checked);
+    }
+
+    message::header::Header m_header {};
+    message::ByteSpan m_data;
+    AvpRange m_avps;
+};
+
+inline DecodeError check_message(message::ByteSpan data) noexcept
+{
+    constexpr uint8_t request_bit = 0x80;
+    constexpr uint8_t error_bit = 0x20;
+
+    if (data.empty()) {
+        return DecodeError {DecodeErrorV::Truncated, 0, 0, "Truncated message header"};
+    }
+    const auto* p = data.data();
+    if (p[0] != message::header::ProtocolVersionV::V01) {
+        return DecodeError {DecodeErrorV::UnsupportedVersion, 0, 0, "Invalid protocol version"};
+    }
+    if (data.size() < MessageView::header_size) {
+        return DecodeError {DecodeErrorV::Truncated, data.size(), 0, "Truncated message header"};
+    }
+    // RFC 6733 3: the Message Length is always a multiple of 4
+    auto length = detail::load_u24(p + 1);
+    if (length < MessageView::header_size || length % 4 != 0) {
+        return DecodeError {DecodeErrorV::InvalidMessageLength, 1, 0, "Invalid message length"};
+    }
+    if (data.size() < length) {
+        return DecodeError {DecodeErrorV::Truncated, data.size(), 0, "Truncated message"};
+    }
+    // RFC 6733 3: the 'E' bit MUST NOT be set in request messages
+    if ((p[4] & request_bit) && (p[4] & error_bit)) {
+        return DecodeError {DecodeErrorV::InvalidHeaderBits, 4, 0, "Error bit set in request"};
+    }
+    return check_avps(p + MessageView::header_size, p + length, MessageView::header_size);
+}
+
+} // namespace diameter::serial::view
+
+#endif
@@ -0,0 +1,7 @@
+#ifndef DIAMETER_SERIAL_VIEW_VIEW_H
+#define DIAMETER_SERIAL_VIEW_VIEW_H
+
+#include <diameter/serial/view/avp.h>
+#include <diameter/serial/view/message.h>
+
+#endif
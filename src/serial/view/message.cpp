@@ -0,0 +1 @@
+#include <diameter/serial/view/message.h>
@@ -0,0 +1,80 @@
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <arpa/inet.h>
+
+#include <diameter/message/avp/avp.h>
+
+// Address values: construction from text and formatting of the inline address, against
+// inet_pton() / inet_ntop() into heap storage as the value used to be
+
+using namespace diameter::message;
+
+namespace {
+
+const char* const texts[] = {"10.10.10.1", "2001:db8:3c4d:7777:260:3eff:fe15:9501"};
+
+uint16_t family(int64_t index)
+{
+    return index == 0 ? avp::value::AddressFamilyV::IPv4 : avp::value::AddressFamilyV::IPv6;
+}
+
+}
+
+static void BM_AddressParse(benchmark::State& state)
+{
+    std::string text = texts[state.range(0)];
+
+    for (auto _ : state) {
+        auto value = avp::Address(family(state.range(0)), text);
+        benchmark::DoNotOptimize(value);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AddressParse)->DenseRange(0, 1);
+
+static void BM_AddressInetPton(benchmark::State& state)
+{
+    std::string text = texts[state.range(0)];
+    auto af = state.range(0) == 0 ? AF_INET : AF_INET6;
+
+    for (auto _ : state) {
+        uint8_t bytes[16];
+        inet_pton(af, text.c_str(), bytes);
+        auto value = std::vector<uint8_t>(bytes, bytes + (af == AF_INET ? 4 : 16));
+        auto copy = text;
+        benchmark::DoNotOptimize(value);
+        benchmark::DoNotOptimize(copy);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AddressInetPton)->DenseRange(0, 1);
+
+static void BM_AddressText(benchmark::State& state)
+{
+    auto value = avp::Address(family(state.range(0)), texts[state.range(0)]);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(value->address_text());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AddressText)->DenseRange(0, 1);
+
+static void BM_AddressInetNtop(benchmark::State& state)
+{
+    auto value = avp::Address(family(state.range(0)), texts[state.range(0)]);
+    auto af = state.range(0) == 0 ? AF_INET : AF_INET6;
+
+    for (auto _ : state) {
+        char text[INET6_ADDRSTRLEN];
+        benchmark::DoNotOptimize(inet_ntop(af, value->value().data(), text, sizeof(text)));
+        auto string = std::string(text);
+        benchmark::DoNotOptimize(string);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AddressInetNtop)->DenseRange(0, 1);
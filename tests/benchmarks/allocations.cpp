@@ -0,0 +1,141 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+#include <netpacker/netpacker.h>
+
+#include <diameter/message/message.h>
+#include <diameter/serial/serial.h>
+
+#include "messages.h"
+
+// Allocations per encoded and decoded message. The message model allocates through std::pmr:
+// a counting memory resource is passed to the decoding, and installed as the default resource
+// around the encoding which takes none. Nothing is replaced globally, the other benchmarks of the
+// binary are not affected.
+
+namespace {
+
+class CountingResource : public std::pmr::memory_resource
+{
+public:
+    std::size_t allocations() const noexcept
+    {
+        return m_allocations;
+    }
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        ++m_allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+    {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    std::size_t m_allocations {0};
+};
+
+// The default resource for the lifetime of the guard
+class DefaultResource
+{
+public:
+    explicit DefaultResource(std::pmr::memory_resource* resource) noexcept
+        : m_previous(std::pmr::set_default_resource(resource))
+    {
+    }
+
+    DefaultResource(DefaultResource const&) = delete;
+    DefaultResource& operator= (DefaultResource const&) = delete;
+
+    ~DefaultResource()
+    {
+        std::pmr::set_default_resource(m_previous);
+    }
+
+private:
+    std::pmr::memory_resource* m_previous;
+};
+
+}
+
+using namespace diameter::message;
+
+// Message by index: 0 - CER, 1 - CCR, 2 - ULR, 3 - Grouped AVPs nested 8 levels deep
+static Message make_message(int64_t kind)
+{
+    return kind < 3 ? benchmarks::make_message(kind) : benchmarks::make_nested(8);
+}
+
+static void BM_EncodeAllocations(benchmark::State& state)
+{
+    auto msg = make_message(state.range(0));
+    auto data = std::vector<uint8_t>(msg.size());
+
+    CountingResource counting;
+    DefaultResource guard(&counting);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(netpacker::put(data.begin(), data.end(), msg));
+        benchmark::ClobberMemory();
+    }
+    auto count = counting.allocations();
+    state.counters["allocs_per_msg"] = benchmark::Counter(static_cast<double>(count),
+        benchmark::Counter::kAvgIterations);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EncodeAllocations)->DenseRange(0, 3);
+
+// Encoding every value through its OctetString form, the way values were encoded before
+static void BM_EncodeAllocationsViaOctetString(benchmark::State& state)
+{
+    auto msg = make_message(state.range(0));
+    auto data = std::vector<uint8_t>(msg.size());
+
+    CountingResource counting;
+    DefaultResource guard(&counting);
+    for (auto _ : state) {
+        auto pos = netpacker::put(data.begin(), data.end(), msg.header);
+        for (const auto& avp : msg.avps) {
+            auto raw = avp::AVP{avp.code, avp.flags, avp.vendor_id,
+                diameter::serial::avp::value_as<avp::OctetString>(avp.value)};
+            pos = netpacker::put(pos, data.end(), raw);
+        }
+        benchmark::DoNotOptimize(pos);
+    }
+    auto count = counting.allocations();
+    state.counters["allocs_per_msg"] = benchmark::Counter(static_cast<double>(count),
+        benchmark::Counter::kAvgIterations);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EncodeAllocationsViaOctetString)->DenseRange(0, 3);
+
+static void BM_DecodeAllocations(benchmark::State& state)
+{
+    auto msg = make_message(state.range(0));
+    auto data = std::vector<uint8_t>(msg.size());
+    netpacker::put(data.begin(), data.end(), msg);
+
+    CountingResource counting;
+    for (auto _ : state) {
+        auto pos = data.cbegin();
+        benchmark::DoNotOptimize(netpacker::get<Message>(pos, data.cend(), &counting));
+    }
+    auto count = counting.allocations();
+    state.counters["allocs_per_msg"] = benchmark::Counter(static_cast<double>(count),
+        benchmark::Counter::kAvgIterations);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DecodeAllocations)->DenseRange(0, 3);
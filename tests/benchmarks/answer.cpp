@@ -0,0 +1,64 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <vector>
+
+#include <diameter/application/base/avp.h>
+#include <diameter/serial/answer.h>
+#include <diameter/serial/serial.h>
+
+#include "messages.h"
+
+// The answer to a CCR derived by AnswerBuilder from the encoded request against an answer Message
+// built by hand from the decoded request and encoded
+
+using namespace diameter::message;
+
+namespace base = diameter::application::base;
+
+static void BM_AnswerBuilder(benchmark::State& state)
+{
+    auto data = benchmarks::encode(benchmarks::make_ccr());
+    diameter::serial::AnswerBuilder builder("ocs.epc.mnc001.mcc250.3gppnetwork.org",
+        "epc.mnc001.mcc250.3gppnetwork.org");
+    std::vector<uint8_t> out;
+    out.reserve(4096);
+
+    for (auto _ : state) {
+        out.clear();
+        auto request = diameter::serial::view::MessageView(data);
+        auto answer = builder.make_answer(request, base::ResultCodeV::Success, out)
+            .add<base::avp::AuthApplicationId>(uint32_t {4})
+            .finish();
+        benchmark::DoNotOptimize(answer.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_AnswerMessage(benchmark::State& state)
+{
+    auto data = benchmarks::encode(benchmarks::make_ccr());
+    std::vector<uint8_t> out;
+    out.reserve(4096);
+
+    for (auto _ : state) {
+        auto it = data.cbegin();
+        auto request = netpacker::get<Message>(it, data.cend());
+        Message answer {request.header, avp::AvpList {}};
+        answer.header.command_flags.reset(header::CommandFlag::Request);
+        answer.avps.push_back(request.avps.front());
+        answer.avps.push_back(base::avp::ResultCode::make(uint32_t {base::ResultCodeV::Success}));
+        answer.avps.push_back(base::avp::OriginHost::make(
+            avp::DiameterIdentity("ocs.epc.mnc001.mcc250.3gppnetwork.org")));
+        answer.avps.push_back(base::avp::OriginRealm::make(
+            avp::DiameterIdentity("epc.mnc001.mcc250.3gppnetwork.org")));
+        answer.avps.push_back(base::avp::AuthApplicationId::make(uint32_t {4}));
+        out.resize(answer.size());
+        netpacker::put(out.begin(), out.end(), answer);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_AnswerBuilder);
+BENCHMARK(BM_AnswerMessage);
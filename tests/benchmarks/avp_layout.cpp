@@ -0,0 +1,113 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <variant>
+#include <vector>
+
+#include <diameter/message/message.h>
+
+#include "messages.h"
+
+// Traversal of many decoded messages, more than the caches hold: the AVPs are read one cache line
+// each. The padded layout has the footprint of an AVP before the size budget (112 bytes).
+
+using namespace diameter::message;
+
+namespace {
+
+constexpr std::size_t padded_size = 112;
+
+struct PaddedAVP
+{
+    avp::AVP avp;
+    char padding[padded_size - sizeof(avp::AVP)];
+};
+
+uint64_t visit(const avp::AVP& avp);
+
+uint64_t visit(const avp::AvpList& avps)
+{
+    uint64_t sum = 0;
+    for (const auto& avp : avps) {
+        sum += visit(avp);
+    }
+    return sum;
+}
+
+uint64_t visit(const std::vector<PaddedAVP>& avps)
+{
+    uint64_t sum = 0;
+    for (const auto& padded : avps) {
+        sum += visit(padded.avp);
+    }
+    return sum;
+}
+
+uint64_t visit(const avp::AVP& avp)
+{
+    if (const auto* value = std::get_if<avp::Unsigned32>(&avp.value)) {
+        return **value;
+    }
+    if (const auto* value = std::get_if<avp::Grouped>(&avp.value)) {
+        return visit(**value);
+    }
+    return avp.code;
+}
+
+std::size_t count(const avp::AvpList& avps)
+{
+    auto result = avps.size();
+    for (const auto& avp : avps) {
+        if (const auto* value = std::get_if<avp::Grouped>(&avp.value)) {
+            result += count(**value);
+        }
+    }
+    return result;
+}
+
+}
+
+static void BM_AvpLayoutTraverse(benchmark::State& state)
+{
+    auto messages = std::vector<Message>(static_cast<std::size_t>(state.range(0)),
+        benchmarks::make_ccr());
+    auto avps = count(messages.front().avps);
+
+    for (auto _ : state) {
+        uint64_t sum = 0;
+        for (const auto& msg : messages) {
+            sum += visit(msg.avps);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * messages.size() * avps));
+    state.counters["sizeof(AVP)"] = static_cast<double>(sizeof(avp::AVP));
+    state.counters["sizeof(Value)"] = static_cast<double>(sizeof(avp::Value));
+}
+
+// Top level AVPs only: the grouped ones keep the compact layout
+static void BM_AvpLayoutTraversePadded(benchmark::State& state)
+{
+    auto msg = benchmarks::make_ccr();
+    auto messages = std::vector<std::vector<PaddedAVP>>(static_cast<std::size_t>(state.range(0)));
+    for (auto& avps : messages) {
+        for (const auto& avp : msg.avps) {
+            avps.push_back(PaddedAVP {avp, {}});
+        }
+    }
+    auto avps = count(msg.avps);
+
+    for (auto _ : state) {
+        uint64_t sum = 0;
+        for (const auto& padded : messages) {
+            sum += visit(padded);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * messages.size() * avps));
+    state.counters["sizeof(AVP)"] = static_cast<double>(sizeof(PaddedAVP));
+}
+
+// Argument: the number of CCR messages
+BENCHMARK(BM_AvpLayoutTraverse)->RangeMultiplier(16)->Range(16, 65536);
+BENCHMARK(BM_AvpLayoutTraversePadded)->RangeMultiplier(16)->Range(16, 65536);
@@ -0,0 +1,109 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <list>
+#include <vector>
+
+#include <netpacker/netpacker.h>
+
+#include <diameter/message/avp_index.h>
+#include <diameter/message/message.h>
+#include <diameter/serial/serial.h>
+
+#include "messages.h"
+
+// Compares std::list with the contiguous avp::AvpList for encoding, decoding and lookup of AVPs
+
+using namespace diameter::message;
+
+using ListStorage = std::list<avp::AVP>;
+using VectorStorage = avp::AvpList;
+
+template<typename Storage>
+static void BM_AvpStorageEncode(benchmark::State& state)
+{
+    auto msg = benchmarks::make_message(state.range(0));
+    auto avps = Storage(msg.avps.begin(), msg.avps.end());
+    auto data = std::vector<uint8_t>(msg.size());
+
+    for (auto _ : state) {
+        auto pos = netpacker::put(data.begin(), data.end(), msg.header);
+        for (const auto& avp : avps) {
+            pos = netpacker::put(pos, data.end(), avp);
+        }
+        benchmark::DoNotOptimize(pos);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+}
+
+template<typename Storage>
+static void BM_AvpStorageDecode(benchmark::State& state)
+{
+    auto data = benchmarks::encode(benchmarks::make_message(state.range(0)));
+
+    for (auto _ : state) {
+        auto pos = data.cbegin();
+        auto header = netpacker::get<header::Header>(pos, data.cend());
+        Storage avps;
+        while (pos != data.cend()) {
+            avps.emplace_back(netpacker::get<avp::AVP>(pos, data.cend()));
+        }
+        benchmark::DoNotOptimize(header);
+        benchmark::DoNotOptimize(avps);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+}
+
+template<typename Storage>
+static void BM_AvpStorageLookup(benchmark::State& state)
+{
+    auto msg = benchmarks::make_message(state.range(0));
+    auto avps = Storage(msg.avps.begin(), msg.avps.end());
+    // Session-Id, Origin-Host, Origin-Realm, Destination-Realm, Auth-Application-Id and a miss
+    const avp::Code codes[] = {263, 264, 296, 283, 258, 268};
+
+    for (auto _ : state) {
+        for (auto code : codes) {
+            auto it = std::find_if(avps.begin(), avps.end(), [code](const avp::AVP& avp) {
+                return avp.code == code;
+            });
+            benchmark::DoNotOptimize(it);
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * std::size(codes)));
+}
+
+static void BM_AvpIndexLookup(benchmark::State& state)
+{
+    auto msg = benchmarks::make_message(state.range(0));
+    auto index = AvpIndex(msg.avps);
+    const avp::Code codes[] = {263, 264, 296, 283, 258, 268};
+
+    for (auto _ : state) {
+        for (auto code : codes) {
+            benchmark::DoNotOptimize(index.find(code));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * std::size(codes)));
+}
+
+static void BM_AvpIndexBuild(benchmark::State& state)
+{
+    auto msg = benchmarks::make_message(state.range(0));
+    AvpIndex index;
+
+    for (auto _ : state) {
+        index.build(msg.avps);
+        benchmark::DoNotOptimize(index);
+    }
+}
+
+// Argument: 0 - CER, 1 - CCR, 2 - ULR
+BENCHMARK_TEMPLATE(BM_AvpStorageEncode, ListStorage)->DenseRange(0, 2);
+BENCHMARK_TEMPLATE(BM_AvpStorageEncode, VectorStorage)->DenseRange(0, 2);
+BENCHMARK_TEMPLATE(BM_AvpStorageDecode, ListStorage)->DenseRange(0, 2);
+BENCHMARK_TEMPLATE(BM_AvpStorageDecode, VectorStorage)->DenseRange(0, 2);
+BENCHMARK_TEMPLATE(BM_AvpStorageLookup, ListStorage)->DenseRange(0, 2);
+BENCHMARK_TEMPLATE(BM_AvpStorageLookup, VectorStorage)->DenseRange(0, 2);
+BENCHMARK(BM_AvpIndexLookup)->DenseRange(0, 2);
+BENCHMARK(BM_AvpIndexBuild)->DenseRange(0, 2);
@@ -0,0 +1,90 @@
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include <netpacker/netpacker.h>
+
+#include <diameter/message/message.h>
+#include <diameter/serial/serial.h>
+
+#include "messages.h"
+
+// One buffer holding state.range(0) back-to-back CCRs, as returned by a socket read
+
+using namespace diameter;
+
+static std::vector<uint8_t> make_stream(int64_t count)
+{
+    auto msg = benchmarks::encode(benchmarks::make_ccr());
+    std::vector<uint8_t> stream;
+    for (int64_t i = 0; i < count; ++i) {
+        stream.insert(stream.end(), msg.begin(), msg.end());
+    }
+    return stream;
+}
+
+// Message by message with netpacker::get
+static void BM_StreamDecodeSequential(benchmark::State& state)
+{
+    auto stream = make_stream(state.range(0));
+
+    for (auto _ : state) {
+        auto pos = stream.cbegin();
+        while (pos != stream.cend()) {
+            benchmark::DoNotOptimize(netpacker::get<message::Message>(pos, stream.cend()));
+        }
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * stream.size()));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Message by message with MessageView
+static void BM_StreamViewSequential(benchmark::State& state)
+{
+    auto stream = make_stream(state.range(0));
+
+    for (auto _ : state) {
+        auto data = message::ByteSpan(stream);
+        while (!data.empty()) {
+            auto view = serial::view::MessageView(data);
+            benchmark::DoNotOptimize(view);
+            data = data.subspan(view.length());
+        }
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * stream.size()));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Headers of all messages at once, then the views
+static void BM_StreamViewBatch(benchmark::State& state)
+{
+    auto stream = make_stream(state.range(0));
+    serial::FrameBatch batch;
+
+    for (auto _ : state) {
+        batch.scan(stream);
+        for (const auto& frame : batch) {
+            benchmark::DoNotOptimize(frame.view());
+        }
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * stream.size()));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Headers only, e.g. to dispatch messages to workers
+static void BM_StreamScanBatch(benchmark::State& state)
+{
+    auto stream = make_stream(state.range(0));
+    serial::FrameBatch batch;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(batch.scan(stream));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * stream.size()));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_StreamDecodeSequential)->Arg(1)->Arg(16)->Arg(128);
+BENCHMARK(BM_StreamViewSequential)->Arg(1)->Arg(16)->Arg(128);
+BENCHMARK(BM_StreamViewBatch)->Arg(1)->Arg(16)->Arg(128);
+BENCHMARK(BM_StreamScanBatch)->Arg(1)->Arg(16)->Arg(128);
@@ -0,0 +1,101 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <type_traits>
+
+#include <diameter/message/message.h>
+#include <diameter/serial/serial.h>
+
+#include "messages.h"
+
+// Every conversion supported by serial::avp::cast: from the OctetString a decoded AVP holds to
+// each type, and from each type to the OctetString it is encoded through
+
+using namespace diameter::message;
+using diameter::serial::avp::value_as;
+
+namespace {
+
+template<typename T>
+T sample()
+{
+    if constexpr (std::is_same_v<T, avp::OctetString>) {
+        return T(typename T::value_type{0x82, 0x52, 0xf0, 0x10, 0x00, 0x01, 0x52, 0xf0});
+    }
+    else if constexpr (std::is_arithmetic_v<typename T::value_type>) {
+        return T(typename T::value_type{42});
+    }
+    else if constexpr (std::is_same_v<T, avp::Address>) {
+        return T("10.10.10.1");
+    }
+    else if constexpr (std::is_same_v<T, avp::Time>) {
+        return T(uint32_t{0xe9f6d345});
+    }
+    else if constexpr (std::is_same_v<T, avp::UTF8String>) {
+        return T("pgw.epc.mnc001.mcc250.3gppnetwork.org;1096298391;1;2");
+    }
+    else if constexpr (std::is_same_v<T, avp::DiameterIdentity>) {
+        return T("pgw.epc.mnc001.mcc250.3gppnetwork.org");
+    }
+    else if constexpr (std::is_same_v<T, avp::DiameterURI>) {
+        return T("aaa://host.example.com:6666;transport=tcp");
+    }
+    else if constexpr (std::is_same_v<T, avp::Enumerated>) {
+        return T(1004);
+    }
+    else if constexpr (std::is_same_v<T, avp::IPFilterRule>) {
+        return T("permit out ip from 10.0.0.0/8 to any");
+    }
+    else {
+        // Multiple-Services-Credit-Control of the CCR
+        return std::get<avp::Grouped>(benchmarks::make_ccr().avps[11].value);
+    }
+}
+
+} // namespace
+
+template<typename To>
+static void BM_CastFromOctetString(benchmark::State& state)
+{
+    avp::Value value = value_as<avp::OctetString>(avp::Value(sample<To>()));
+    auto size = std::get<avp::OctetString>(value)->size();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(value_as<To>(value));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * size));
+    state.SetItemsProcessed(state.iterations());
+}
+
+template<typename From>
+static void BM_CastToOctetString(benchmark::State& state)
+{
+    avp::Value value = sample<From>();
+    auto size = value_as<avp::OctetString>(value)->size();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(value_as<avp::OctetString>(value));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * size));
+    state.SetItemsProcessed(state.iterations());
+}
+
+#define CAST_BENCHMARKS(T) \
+    BENCHMARK_TEMPLATE(BM_CastFromOctetString, avp::T); \
+    BENCHMARK_TEMPLATE(BM_CastToOctetString, avp::T)
+
+CAST_BENCHMARKS(OctetString);
+CAST_BENCHMARKS(Integer32);
+CAST_BENCHMARKS(Integer64);
+CAST_BENCHMARKS(Unsigned32);
+CAST_BENCHMARKS(Unsigned64);
+CAST_BENCHMARKS(Float32);
+CAST_BENCHMARKS(Float64);
+CAST_BENCHMARKS(Address);
+CAST_BENCHMARKS(Time);
+CAST_BENCHMARKS(UTF8String);
+CAST_BENCHMARKS(DiameterIdentity);
+CAST_BENCHMARKS(DiameterURI);
+CAST_BENCHMARKS(Enumerated);
+CAST_BENCHMARKS(IPFilterRule);
+CAST_BENCHMARKS(Grouped);
@@ -0,0 +1,168 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+#include <netpacker/netpacker.h>
+
+#include <diameter/message/message.h>
+#include <diameter/serial/serial.h>
+
+#include "messages.h"
+
+// Decoding of headers, AVPs and messages from a prepared buffer
+
+using namespace diameter::message;
+
+namespace {
+
+// Grouped AVPs of the CCR: Subscription-Id, Multiple-Services-Credit-Control,
+// Requested-Service-Unit, Used-Service-Unit, Service-Information, PS-Information
+constexpr std::array<avp::Code, 6> grouped_codes {443, 456, 437, 446, 873, 874};
+
+// Converts every Grouped AVP of the list, the way a reader of a nested AVP does it
+void expand(avp::AvpList& avps)
+{
+    for (auto& avp : avps) {
+        if (std::find(grouped_codes.begin(), grouped_codes.end(), avp.code) == grouped_codes.end()) {
+            continue;
+        }
+        auto grouped = diameter::serial::avp::value_as<avp::Grouped>(avp.value);
+        expand(*grouped);
+        avp.value = std::move(grouped);
+    }
+}
+
+} // namespace
+
+static void BM_DecodeHeader(benchmark::State& state)
+{
+    auto data = benchmarks::encode(benchmarks::make_cer());
+
+    for (auto _ : state) {
+        auto pos = data.cbegin();
+        benchmark::DoNotOptimize(netpacker::get<header::Header>(pos, data.cend()));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * header::Header{}.size()));
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DecodeHeader);
+
+// AVP kinds of benchmarks::make_avp(), plain and vendor-specific
+static void BM_DecodeAvp(benchmark::State& state)
+{
+    auto avp = benchmarks::make_avp(state.range(0));
+    auto data = std::vector<uint8_t>(avp.size());
+    netpacker::put(data.begin(), data.end(), avp);
+
+    for (auto _ : state) {
+        auto pos = data.cbegin();
+        benchmark::DoNotOptimize(netpacker::get<avp::AVP>(pos, data.cend()));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DecodeAvp)->DenseRange(0, 4);
+
+// CER, CCR and ULR with the default resource and with a per-message monotonic arena
+static void BM_DecodeMessage(benchmark::State& state)
+{
+    auto data = benchmarks::encode(benchmarks::make_message(state.range(0)));
+
+    for (auto _ : state) {
+        auto pos = data.cbegin();
+        benchmark::DoNotOptimize(netpacker::get<Message>(pos, data.cend()));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DecodeMessage)->DenseRange(0, 2);
+
+static void BM_DecodeMessageArena(benchmark::State& state)
+{
+    auto data = benchmarks::encode(benchmarks::make_message(state.range(0)));
+    auto buffer = std::vector<uint8_t>(16384);
+
+    for (auto _ : state) {
+        std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+        auto pos = data.cbegin();
+        benchmark::DoNotOptimize(netpacker::get<Message>(pos, data.cend(), &arena));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DecodeMessageArena)->DenseRange(0, 2);
+
+// Non-owning view of CER, CCR and ULR: validation of the AVP chain only
+static void BM_DecodeMessageView(benchmark::State& state)
+{
+    auto data = benchmarks::encode(benchmarks::make_message(state.range(0)));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(diameter::serial::view::MessageView(data));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DecodeMessageView)->DenseRange(0, 2);
+
+// Grouped AVPs nested state.range(0) levels deep, decoded and expanded down to the last level
+static void BM_DecodeNested(benchmark::State& state)
+{
+    auto data = benchmarks::encode(benchmarks::make_nested(state.range(0)));
+
+    for (auto _ : state) {
+        auto pos = data.cbegin();
+        auto msg = netpacker::get<Message>(pos, data.cend());
+        expand(msg.avps);
+        benchmark::DoNotOptimize(msg);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DecodeNested)->Arg(1)->Arg(4)->Arg(8)->Arg(16);
+
+// The CCR with its Multiple-Services-Credit-Control and Service-Information expanded
+static void BM_DecodeCcrGrouped(benchmark::State& state)
+{
+    auto data = benchmarks::encode(benchmarks::make_ccr());
+
+    for (auto _ : state) {
+        auto pos = data.cbegin();
+        auto msg = netpacker::get<Message>(pos, data.cend());
+        expand(msg.avps);
+        benchmark::DoNotOptimize(msg);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DecodeCcrGrouped);
+
+// Messages of state.range(0) bytes
+static void BM_DecodeSize(benchmark::State& state)
+{
+    auto data = benchmarks::encode(benchmarks::make_sized(state.range(0)));
+
+    for (auto _ : state) {
+        auto pos = data.cbegin();
+        benchmark::DoNotOptimize(netpacker::get<Message>(pos, data.cend()));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DecodeSize)->Arg(100)->RangeMultiplier(4)->Range(128, 65536);
+
+static void BM_DecodeSizeView(benchmark::State& state)
+{
+    auto data = benchmarks::encode(benchmarks::make_sized(state.range(0)));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(diameter::serial::view::MessageView(data));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DecodeSizeView)->Arg(100)->RangeMultiplier(4)->Range(128, 65536);
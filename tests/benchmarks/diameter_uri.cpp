@@ -0,0 +1,78 @@
+#include <benchmark/benchmark.h>
+
+#include <regex>
+#include <string>
+
+#include <diameter/message/avp/avp.h>
+
+// DiameterURI validation: the single pass parser against the regular expressions it replaced
+
+using namespace diameter::message;
+
+namespace {
+
+const char* const uris[] = {
+    "aaa://host.example.com",
+    "aaa://host.example.com:6666;transport=tcp",
+    "aaas://dra01.epc.mnc001.mcc250.3gppnetwork.org:5658;transport=sctp;protocol=diameter",
+};
+
+// The former DiameterURIBase::validate()
+bool regex_validate(const std::string& value)
+{
+    static const std::regex r1(
+        R"(^(aaa|aaas):\/\/([a-zA-Z0-9\-._~%!$&'()*+,=]+)(?::([0-9]+))?(?:;transport=(tcp|sctp|udp))?(?:;protocol=(diameter|radius|tacacs\+))?$)",
+        std::regex_constants::icase);
+    static const std::regex r2(
+        R"((?=^.{4,253}$)(^((?!-)[a-zA-Z0-9-]{0,62}[a-zA-Z0-9]\.)+[a-zA-Z]{2,63}$))");
+
+    std::smatch match;
+    if (!std::regex_match(value, match, r1)) {
+        return false;
+    }
+    std::string scheme = match[1].str();
+    std::string fqdn = match[2].str();
+    std::optional<uint32_t> port;
+    if (match[3].matched) {
+        port = static_cast<uint32_t>(std::atoi(match[3].str().c_str()));
+    }
+    std::optional<std::string> transport;
+    if (match[4].matched) {
+        transport = match[4].str();
+    }
+    std::optional<std::string> protocol;
+    if (match[5].matched) {
+        protocol = match[5].str();
+    }
+    benchmark::DoNotOptimize(scheme);
+    benchmark::DoNotOptimize(port);
+    benchmark::DoNotOptimize(transport);
+    benchmark::DoNotOptimize(protocol);
+    return std::regex_match(fqdn, r2);
+}
+
+}
+
+static void BM_DiameterUriParse(benchmark::State& state)
+{
+    auto value = avp::DiameterURI(uris[state.range(0)]);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(value->validate());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * value.size()));
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DiameterUriParse)->DenseRange(0, 2);
+
+static void BM_DiameterUriRegex(benchmark::State& state)
+{
+    auto value = std::string(uris[state.range(0)]);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(regex_validate(value));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * value.size()));
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DiameterUriRegex)->DenseRange(0, 2);
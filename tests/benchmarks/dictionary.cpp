@@ -0,0 +1,147 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <diameter/dictionary/dictionary.h>
+#include <diameter/message/message.h>
+#include <diameter/serial/serial.h>
+
+#include "messages.h"
+
+// Dictionary-aware decoding against the raw decoding followed by a value_as<T> pass over the
+// message with the types of the same dictionary; lookups of the perfect hash against
+// std::unordered_map
+
+using namespace diameter::message;
+using diameter::dictionary::AvpDefinition;
+using diameter::dictionary::AvpTypeV;
+using diameter::dictionary::Dictionary;
+
+namespace {
+
+// Definitions of all the AVPs of the message, the types are those of the values
+void collect(const avp::AvpList& avps, std::vector<AvpDefinition>& definitions)
+{
+    for (const auto& avp : avps) {
+        definitions.push_back(AvpDefinition {"", avp.code, avp.vendor_id.value_or(0),
+            static_cast<AvpTypeV::Value>(avp.value.index()), 0, {}, {}});
+        if (const auto* grouped = std::get_if<avp::Grouped>(&avp.value)) {
+            collect(**grouped, definitions);
+        }
+    }
+}
+
+Dictionary make_dictionary(const Message& msg)
+{
+    std::vector<AvpDefinition> definitions;
+    collect(msg.avps, definitions);
+    return Dictionary({}, std::move(definitions), {});
+}
+
+template<std::size_t I = 0>
+avp::Value convert(AvpTypeV::Value type, const avp::Value& value)
+{
+    if constexpr (I + 1 < std::variant_size_v<avp::Value>) {
+        if (type != I) {
+            return convert<I + 1>(type, value);
+        }
+    }
+    return diameter::serial::avp::value_as<std::variant_alternative_t<I, avp::Value>>(value);
+}
+
+// The second pass of the raw decoding: every value converted to the type of the dictionary
+void convert(const Dictionary& dictionary, avp::AvpList& avps)
+{
+    for (auto& avp : avps) {
+        const auto* definition = dictionary.find(avp.code, avp.vendor_id.value_or(0));
+        if (definition == nullptr) {
+            continue;
+        }
+        avp.value = convert(definition->type, avp.value);
+        if (auto* grouped = std::get_if<avp::Grouped>(&avp.value)) {
+            convert(dictionary, **grouped);
+        }
+    }
+}
+
+}
+
+static void BM_DictionaryDecode(benchmark::State& state)
+{
+    auto msg = benchmarks::make_message(state.range(0));
+    auto dictionary = make_dictionary(msg);
+    auto data = benchmarks::encode(msg);
+
+    for (auto _ : state) {
+        auto decoded = diameter::serial::try_decode(data, dictionary);
+        benchmark::DoNotOptimize(decoded);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+}
+
+static void BM_DictionaryDecodeConvert(benchmark::State& state)
+{
+    auto msg = benchmarks::make_message(state.range(0));
+    auto dictionary = make_dictionary(msg);
+    auto data = benchmarks::encode(msg);
+
+    for (auto _ : state) {
+        auto decoded = diameter::serial::try_decode(data);
+        convert(dictionary, decoded->avps);
+        benchmark::DoNotOptimize(decoded);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+}
+
+// A dictionary of the argument AVPs of a few vendors
+static std::vector<AvpDefinition> make_definitions(int64_t count)
+{
+    std::vector<AvpDefinition> definitions;
+    const avp::VendorId vendors[] = {0, 10415, 5535, 193};
+    for (int64_t i = 0; i < count; ++i) {
+        definitions.push_back(AvpDefinition {"", static_cast<avp::Code>(i / 4 + 1),
+            vendors[i % 4], AvpTypeV::OctetString, 0, {}, {}});
+    }
+    return definitions;
+}
+
+static void BM_DictionaryFind(benchmark::State& state)
+{
+    auto definitions = make_definitions(state.range(0));
+    auto dictionary = Dictionary({}, definitions, {});
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        const auto& definition = definitions[i++ % definitions.size()];
+        benchmark::DoNotOptimize(dictionary.find(definition.code, definition.vendor_id));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_DictionaryFindUnorderedMap(benchmark::State& state)
+{
+    auto definitions = make_definitions(state.range(0));
+    std::unordered_map<uint64_t, const AvpDefinition*> map;
+    for (const auto& definition : definitions) {
+        map.emplace(uint64_t {definition.vendor_id} << 32 | definition.code, &definition);
+    }
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        const auto& definition = definitions[i++ % definitions.size()];
+        auto it = map.find(uint64_t {definition.vendor_id} << 32 | definition.code);
+        benchmark::DoNotOptimize(it->second);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Argument: 0 - CER, 1 - CCR, 2 - ULR
+BENCHMARK(BM_DictionaryDecode)->DenseRange(0, 2);
+BENCHMARK(BM_DictionaryDecodeConvert)->DenseRange(0, 2);
+// Argument: the number of AVP definitions
+BENCHMARK(BM_DictionaryFind)->Arg(64)->Arg(4096);
+BENCHMARK(BM_DictionaryFindUnorderedMap)->Arg(64)->Arg(4096);
@@ -0,0 +1,138 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <vector>
+
+#include <netpacker/netpacker.h>
+
+#include <diameter/application/base/avp.h>
+#include <diameter/message/message.h>
+#include <diameter/serial/serial.h>
+
+#include "messages.h"
+
+// Encoding of pre-built headers, AVPs and messages: only serialization is timed
+
+using namespace diameter::message;
+
+static void BM_EncodeHeader(benchmark::State& state)
+{
+    auto header = benchmarks::make_header(257, 0);
+    auto data = std::vector<uint8_t>(header.size());
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(netpacker::put(data.begin(), data.end(), header));
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EncodeHeader);
+
+// AVP kinds of benchmarks::make_avp(), plain and vendor-specific
+static void BM_EncodeAvp(benchmark::State& state)
+{
+    auto avp = benchmarks::make_avp(state.range(0));
+    auto data = std::vector<uint8_t>(avp.size());
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(netpacker::put(data.begin(), data.end(), avp));
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EncodeAvp)->DenseRange(0, 4);
+
+// The same AVPs encoded through their compile time definitions
+template<typename Def>
+static void BM_EncodeAvpDef(benchmark::State& state)
+{
+    auto value = typename Def::value_type(std::get<typename Def::value_type>(
+        benchmarks::make_avp(state.range(0)).value));
+    auto data = std::vector<uint8_t>(Def::make(value).size());
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(diameter::serial::avp::put<Def>(data.begin(), data.end(), value));
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_EncodeAvpDef, diameter::application::base::avp::AuthApplicationId)->Arg(0);
+BENCHMARK_TEMPLATE(BM_EncodeAvpDef, diameter::application::base::avp::SessionId)->Arg(1);
+BENCHMARK_TEMPLATE(BM_EncodeAvpDef, avp::AvpDef<1405, benchmarks::tgpp, avp::Unsigned32>)->Arg(2);
+
+// CER, CCR and ULR
+static void BM_EncodeMessage(benchmark::State& state)
+{
+    auto msg = benchmarks::make_message(state.range(0));
+    auto data = std::vector<uint8_t>(msg.size());
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(netpacker::put(data.begin(), data.end(), msg));
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EncodeMessage)->DenseRange(0, 2);
+
+// Message::size() followed by encoding, what a sender does for every message
+static void BM_EncodeMessageSized(benchmark::State& state)
+{
+    auto msg = benchmarks::make_message(state.range(0));
+    auto data = std::vector<uint8_t>(msg.size());
+
+    for (auto _ : state) {
+        auto size = msg.size();
+        benchmark::DoNotOptimize(netpacker::put(data.begin(), data.begin() + size, msg));
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EncodeMessageSized)->DenseRange(0, 2);
+
+// Grouped AVPs nested state.range(0) levels deep
+static void BM_EncodeNested(benchmark::State& state)
+{
+    auto msg = benchmarks::make_nested(state.range(0));
+    auto data = std::vector<uint8_t>(msg.size());
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(netpacker::put(data.begin(), data.end(), msg));
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EncodeNested)->Arg(1)->Arg(4)->Arg(8)->Arg(16);
+
+// Messages of state.range(0) bytes
+static void BM_EncodeSize(benchmark::State& state)
+{
+    auto msg = benchmarks::make_sized(state.range(0));
+    auto data = std::vector<uint8_t>(msg.size());
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(netpacker::put(data.begin(), data.end(), msg));
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EncodeSize)->Arg(100)->RangeMultiplier(4)->Range(128, 65536);
+
+// Building the CER and encoding it, the cost of a message created from scratch
+static void BM_MessageSerial(benchmark::State& state)
+{
+    for (auto _ : state) {
+        auto msg = benchmarks::make_cer();
+        auto data = std::vector<uint8_t>(msg.size());
+        benchmark::DoNotOptimize(netpacker::put(data.begin(), data.end(), msg));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * benchmarks::make_cer().size()));
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MessageSerial);
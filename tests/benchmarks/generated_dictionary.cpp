@@ -0,0 +1,101 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <vector>
+
+#include <diameter/dictionaries/dcca.h>
+#include <diameter/dictionary/xml.h>
+#include <diameter/serial/serial.h>
+
+#include "messages.h"
+
+// The credit control dictionary compiled in by diameter_dictgen against the same dictionary
+// loaded from XML: the startup cost of loading, the lookups and the typed decoding of a CCR
+
+using namespace diameter::message;
+using diameter::dictionary::Dictionary;
+
+namespace dcca = diameter::dictionaries::dcca;
+
+namespace {
+
+Dictionary load_dcca()
+{
+    diameter::dictionary::XmlLoader loader;
+    loader.load_file(DIAMETER_DICTIONARIES_DIR "/base.xml");
+    loader.load_file(DIAMETER_DICTIONARIES_DIR "/dcca.xml");
+    return loader.dictionary();
+}
+
+// Code and vendor id of every AVP of the message, nested AVPs included
+void collect(const avp::AvpList& avps, std::vector<std::pair<avp::Code, avp::VendorId>>& keys)
+{
+    for (const auto& avp : avps) {
+        keys.emplace_back(avp.code, avp.vendor_id.value_or(0));
+        if (const auto* grouped = std::get_if<avp::Grouped>(&avp.value)) {
+            collect(**grouped, keys);
+        }
+    }
+}
+
+}
+
+static void BM_DictionaryLoadXml(benchmark::State& state)
+{
+    for (auto _ : state) {
+        auto dictionary = load_dcca();
+        benchmark::DoNotOptimize(dictionary);
+    }
+}
+
+template<typename D>
+static void find(benchmark::State& state, const D& dictionary)
+{
+    std::vector<std::pair<avp::Code, avp::VendorId>> keys;
+    collect(benchmarks::make_ccr().avps, keys);
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        const auto& [code, vendor_id] = keys[i++ % keys.size()];
+        benchmark::DoNotOptimize(dictionary.find(code, vendor_id));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_GeneratedDictionaryFind(benchmark::State& state)
+{
+    find(state, dcca::Dictionary {});
+}
+
+static void BM_LoadedDictionaryFind(benchmark::State& state)
+{
+    find(state, load_dcca());
+}
+
+template<typename D>
+static void decode(benchmark::State& state, const D& dictionary)
+{
+    auto data = benchmarks::encode(benchmarks::make_ccr());
+
+    for (auto _ : state) {
+        auto decoded = diameter::serial::try_decode(data, dictionary);
+        benchmark::DoNotOptimize(decoded);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+}
+
+static void BM_GeneratedDictionaryDecode(benchmark::State& state)
+{
+    decode(state, dcca::Dictionary {});
+}
+
+static void BM_LoadedDictionaryDecode(benchmark::State& state)
+{
+    decode(state, load_dcca());
+}
+
+BENCHMARK(BM_DictionaryLoadXml);
+BENCHMARK(BM_GeneratedDictionaryFind);
+BENCHMARK(BM_LoadedDictionaryFind);
+BENCHMARK(BM_GeneratedDictionaryDecode);
+BENCHMARK(BM_LoadedDictionaryDecode);
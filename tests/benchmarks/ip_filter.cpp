@@ -0,0 +1,117 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include <diameter/application/ip_filter_set.h>
+
+// Classification of packets against state.range(0) Flow-Description like rules: the compiled
+// IPFilterSet against matching the rules one by one, and parsing of the rules
+
+using namespace diameter;
+using namespace diameter::message::avp::value;
+
+namespace {
+
+// Per-subscriber rules: a server prefix, a port or a port range, about half are TCP
+std::vector<std::string> make_rules(std::size_t count)
+{
+    std::mt19937 rng(1);
+    std::vector<std::string> rules;
+    for (std::size_t i = 0; i < count; ++i) {
+        auto port = 1024 + rng() % 60000;
+        rules.push_back(std::string(rng() % 2 ? "permit" : "deny") + (rng() % 2 ? " out " : " in ")
+            + (rng() % 2 ? "tcp" : "udp") + " from assigned to 10." + std::to_string(rng() % 256)
+            + "." + std::to_string(rng() % 256) + ".0/" + std::to_string(16 + rng() % 9) + " "
+            + std::to_string(port) + (rng() % 4 == 0 ? "-" + std::to_string(port + 100) : ""));
+    }
+    rules.push_back("deny out ip from any to any");
+    rules.push_back("deny in ip from any to any");
+    return rules;
+}
+
+std::vector<IPFilter> make_filters(std::size_t count)
+{
+    std::vector<IPFilter> filters;
+    for (const auto& rule : make_rules(count)) {
+        filters.push_back(IPFilter::parse(rule).value());
+    }
+    return filters;
+}
+
+std::vector<IPFilterPacket> make_packets()
+{
+    std::mt19937 rng(2);
+    std::vector<IPFilterPacket> packets(1024);
+    for (auto& packet : packets) {
+        packet.direction = static_cast<uint8_t>(rng() % 2);
+        packet.src = IPFilterAddress::parse("10.200.0.1").value();
+        packet.dst = IPFilterAddress::parse("10." + std::to_string(rng() % 256) + "."
+            + std::to_string(rng() % 256) + "." + std::to_string(rng() % 256)).value();
+        packet.protocol = rng() % 2 ? IPProtocolV::Tcp : IPProtocolV::Udp;
+        packet.src_port = static_cast<uint16_t>(rng());
+        packet.dst_port = static_cast<uint16_t>(1024 + rng() % 60000);
+    }
+    return packets;
+}
+
+const std::vector<IPFilterAddress> assigned = {IPFilterAddress::parse("10.200.0.1").value()};
+
+}
+
+static void BM_IPFilterSet(benchmark::State& state)
+{
+    application::IPFilterSet set(make_filters(static_cast<std::size_t>(state.range(0))), assigned);
+    auto packets = make_packets();
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(set.match(packets[i++ % packets.size()]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_IPFilterSet)->RangeMultiplier(4)->Range(64, 4096);
+
+static void BM_IPFilterLinear(benchmark::State& state)
+{
+    auto filters = make_filters(static_cast<std::size_t>(state.range(0)));
+    auto packets = make_packets();
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        const auto& packet = packets[i++ % packets.size()];
+        for (const auto& filter : filters) {
+            if (filter.matches(packet, assigned)) {
+                benchmark::DoNotOptimize(&filter);
+                break;
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_IPFilterLinear)->RangeMultiplier(4)->Range(64, 4096);
+
+static void BM_IPFilterParse(benchmark::State& state)
+{
+    auto rules = make_rules(256);
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(IPFilter::parse(rules[i++ % rules.size()]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_IPFilterParse);
+
+static void BM_IPFilterSetBuild(benchmark::State& state)
+{
+    auto filters = make_filters(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        application::IPFilterSet set(filters, assigned);
+        benchmark::DoNotOptimize(set.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_IPFilterSetBuild)->Arg(1024);
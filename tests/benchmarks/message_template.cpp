@@ -0,0 +1,64 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include <netpacker/netpacker.h>
+
+#include <diameter/message/message.h>
+#include <diameter/serial/serial.h>
+
+#include "messages.h"
+
+// Producing CCAs which differ in the identifiers, Session-Id and CC-Time: built and encoded from
+// scratch, and instantiated from a MessageTemplate
+
+using namespace diameter;
+
+static const char* const session_ids[] = {
+    "pgw.epc.mnc001.mcc250.3gppnetwork.org;1096298391;1;2",
+    "pgw.epc.mnc001.mcc250.3gppnetwork.org;1096298391;1;20",
+    "pgw.epc.mnc001.mcc250.3gppnetwork.org;1096298391;1;200",
+};
+
+static void BM_TemplateEncodeMessage(benchmark::State& state)
+{
+    uint32_t i = 0;
+    std::size_t bytes = 0;
+    for (auto _ : state) {
+        auto msg = benchmarks::make_cca(session_ids[i % 3]);
+        msg.header.hop_by_hop = i;
+        msg.header.end_to_end = i;
+        auto data = std::vector<uint8_t>(msg.size());
+        benchmark::DoNotOptimize(netpacker::put(data.begin(), data.end(), msg));
+        bytes += data.size();
+        ++i;
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(bytes));
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TemplateEncodeMessage);
+
+static void BM_TemplateInstantiate(benchmark::State& state)
+{
+    serial::MessageTemplate cca(benchmarks::make_cca());
+    auto session_id = cca.field(263);
+    auto cc_time = cca.field(cca.field(cca.field(456), 431), 420);
+    serial::TemplateInstance instance;
+
+    uint32_t i = 0;
+    std::size_t bytes = 0;
+    for (auto _ : state) {
+        cca.instantiate(instance)
+            .hop_by_hop(i)
+            .end_to_end(i)
+            .set(session_id, std::string_view(session_ids[i % 3]))
+            .set(cc_time, i);
+        benchmark::DoNotOptimize(instance.data().data());
+        bytes += instance.size();
+        ++i;
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(bytes));
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TemplateInstantiate);
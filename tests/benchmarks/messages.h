@@ -0,0 +1,265 @@
+#ifndef DIAMETER_TESTS_BENCHMARKS_MESSAGES_H
+#define DIAMETER_TESTS_BENCHMARKS_MESSAGES_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <netpacker/netpacker.h>
+
+#include <diameter/message/message.h>
+#include <diameter/serial/serial.h>
+
+// Realistic messages for benchmarks
+
+namespace benchmarks {
+
+using namespace diameter::message;
+
+inline constexpr avp::VendorId tgpp = 10415;
+
+inline avp::Flags mandatory()
+{
+    return avp::Flags {avp::Flag::Mandatory};
+}
+
+inline avp::Flags vendor_mandatory()
+{
+    return avp::Flags {avp::Flag::Mandatory} | avp::Flags {avp::Flag::VendorSpecific};
+}
+
+inline header::Header make_header(header::CommandCode code, header::ApplicationId application_id)
+{
+    return header::Header {
+        header::ProtocolVersion{header::ProtocolVersionV::V01},
+        header::MessageLength{0},
+        header::CommandFlags{0xc0},
+        code,
+        application_id,
+        header::HopByHopIdentifier{0x6ad1d314},
+        header::EndToEndIdentifier{0x77287404}
+    };
+}
+
+// Capabilities-Exchange-Request, RFC 6733
+inline Message make_cer()
+{
+    Message msg {
+        make_header(257, 0),
+        avp::AvpList{
+            avp::AVP{264, mandatory(), std::nullopt, avp::DiameterIdentity("testhost.epc.mnc000.mcc000.3gppnetwork.org")},
+            avp::AVP{296, mandatory(), std::nullopt, avp::DiameterIdentity("epc.mnc000.mcc000.3gppnetwork.org")},
+            avp::AVP{257, mandatory(), std::nullopt, avp::Address("127.0.0.1")},
+            avp::AVP{266, mandatory(), std::nullopt, avp::Unsigned32(uint32_t{10415})},
+            avp::AVP{269, avp::Flags{}, std::nullopt, avp::UTF8String("ExampleProduct")},
+            avp::AVP{258, mandatory(), std::nullopt, avp::Unsigned32(uint32_t{4})},
+            avp::AVP{265, mandatory(), std::nullopt, avp::Unsigned32(uint32_t{10415})}
+        }
+    };
+    msg.size();
+    return msg;
+}
+
+// Credit-Control-Request (Gy), RFC 4006 and 3GPP TS 32.299
+inline Message make_ccr()
+{
+    auto subscription_id = avp::AvpList{
+        avp::AVP{450, mandatory(), std::nullopt, avp::Enumerated(0)},
+        avp::AVP{444, mandatory(), std::nullopt, avp::UTF8String("79001234567")}
+    };
+    auto requested_service_unit = avp::AvpList{
+        avp::AVP{421, mandatory(), std::nullopt, avp::Unsigned64(uint64_t{10485760})}
+    };
+    auto used_service_unit = avp::AvpList{
+        avp::AVP{420, mandatory(), std::nullopt, avp::Unsigned32(uint32_t{360})},
+        avp::AVP{412, mandatory(), std::nullopt, avp::Unsigned64(uint64_t{524288})},
+        avp::AVP{414, mandatory(), std::nullopt, avp::Unsigned64(uint64_t{4194304})}
+    };
+    auto mscc = avp::AvpList{
+        avp::AVP{437, mandatory(), std::nullopt, avp::Grouped(requested_service_unit)},
+        avp::AVP{446, mandatory(), std::nullopt, avp::Grouped(used_service_unit)},
+        avp::AVP{432, mandatory(), std::nullopt, avp::Unsigned32(uint32_t{100})},
+        avp::AVP{439, mandatory(), std::nullopt, avp::Unsigned32(uint32_t{1})}
+    };
+    auto ps_information = avp::AvpList{
+        avp::AVP{2, vendor_mandatory(), tgpp, avp::UTF8String("01234567")},
+        avp::AVP{1247, vendor_mandatory(), tgpp, avp::Address("10.10.10.1")},
+        avp::AVP{1004, vendor_mandatory(), tgpp, avp::Address("192.168.0.1")},
+        avp::AVP{18, vendor_mandatory(), tgpp, avp::UTF8String("25001")},
+        avp::AVP{30, vendor_mandatory(), tgpp, avp::UTF8String("internet.mnc001.mcc250.gprs")},
+        avp::AVP{21, vendor_mandatory(), tgpp, avp::OctetString(avp::OctetString::value_type{0x06})},
+        avp::AVP{22, vendor_mandatory(), tgpp, avp::OctetString(avp::OctetString::value_type{
+            0x82, 0x52, 0xf0, 0x10, 0x00, 0x01, 0x52, 0xf0, 0x10, 0x00, 0x00, 0x00, 0x01})}
+    };
+    auto service_information = avp::AvpList{
+        avp::AVP{874, vendor_mandatory(), tgpp, avp::Grouped(ps_information)}
+    };
+
+    Message msg {
+        make_header(272, 4),
+        avp::AvpList{
+            avp::AVP{263, mandatory(), std::nullopt, avp::UTF8String("pgw.epc.mnc001.mcc250.3gppnetwork.org;1096298391;1;2")},
+            avp::AVP{264, mandatory(), std::nullopt, avp::DiameterIdentity("pgw.epc.mnc001.mcc250.3gppnetwork.org")},
+            avp::AVP{296, mandatory(), std::nullopt, avp::DiameterIdentity("epc.mnc001.mcc250.3gppnetwork.org")},
+            avp::AVP{283, mandatory(), std::nullopt, avp::DiameterIdentity("ocs.mnc001.mcc250.3gppnetwork.org")},
+            avp::AVP{258, mandatory(), std::nullopt, avp::Unsigned32(uint32_t{4})},
+            avp::AVP{461, mandatory(), std::nullopt, avp::UTF8String("32251@3gpp.org")},
+            avp::AVP{416, mandatory(), std::nullopt, avp::Enumerated(2)},
+            avp::AVP{415, mandatory(), std::nullopt, avp::Unsigned32(uint32_t{1})},
+            avp::AVP{55, mandatory(), std::nullopt, avp::Time(uint32_t{0xe9f6d345})},
+            avp::AVP{443, mandatory(), std::nullopt, avp::Grouped(subscription_id)},
+            avp::AVP{455, mandatory(), std::nullopt, avp::Enumerated(1)},
+            avp::AVP{456, mandatory(), std::nullopt, avp::Grouped(mscc)},
+            avp::AVP{873, vendor_mandatory(), tgpp, avp::Grouped(service_information)}
+        }
+    };
+    msg.size();
+    return msg;
+}
+
+// Update-Location-Request (S6a), 3GPP TS 29.272
+inline Message make_ulr()
+{
+    auto vendor_specific_application_id = avp::AvpList{
+        avp::AVP{266, mandatory(), std::nullopt, avp::Unsigned32(uint32_t{10415})},
+        avp::AVP{258, mandatory(), std::nullopt, avp::Unsigned32(uint32_t{16777251})}
+    };
+    auto supported_features = avp::AvpList{
+        avp::AVP{266, mandatory(), std::nullopt, avp::Unsigned32(uint32_t{10415})},
+        avp::AVP{629, vendor_mandatory(), tgpp, avp::Unsigned32(uint32_t{1})},
+        avp::AVP{630, vendor_mandatory(), tgpp, avp::Unsigned32(uint32_t{0x1c000607})}
+    };
+
+    Message msg {
+        make_header(316, 16777251),
+        avp::AvpList{
+            avp::AVP{263, mandatory(), std::nullopt, avp::UTF8String("mme.epc.mnc001.mcc250.3gppnetwork.org;1;2;3")},
+            avp::AVP{260, mandatory(), std::nullopt, avp::Grouped(vendor_specific_application_id)},
+            avp::AVP{277, mandatory(), std::nullopt, avp::Enumerated(1)},
+            avp::AVP{264, mandatory(), std::nullopt, avp::DiameterIdentity("mme.epc.mnc001.mcc250.3gppnetwork.org")},
+            avp::AVP{296, mandatory(), std::nullopt, avp::DiameterIdentity("epc.mnc001.mcc250.3gppnetwork.org")},
+            avp::AVP{283, mandatory(), std::nullopt, avp::DiameterIdentity("epc.mnc001.mcc250.3gppnetwork.org")},
+            avp::AVP{1, mandatory(), std::nullopt, avp::UTF8String("250011234567890")},
+            avp::AVP{628, vendor_mandatory(), tgpp, avp::Grouped(supported_features)},
+            avp::AVP{1032, vendor_mandatory(), tgpp, avp::Enumerated(1004)},
+            avp::AVP{1405, vendor_mandatory(), tgpp, avp::Unsigned32(uint32_t{0x22})},
+            avp::AVP{1407, vendor_mandatory(), tgpp, avp::OctetString(avp::OctetString::value_type{0x52, 0xf0, 0x10})}
+        }
+    };
+    msg.size();
+    return msg;
+}
+
+// Credit-Control-Answer (Gy) to the CCR, RFC 4006 and 3GPP TS 32.299
+inline Message make_cca(const char* session_id = "pgw.epc.mnc001.mcc250.3gppnetwork.org;1096298391;1;2")
+{
+    auto granted_service_unit = avp::AvpList{
+        avp::AVP{420, mandatory(), std::nullopt, avp::Unsigned32(uint32_t{3600})},
+        avp::AVP{421, mandatory(), std::nullopt, avp::Unsigned64(uint64_t{10485760})}
+    };
+    auto mscc = avp::AvpList{
+        avp::AVP{431, mandatory(), std::nullopt, avp::Grouped(granted_service_unit)},
+        avp::AVP{432, mandatory(), std::nullopt, avp::Unsigned32(uint32_t{100})},
+        avp::AVP{448, mandatory(), std::nullopt, avp::Unsigned32(uint32_t{3600})},
+        avp::AVP{268, mandatory(), std::nullopt, avp::Unsigned32(uint32_t{2001})}
+    };
+
+    auto header = make_header(272, 4);
+    header.command_flags = header::CommandFlags{0x40};
+    Message msg {
+        header,
+        avp::AvpList{
+            avp::AVP{263, mandatory(), std::nullopt, avp::UTF8String(session_id)},
+            avp::AVP{268, mandatory(), std::nullopt, avp::Unsigned32(uint32_t{2001})},
+            avp::AVP{264, mandatory(), std::nullopt, avp::DiameterIdentity("ocs.mnc001.mcc250.3gppnetwork.org")},
+            avp::AVP{296, mandatory(), std::nullopt, avp::DiameterIdentity("mnc001.mcc250.3gppnetwork.org")},
+            avp::AVP{258, mandatory(), std::nullopt, avp::Unsigned32(uint32_t{4})},
+            avp::AVP{416, mandatory(), std::nullopt, avp::Enumerated(2)},
+            avp::AVP{415, mandatory(), std::nullopt, avp::Unsigned32(uint32_t{1})},
+            avp::AVP{456, mandatory(), std::nullopt, avp::Grouped(mscc)}
+        }
+    };
+    msg.size();
+    return msg;
+}
+
+// Message by index, to be used with benchmark arguments: 0 - CER, 1 - CCR, 2 - ULR
+inline Message make_message(int64_t kind)
+{
+    switch (kind) {
+        case 0:
+            return make_cer();
+        case 1:
+            return make_ccr();
+        default:
+            return make_ulr();
+    }
+}
+
+// Single AVP by index, to be used with benchmark arguments: 0 - Unsigned32, 1 - UTF8String
+// (Session-Id), 2 - vendor-specific Unsigned32, 3 - vendor-specific OctetString, 4 - Grouped
+// (Multiple-Services-Credit-Control)
+inline avp::AVP make_avp(int64_t kind)
+{
+    switch (kind) {
+        case 0:
+            return avp::AVP{258, mandatory(), std::nullopt, avp::Unsigned32(uint32_t{4})};
+        case 1:
+            return avp::AVP{263, mandatory(), std::nullopt,
+                avp::UTF8String("pgw.epc.mnc001.mcc250.3gppnetwork.org;1096298391;1;2")};
+        case 2:
+            return avp::AVP{1405, vendor_mandatory(), tgpp, avp::Unsigned32(uint32_t{0x22})};
+        case 3:
+            return avp::AVP{22, vendor_mandatory(), tgpp, avp::OctetString(avp::OctetString::value_type{
+                0x82, 0x52, 0xf0, 0x10, 0x00, 0x01, 0x52, 0xf0, 0x10, 0x00, 0x00, 0x00, 0x01})};
+        default:
+            return make_ccr().avps[11];
+    }
+}
+
+// Grouped AVPs nested `levels` deep, every level holding a Unsigned32 AVP
+inline Message make_nested(int64_t levels)
+{
+    auto nested = avp::AvpList{avp::AVP{432, mandatory(), std::nullopt, avp::Unsigned32(uint32_t{1})}};
+    for (int64_t level = 0; level < levels; ++level) {
+        nested = avp::AvpList{
+            avp::AVP{456, mandatory(), std::nullopt, avp::Grouped(std::move(nested))},
+            avp::AVP{432, mandatory(), std::nullopt, avp::Unsigned32(uint32_t{1})}
+        };
+    }
+    Message msg {make_header(272, 4), std::move(nested)};
+    msg.size();
+    return msg;
+}
+
+// Message of exactly `size` bytes (a multiple of 4, at least 40): a Session-Id followed by
+// OctetString AVPs of up to 1 KB, the shape of messages carrying EAP payloads or User-Data
+inline Message make_sized(int64_t size)
+{
+    Message msg {
+        make_header(272, 4),
+        avp::AvpList{
+            avp::AVP{263, mandatory(), std::nullopt, avp::UTF8String("sized;1;2")}
+        }
+    };
+    auto remaining = static_cast<std::size_t>(size) - msg.size();
+    while (remaining >= 12) {
+        auto payload = std::min<std::size_t>(remaining - 12, 1024);
+        msg.avps.push_back(avp::AVP{
+            1, vendor_mandatory(), tgpp, avp::OctetString(avp::OctetString::value_type(payload, 0x5a))});
+        remaining -= payload + 12;
+    }
+    msg.size();
+    return msg;
+}
+
+inline std::vector<uint8_t> encode(Message msg)
+{
+    auto data = std::vector<uint8_t>(msg.size());
+    netpacker::put(data.begin(), data.end(), msg);
+    return data;
+}
+
+} // namespace benchmarks
+
+#endif
@@ -0,0 +1,77 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <vector>
+
+#include <diameter/dictionaries/dcca.h>
+#include <diameter/serial/record.h>
+#include <diameter/serial/serial.h>
+
+#include "messages.h"
+
+// A CCR decoded into and encoded from the generated record against the Message decoded and
+// encoded through the generated dictionary
+
+using namespace diameter::message;
+
+namespace dcca = diameter::dictionaries::dcca;
+namespace record = diameter::serial::record;
+
+static void BM_RecordDecode(benchmark::State& state)
+{
+    auto data = benchmarks::encode(benchmarks::make_ccr());
+    dcca::record::CreditControlRequest ccr;
+    if (record::try_decode(data, ccr)) {
+        state.SkipWithError("invalid CCR");
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(record::try_decode(data, ccr));
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+}
+
+static void BM_MessageDecode(benchmark::State& state)
+{
+    auto data = benchmarks::encode(benchmarks::make_ccr());
+
+    for (auto _ : state) {
+        auto decoded = diameter::serial::try_decode(data, dcca::Dictionary {});
+        benchmark::DoNotOptimize(decoded);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+}
+
+static void BM_RecordEncode(benchmark::State& state)
+{
+    auto data = benchmarks::encode(benchmarks::make_ccr());
+    auto ccr = record::decode<dcca::record::CreditControlRequest>(data);
+    std::vector<uint8_t> out;
+
+    for (auto _ : state) {
+        out.clear();
+        record::encode(ccr, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * out.size()));
+}
+
+static void BM_MessageEncode(benchmark::State& state)
+{
+    auto data = benchmarks::encode(benchmarks::make_ccr());
+    auto msg = diameter::serial::decode(data, dcca::Dictionary {});
+    std::vector<uint8_t> out;
+
+    for (auto _ : state) {
+        out.resize(msg.size());
+        netpacker::put(out.begin(), out.end(), msg);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * out.size()));
+}
+
+BENCHMARK(BM_RecordDecode);
+BENCHMARK(BM_MessageDecode);
+BENCHMARK(BM_RecordEncode);
+BENCHMARK(BM_MessageEncode);
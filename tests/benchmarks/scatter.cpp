@@ -0,0 +1,42 @@
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include <netpacker/netpacker.h>
+
+#include <diameter/message/message.h>
+#include <diameter/serial/serial.h>
+
+#include "messages.h"
+
+// Messages of state.range(0) bytes made of 1 KB OctetString AVPs, encoded into one contiguous
+// buffer and into an iovec list referencing the payloads
+
+using namespace diameter;
+
+static void BM_ScatterContiguous(benchmark::State& state)
+{
+    auto msg = benchmarks::make_sized(state.range(0));
+
+    for (auto _ : state) {
+        auto data = std::vector<uint8_t>(msg.size());
+        benchmark::DoNotOptimize(netpacker::put(data.begin(), data.end(), msg));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * msg.size()));
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ScatterContiguous)->RangeMultiplier(4)->Range(1024, 65536);
+
+static void BM_ScatterIovec(benchmark::State& state)
+{
+    auto msg = benchmarks::make_sized(state.range(0));
+    serial::ScatterEncoder encoder;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(encoder.encode(msg).data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * msg.size()));
+    state.SetItemsProcessed(state.iterations());
+    state.counters["copied"] = static_cast<double>(encoder.copied());
+}
+BENCHMARK(BM_ScatterIovec)->RangeMultiplier(4)->Range(1024, 65536);
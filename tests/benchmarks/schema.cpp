@@ -0,0 +1,64 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+
+#include <diameter/dictionaries/s6a.h>
+#include <diameter/dictionary/schema.h>
+
+#include "messages.h"
+
+// Validation of a ULR against the grammar of the Update-Location command: the single pass of
+// dictionary::validate() against a scan of the AVPs for every rule of the grammar
+
+using namespace diameter::message;
+using diameter::dictionary::CommandSchema;
+
+namespace s6a = diameter::dictionaries::s6a;
+
+namespace {
+
+// The occurrences of every rule counted by its own pass over the AVPs
+bool scan(const avp::AvpList& avps, const CommandSchema& schema)
+{
+    for (std::size_t i = 0; i < schema.size; ++i) {
+        const auto& rule = schema.rules[i];
+        auto count = std::count_if(avps.begin(), avps.end(), [&rule](const avp::AVP& avp) {
+            return avp.code == rule.code && avp.vendor_id.value_or(0) == rule.vendor_id;
+        });
+        if (static_cast<uint32_t>(count) < rule.min || static_cast<uint32_t>(count) > rule.max) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+static void BM_SchemaValidate(benchmark::State& state)
+{
+    auto msg = benchmarks::make_ulr();
+    if (diameter::dictionary::validate(msg, s6a::schema::UpdateLocationRequest,
+            s6a::Dictionary {})) {
+        state.SkipWithError("invalid ULR");
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(diameter::dictionary::validate(msg,
+            s6a::schema::UpdateLocationRequest, s6a::Dictionary {}));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_SchemaScanPerRule(benchmark::State& state)
+{
+    auto msg = benchmarks::make_ulr();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(scan(msg.avps, s6a::schema::UpdateLocationRequest));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_SchemaValidate);
+BENCHMARK(BM_SchemaScanPerRule);
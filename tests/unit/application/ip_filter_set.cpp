@@ -0,0 +1,167 @@
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <diameter/application/ip_filter_set.h>
+
+using namespace diameter;
+using namespace diameter::message::avp::value;
+
+namespace {
+
+IPFilterPacket make_packet(uint8_t direction, const char* src, uint16_t src_port, const char* dst,
+    uint16_t dst_port, uint8_t protocol = IPProtocolV::Tcp)
+{
+    IPFilterPacket packet;
+    packet.direction = direction;
+    packet.src = IPFilterAddress::parse(src).value();
+    packet.dst = IPFilterAddress::parse(dst).value();
+    packet.src_port = src_port;
+    packet.dst_port = dst_port;
+    packet.protocol = protocol;
+    return packet;
+}
+
+std::vector<IPFilter> parse(const std::vector<std::string>& rules)
+{
+    std::vector<IPFilter> filters;
+    for (const auto& rule : rules) {
+        filters.push_back(IPFilter::parse(rule).value());
+    }
+    return filters;
+}
+
+// The first matching filter, one by one
+std::optional<std::size_t> linear_match(const std::vector<IPFilter>& filters,
+    const IPFilterPacket& packet, const std::vector<IPFilterAddress>& assigned)
+{
+    for (std::size_t i = 0; i < filters.size(); ++i) {
+        if (filters[i].matches(packet, assigned)) {
+            return i;
+        }
+    }
+    return std::nullopt;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(ip_filter_set)
+
+BOOST_AUTO_TEST_CASE(empty)
+{
+    application::IPFilterSet set;
+
+    BOOST_CHECK_EQUAL(set.size(), 0);
+    BOOST_CHECK(!set.match(make_packet(IPFilterDirectionV::In, "10.0.0.1", 1, "10.0.0.2", 2)));
+    BOOST_CHECK(set.find(make_packet(IPFilterDirectionV::Out, "::1", 1, "::2", 2)) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(first_match)
+{
+    application::IPFilterSet set(parse({
+        "permit out tcp from any to 10.0.0.0/8 443",
+        "deny out tcp from any to 10.1.0.0/16",
+        "permit out udp from any 53 to assigned",
+        "deny in ip from !assigned to any",
+        "permit in ip from any to 2001:db8::/32",
+        "deny out ip from any to any",
+    }), {IPFilterAddress::parse("10.9.9.9").value()});
+
+    using D = IPFilterDirectionV;
+    BOOST_CHECK_EQUAL(set.match(make_packet(D::Out, "1.1.1.1", 9, "10.1.2.3", 443)).value(), 0);
+    BOOST_CHECK_EQUAL(set.match(make_packet(D::Out, "1.1.1.1", 9, "10.1.2.3", 80)).value(), 1);
+    BOOST_CHECK_EQUAL(
+        set.match(make_packet(D::Out, "8.8.8.8", 53, "10.9.9.9", 9, IPProtocolV::Udp)).value(), 2);
+    BOOST_CHECK_EQUAL(
+        set.match(make_packet(D::Out, "8.8.8.8", 53, "10.9.9.8", 9, IPProtocolV::Udp)).value(), 5);
+    BOOST_CHECK_EQUAL(set.match(make_packet(D::In, "10.9.9.8", 1, "8.8.8.8", 2)).value(), 3);
+    BOOST_CHECK_EQUAL(set.match(make_packet(D::In, "::1", 1, "2001:db8::5", 2)).value(), 3);
+    BOOST_CHECK(!set.match(make_packet(D::In, "10.9.9.9", 1, "8.8.8.8", 2)));
+
+    const auto* filter = set.find(make_packet(D::Out, "::1", 9, "::2", 443));
+    BOOST_REQUIRE(filter != nullptr);
+    BOOST_CHECK_EQUAL(filter->action, IPFilterActionV::Deny);
+}
+
+BOOST_AUTO_TEST_CASE(options)
+{
+    application::IPFilterSet set(parse({
+        "permit out tcp from any to any 80 setup",
+        "deny out icmp from any to any icmptypes 8",
+        "permit out ip from any to any",
+    }));
+
+    using D = IPFilterDirectionV;
+    auto syn = make_packet(D::Out, "10.0.0.1", 5000, "10.0.0.2", 80);
+    syn.tcp_flags = TcpFlagV::Syn;
+    BOOST_CHECK_EQUAL(set.match(syn).value(), 0);
+    syn.tcp_flags = static_cast<uint8_t>(TcpFlagV::Syn | TcpFlagV::Ack);
+    BOOST_CHECK_EQUAL(set.match(syn).value(), 2);
+
+    auto echo = make_packet(D::Out, "10.0.0.1", 0, "10.0.0.2", 0, IPProtocolV::Icmp);
+    echo.icmp_type = 8;
+    BOOST_CHECK_EQUAL(set.match(echo).value(), 1);
+    echo.icmp_type = 0;
+    BOOST_CHECK_EQUAL(set.match(echo).value(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(linear_equivalence)
+{
+    // Random rules over a few prefixes and ports, so that packets hit their boundaries
+    std::mt19937 rng(17);
+    auto pick = [&rng](const std::vector<std::string>& items) {
+        return items[rng() % items.size()];
+    };
+    const std::vector<std::string> addresses = {
+        "any", "assigned", "!assigned", "10.0.0.0/8", "10.1.0.0/16", "!10.1.2.0/24", "10.1.2.3",
+        "0.0.0.0/0", "255.255.255.255/32", "2001:db8::/32", "!2001:db8:1::/48", "::/0",
+        "ffff:ffff:ffff:ffff:ffff:ffff:ffff:ffff/128", "!any", "::1"};
+    const std::vector<std::string> ports = {"", "", " 0", " 80", " 80-90", " 443,8000-8080",
+        " 65535", " 1024-65535"};
+    const std::vector<std::string> protocols = {"ip", "tcp", "udp", "icmp", "sctp", "47"};
+    const std::vector<std::string> options = {"", "", "", " established", " setup",
+        " tcpflags syn,!ack", " icmptypes 0,8", " frag", " ipoptions !rr"};
+
+    std::vector<std::string> rules;
+    for (int i = 0; i < 300; ++i) {
+        rules.push_back(pick({"permit", "deny"}) + " " + pick({"in", "out"}) + " "
+            + pick(protocols) + " from " + pick(addresses) + pick(ports) + " to "
+            + pick(addresses) + pick(ports) + pick(options));
+    }
+    auto filters = parse(rules);
+    std::vector<IPFilterAddress> assigned = {IPFilterAddress::parse("10.1.2.3").value(),
+        IPFilterAddress::parse("2001:db8::7").value()};
+    application::IPFilterSet set(filters, assigned);
+
+    const std::vector<std::string> packet_addresses = {"0.0.0.0", "9.255.255.255", "10.0.0.0",
+        "10.1.2.3", "10.1.2.4", "10.1.3.0", "10.255.255.255", "11.0.0.0", "255.255.255.255", "::",
+        "::1", "::2", "2001:db8::7", "2001:db8:1::1", "2001:db9::",
+        "ffff:ffff:ffff:ffff:ffff:ffff:ffff:ffff"};
+    const std::vector<uint16_t> packet_ports = {0, 1, 79, 80, 90, 91, 443, 1023, 1024, 8080, 65535};
+    const std::vector<uint8_t> packet_protocols = {1, 6, 17, 47, 132, 50};
+
+    for (int i = 0; i < 20000; ++i) {
+        IPFilterPacket packet;
+        packet.direction = static_cast<uint8_t>(rng() % 2);
+        packet.src = IPFilterAddress::parse(pick(packet_addresses)).value();
+        packet.dst = IPFilterAddress::parse(pick(packet_addresses)).value();
+        packet.src_port = packet_ports[rng() % packet_ports.size()];
+        packet.dst_port = packet_ports[rng() % packet_ports.size()];
+        packet.protocol = packet_protocols[rng() % packet_protocols.size()];
+        packet.tcp_flags = static_cast<uint8_t>(rng() % 64);
+        packet.ip_options = static_cast<uint8_t>(rng() % 16);
+        packet.icmp_type = static_cast<uint8_t>(rng() % 10);
+        packet.fragment = rng() % 2 == 0;
+
+        auto expected = linear_match(filters, packet, assigned);
+        auto actual = set.match(packet);
+        BOOST_TEST_INFO(i);
+        BOOST_CHECK(expected == actual);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
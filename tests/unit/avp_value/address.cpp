@@ -1,11 +1,15 @@
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
+#include <random>
 #include <sstream>
 #include <string>
 #include <vector>
 
+#include <arpa/inet.h>
+
 #include <diameter/message/avp/avp.h>
 
 using namespace diameter;
@@ -74,4 +78,133 @@ BOOST_AUTO_TEST_CASE(constructor)
         std::runtime_error);
 }
 
+BOOST_AUTO_TEST_CASE(inline_storage)
+{
+    using message::avp::value::AddressFamilyV;
+
+    auto value1 = message::avp::Address(AddressFamilyV::IPv6, "2001:DB8::0:1");
+    auto text = value1->address_text();
+    BOOST_CHECK_EQUAL(std::string(text.view()), "2001:db8::1");
+    BOOST_CHECK_EQUAL(value1->value().size(), 16);
+    BOOST_CHECK_EQUAL(value1.size(), 18);
+    BOOST_CHECK_EQUAL(value1->validate(), true);
+
+    // The copy refers to its own bytes
+    auto value2 = value1;
+    value1 = message::avp::Address("10.0.0.1");
+    BOOST_CHECK_EQUAL(value2->address_string(), "2001:db8::1");
+    BOOST_CHECK(value2->value().data() != value1->value().data());
+    BOOST_CHECK_EQUAL(value1->address_string(), "10.0.0.1");
+
+    // Other families keep their text as the value, beyond the inline capacity too
+    auto value3 = message::avp::Address(AddressFamilyV::E164, "79161234567");
+    BOOST_CHECK_EQUAL(std::string(value3->address_text().view()), "79161234567");
+    BOOST_CHECK_EQUAL(value3->validate(), false);
+
+    auto dns = std::string("pgw01.epc.mnc001.mcc250.3gppnetwork.org");
+    auto value4 = message::avp::Address(AddressFamilyV::DNS,
+        message::ByteSpan(reinterpret_cast<const uint8_t*>(dns.data()), dns.size()));
+    auto value5 = value4;
+    BOOST_CHECK_EQUAL(value5->address_string(), dns);
+    BOOST_CHECK_EQUAL(value5.size(), dns.size() + 2);
+    BOOST_CHECK_EQUAL(value5->is_ipv4(), false);
+
+    // Wrong size for the family
+    const uint8_t bytes[] = {10, 0, 0};
+    auto value6 = message::avp::Address(AddressFamilyV::IPv4, message::ByteSpan(bytes));
+    BOOST_CHECK_EQUAL(value6->validate(), false);
+    BOOST_CHECK_EQUAL(value6->is_ipv4(), false);
+}
+
+BOOST_AUTO_TEST_CASE(inet_equivalence)
+{
+    using namespace message::avp::value;
+
+    std::mt19937 rng(18);
+
+    // Text of random addresses with runs of zero groups, mapped and compatible IPv4 addresses
+    for (int n = 0; n < 20000; ++n) {
+        uint8_t bytes[16];
+        for (auto& byte : bytes) {
+            byte = rng() % 3 != 0 ? 0 : static_cast<uint8_t>(rng());
+        }
+        if (n % 5 == 0) {
+            std::fill(bytes, bytes + 10, uint8_t {0});
+            bytes[10] = bytes[11] = n % 10 == 0 ? 0xff : 0;
+        }
+
+        char text[detail::ip_text_capacity];
+        char expected[INET6_ADDRSTRLEN];
+        auto size = detail::format_ipv6(bytes, text);
+        BOOST_REQUIRE(inet_ntop(AF_INET6, bytes, expected, sizeof(expected)) != nullptr);
+        BOOST_CHECK_EQUAL(std::string(text, size), expected);
+
+        size = detail::format_ipv4(bytes + 12, text);
+        BOOST_REQUIRE(inet_ntop(AF_INET, bytes + 12, expected, sizeof(expected)) != nullptr);
+        BOOST_CHECK_EQUAL(std::string(text, size), expected);
+    }
+
+    // Random text over the characters of addresses
+    auto check = [](const std::string& text) {
+        uint8_t parsed[16] = {};
+        uint8_t expected[16] = {};
+        BOOST_TEST_INFO(text);
+        auto ok = inet_pton(AF_INET6, text.c_str(), expected) == 1;
+        BOOST_CHECK_EQUAL(detail::parse_ipv6(text, parsed), ok);
+        BOOST_CHECK(!ok || std::equal(parsed, parsed + 16, expected));
+
+        ok = inet_pton(AF_INET, text.c_str(), expected) == 1;
+        BOOST_CHECK_EQUAL(detail::parse_ipv4(text, parsed), ok);
+        BOOST_CHECK(!ok || std::equal(parsed, parsed + 4, expected));
+    };
+    for (auto text : {"", ":", "::", ":::", "::1", "1::", "1:", ":1", "1::2::3", "::ffff:1.2.3.4",
+             "1:2:3:4:5:6:7:8", "1:2:3:4:5:6:7:8:9", "1:2:3:4:5:6:7::", "::2:3:4:5:6:7:8",
+             "1:2:3:4:5:6:1.2.3.4", "1:2:3:4:5:6:7:1.2.3.4", "12345::", "0.0.0.0", "1.2.3",
+             "1.2.3.4.5", "01.2.3.4", "256.1.1.1", "1..2.3", "1.2.3.4."}) {
+        check(text);
+    }
+    const std::string ipv6_chars = "0123456789abcdefABCDEF::..";
+    const std::string ipv4_chars = "0123456789...";
+    for (int n = 0; n < 20000; ++n) {
+        const auto& chars = n % 2 == 0 ? ipv6_chars : ipv4_chars;
+        std::string text;
+        for (auto size = rng() % 20; size > 0; --size) {
+            text += chars[rng() % chars.size()];
+        }
+        check(text);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(move_storage)
+{
+    using message::avp::value::AddressFamilyV;
+
+    auto dns = std::string("pgw01.epc.mnc001.mcc250.3gppnetwork.org");
+    auto long_value = message::avp::Address(AddressFamilyV::DNS,
+        message::ByteSpan(reinterpret_cast<const uint8_t*>(dns.data()), dns.size()));
+    const auto* bytes = long_value->value().data();
+
+    // Moving an allocated value hands over its bytes
+    auto value1 = std::move(long_value);
+    BOOST_CHECK(value1->value().data() == bytes);
+    BOOST_CHECK_EQUAL(value1->address_string(), dns);
+
+    // Inline values are copied into the target
+    auto value2 = message::avp::Address("192.168.0.1");
+    value2 = std::move(value1);
+    BOOST_CHECK_EQUAL(value2->address_string(), dns);
+    value1 = message::avp::Address("192.168.0.1");
+    auto value3 = std::move(value1);
+    BOOST_CHECK_EQUAL(value3->address_string(), "192.168.0.1");
+    BOOST_CHECK_EQUAL(value3->is_ipv4(), true);
+
+    // Values stored in a vector survive its reallocations
+    std::vector<message::avp::Address> values;
+    for (int i = 0; i < 100; ++i) {
+        values.emplace_back(i % 2 ? message::avp::Address("10.0.0.1") : value2);
+    }
+    BOOST_CHECK_EQUAL(values[98]->address_string(), dns);
+    BOOST_CHECK_EQUAL(values[99]->address_string(), "10.0.0.1");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -2,6 +2,8 @@
 
 #include <iomanip>
 #include <iostream>
+#include <random>
+#include <regex>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -45,4 +47,109 @@ BOOST_AUTO_TEST_CASE(constructor)
     BOOST_CHECK_EQUAL(value13->validate(), true);
 }
 
+BOOST_AUTO_TEST_CASE(regex_equivalence)
+{
+    // The regular expression validate() used to be
+    static const std::regex r(
+        R"((?=^.{4,253}$)(^((?!-)[a-zA-Z0-9-]{0,62}[a-zA-Z0-9]\.)+[a-zA-Z]{2,63}$))",
+        std::regex_constants::icase);
+
+    auto check = [](const std::string& fqdn) {
+        BOOST_TEST_INFO(fqdn);
+        BOOST_CHECK_EQUAL(message::avp::DiameterIdentity(fqdn)->validate(),
+            std::regex_match(fqdn, r));
+    };
+
+    std::vector<std::string> corpus = {
+        "", "a.bc", "a.b", "ab.c", "1.ab", "a.b1", "-.ab", "a-.ab", "a--b.cd", "a.-b.cd",
+        ".ab.cd", "ab..cd", "ab.cd.", "A.Example.COM", "xn--80ak6aa92e.com", "a b.com",
+        std::string(63, 'a') + ".com", std::string(64, 'a') + ".com",
+        "a." + std::string(63, 'z'), "a." + std::string(64, 'z'),
+    };
+
+    // Every length around the limits, with the hosts made of 63 character labels
+    for (std::size_t size = 240; size <= 256; ++size) {
+        std::string fqdn;
+        while (fqdn.size() + 64 < size - 3) {
+            fqdn += std::string(63, 'h') + ".";
+        }
+        fqdn += std::string(size - 3 - fqdn.size(), 'h') + ".io";
+        corpus.push_back(fqdn);
+    }
+
+    // An invalid character at every position of a string longer than a vector register
+    auto base = std::string("host-01.epc.mnc001.mcc250.3gppnetwork.org");
+    for (std::size_t i = 0; i < base.size(); ++i) {
+        for (char c : {'_', '@', '`', '{', '[', '/', ':', '\0', '\x80', '\xE1'}) {
+            auto fqdn = base;
+            fqdn[i] = c;
+            corpus.push_back(fqdn);
+        }
+    }
+
+    // Random labels of valid and invalid characters
+    std::mt19937 rng(16);
+    const std::string alphabet = "abcXYZ019-..._";
+    for (int n = 0; n < 5000; ++n) {
+        std::string fqdn;
+        auto labels = rng() % 6 + 1;
+        for (std::size_t l = 0; l < labels; ++l) {
+            if (l != 0) {
+                fqdn += '.';
+            }
+            auto length = rng() % 70;
+            for (std::size_t i = 0; i < length; ++i) {
+                // Mostly letters, so that some strings are valid
+                fqdn += rng() % 4 != 0 ? static_cast<char>('a' + rng() % 26)
+                                       : alphabet[rng() % alphabet.size()];
+            }
+        }
+        corpus.push_back(fqdn);
+    }
+
+    for (const auto& fqdn : corpus) {
+        check(fqdn);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(interned)
+{
+    using message::avp::value::IdentityTable;
+
+    IdentityTable table;
+    auto value1 = message::avp::DiameterIdentity("peer1.example.org", table);
+    auto value2 = message::avp::DiameterIdentity(std::string("peer1.example.org"), table);
+    auto value3 = message::avp::DiameterIdentity("peer2.example.org", table);
+    auto value4 = message::avp::DiameterIdentity("peer1.example.org");
+
+    BOOST_CHECK_EQUAL(value1->id(), 0);
+    BOOST_CHECK_EQUAL(value3->id(), 1);
+    BOOST_CHECK_EQUAL(value4->id(), IdentityTable::npos);
+    BOOST_CHECK(value1->entry() == value2->entry());
+    BOOST_CHECK_EQUAL(value1->value(), "peer1.example.org");
+    BOOST_CHECK_EQUAL(value1.size(), 17);
+    BOOST_CHECK_EQUAL(value1->validate(), true);
+
+    BOOST_CHECK(*value1 == *value2);
+    BOOST_CHECK(*value1 != *value3);
+    // Compared by the text, if one of them is not interned
+    BOOST_CHECK(*value1 == *value4);
+
+    // Copies refer to the same entry
+    auto value5 = value3;
+    BOOST_CHECK(value5->entry() == value3->entry());
+    BOOST_CHECK(&value5->value() == &value3->value());
+
+    // Not interned if the table is full
+    IdentityTable small(1);
+    auto value6 = message::avp::DiameterIdentity("peer1.example.org", small);
+    auto value7 = message::avp::DiameterIdentity("peer2.example.org", small);
+    BOOST_CHECK_EQUAL(value6->id(), 0);
+    BOOST_CHECK_EQUAL(value7->id(), IdentityTable::npos);
+    BOOST_CHECK_EQUAL(value7->value(), "peer2.example.org");
+    // Another table
+    BOOST_CHECK(*value6 == *value1);
+    BOOST_CHECK(*value6 != *value3);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
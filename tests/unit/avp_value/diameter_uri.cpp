@@ -94,6 +94,61 @@ BOOST_AUTO_TEST_CASE(constructor)
     BOOST_CHECK_EQUAL(value7->protocol().has_value(), false);
     BOOST_CHECK_EQUAL(value8->protocol().has_value(), false);
     BOOST_CHECK_EQUAL(value9->protocol().has_value(), false);
+
+    // Views into the value, the parts of an invalid URI are empty
+    BOOST_CHECK(value5->fqdn().data() == value5->value().data() + 6);
+    BOOST_CHECK(value13->fqdn().empty());
+    BOOST_CHECK(!value13->port().has_value());
+}
+
+BOOST_AUTO_TEST_CASE(case_insensitive)
+{
+    auto value = message::avp::DiameterURI("AAAS://Host.Example.com:3868;Transport=SCTP;PROTOCOL=Diameter");
+
+    BOOST_CHECK_EQUAL(value->validate(), true);
+    BOOST_CHECK_EQUAL(value->scheme(), "AAAS");
+    BOOST_CHECK_EQUAL(value->fqdn(), "Host.Example.com");
+    BOOST_CHECK_EQUAL(value->port().value(), 3868);
+    BOOST_CHECK_EQUAL(value->transport().value(), "SCTP");
+    BOOST_CHECK_EQUAL(value->protocol().value(), "Diameter");
+}
+
+BOOST_AUTO_TEST_CASE(invalid)
+{
+    auto check = [](const char* uri) {
+        auto value = message::avp::DiameterURI(uri);
+        BOOST_TEST_INFO(uri);
+        BOOST_CHECK_EQUAL(value->validate(), false);
+    };
+
+    check("");
+    check("aaa://");
+    check("aaa:/host.example.com");
+    check("aaax://host.example.com");
+    check("aaa://host.example.com:");
+    check("aaa://host.example.com:99999999999");
+    check("aaa://host.example.com:12a");
+    check("aaa://host.example.com;transport=tls");
+    check("aaa://host.example.com;protocol=diameter;transport=tcp");
+    check("aaa://host.example.com;transport=tcp;protocol=ldap");
+    check("aaa://host.example.com;transport=tcpx");
+    check("aaa://host.example.com/path");
+    check("aaa://-host.example.com");
+    check("aaa://host.example.c0m");
+    check("aaa://host..example.com");
+}
+
+BOOST_AUTO_TEST_CASE(copy)
+{
+    // The parts refer to the value of the copy, not of the original
+    auto original = message::avp::DiameterURI("aaa://host.example.com:6666;transport=tcp");
+    original->validate();
+    auto copy = original;
+    original = message::avp::DiameterURI("aaa://other.example.org");
+
+    BOOST_CHECK_EQUAL(copy->fqdn(), "host.example.com");
+    BOOST_CHECK(copy->fqdn().data() == copy->value().data() + 6);
+    BOOST_CHECK_EQUAL(copy->transport().value(), "tcp");
 }
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,94 @@
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <diameter/message/avp/value/identity_table.h>
+
+using namespace diameter;
+
+using message::avp::value::IdentityTable;
+
+BOOST_AUTO_TEST_SUITE(avp_identity_table)
+
+BOOST_AUTO_TEST_CASE(intern)
+{
+    IdentityTable table(4);
+
+    const auto* host = table.intern("pgw01.epc.mnc001.mcc250.3gppnetwork.org");
+    const auto* realm = table.intern("epc.mnc001.mcc250.3gppnetwork.org");
+    BOOST_REQUIRE(host != nullptr && realm != nullptr);
+    BOOST_CHECK_EQUAL(host->id, 0);
+    BOOST_CHECK_EQUAL(realm->id, 1);
+    BOOST_CHECK_EQUAL(table.size(), 2);
+
+    // Interned once
+    BOOST_CHECK(table.intern(std::string("epc.mnc001.mcc250.3gppnetwork.org")) == realm);
+    BOOST_CHECK(table.find("epc.mnc001.mcc250.3gppnetwork.org") == realm);
+    BOOST_CHECK(table.find("mnc001.mcc250.3gppnetwork.org") == nullptr);
+    BOOST_CHECK(table.entry(0) == host);
+    BOOST_CHECK(table.entry(2) == nullptr);
+    BOOST_CHECK(table.entry(IdentityTable::npos) == nullptr);
+    BOOST_CHECK_EQUAL(table.size(), 2);
+
+    // Full table
+    BOOST_CHECK(table.intern("a.example.org") != nullptr);
+    BOOST_CHECK(table.intern("b.example.org") != nullptr);
+    BOOST_CHECK(table.intern("c.example.org") == nullptr);
+    BOOST_CHECK(table.intern("a.example.org") != nullptr);
+    BOOST_CHECK_EQUAL(table.size(), 4);
+
+    BOOST_CHECK_THROW(IdentityTable(0), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_intern)
+{
+    constexpr std::size_t count = 200;
+    constexpr std::size_t threads = 4;
+
+    IdentityTable table(count);
+    std::vector<std::string> names;
+    for (std::size_t i = 0; i < count; ++i) {
+        names.push_back("host" + std::to_string(i) + ".example.org");
+    }
+
+    // Every thread interns all the names in its own order and reads the entries back
+    std::vector<std::vector<const IdentityTable::Entry*>> results(threads);
+    std::atomic<bool> failed {false};
+    std::vector<std::thread> workers;
+    for (std::size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            auto& result = results[t];
+            result.resize(count);
+            for (std::size_t i = 0; i < count; ++i) {
+                auto n = (i + t * 37) % count;
+                n = t % 2 == 0 ? n : count - 1 - n;
+                result[n] = table.intern(names[n]);
+                if (result[n] == nullptr || result[n]->text != names[n]
+                    || table.entry(result[n]->id) != result[n]) {
+                    failed = true;
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    BOOST_CHECK(!failed);
+    BOOST_CHECK_EQUAL(table.size(), count);
+    for (std::size_t t = 1; t < threads; ++t) {
+        BOOST_CHECK(results[t] == results[0]);
+    }
+    std::vector<bool> ids(count);
+    for (const auto* entry : results[0]) {
+        BOOST_REQUIRE(entry->id < count);
+        ids[entry->id] = true;
+    }
+    BOOST_CHECK(std::all_of(ids.begin(), ids.end(), [](bool used) { return used; }));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -67,4 +67,169 @@ BOOST_AUTO_TEST_CASE(constructor)
     BOOST_CHECK_EQUAL(value21->validate(), false);
 }
 
+BOOST_AUTO_TEST_CASE(parts)
+{
+    auto value = message::avp::IPFilterRule("Permit OUT 17 from !10.0.0.0/8 1000-2000,3000 to assigned");
+
+    BOOST_CHECK_EQUAL(value->validate(), true);
+    BOOST_CHECK_EQUAL(value->action(), "Permit");
+    BOOST_CHECK_EQUAL(value->direction(), "OUT");
+    BOOST_CHECK_EQUAL(value->protocol(), "17");
+    BOOST_CHECK_EQUAL(value->src(), "!10.0.0.0/8");
+    BOOST_CHECK_EQUAL(value->dst(), "assigned");
+    // Views into the value
+    BOOST_CHECK(value->protocol().data() == value->value().data() + 11);
+
+    auto negated = message::avp::IPFilterRule(" deny\tin ip from ! 10.0.0.1 to  !any 80");
+    BOOST_CHECK_EQUAL(negated->action(), "deny");
+    BOOST_CHECK_EQUAL(negated->direction(), "in");
+    BOOST_CHECK_EQUAL(negated->src(), "! 10.0.0.1");
+    BOOST_CHECK_EQUAL(negated->dst(), "!any");
+    BOOST_CHECK_EQUAL(negated->validate(), true);
+
+    auto invalid = message::avp::IPFilterRule("permit sideways ip from any to any");
+    BOOST_CHECK(invalid->action().empty());
+    BOOST_CHECK(invalid->src().empty());
+    BOOST_CHECK(!invalid->filter().has_value());
+    BOOST_CHECK_EQUAL(invalid->validate(), false);
+}
+
+BOOST_AUTO_TEST_CASE(filter)
+{
+    using namespace message::avp::value;
+
+    auto filter = message::avp::IPFilterRule(
+        "deny in tcp from 192.168.1.77/24 80,8000-8080 to ! 2001:db8::1/32 tcpflags syn,!ack "
+        "established ipoptions !ssrr,rr frag")->filter();
+
+    BOOST_REQUIRE(filter.has_value());
+    BOOST_CHECK_EQUAL(filter->action, IPFilterActionV::Deny);
+    BOOST_CHECK_EQUAL(filter->direction, IPFilterDirectionV::In);
+    BOOST_CHECK_EQUAL(filter->protocol.value(), IPProtocolV::Tcp);
+
+    BOOST_CHECK_EQUAL(filter->src.kind, IPFilterEndpoint::KindV::Prefix);
+    BOOST_CHECK_EQUAL(filter->src.negated, false);
+    BOOST_CHECK(filter->src.address == IPFilterAddress::parse("192.168.1.0").value());
+    BOOST_CHECK_EQUAL(filter->src.prefix_length, 24);
+    BOOST_REQUIRE_EQUAL(filter->src.ports.size(), 2);
+    BOOST_CHECK_EQUAL(filter->src.ports[0].first, 80);
+    BOOST_CHECK_EQUAL(filter->src.ports[0].last, 80);
+    BOOST_CHECK_EQUAL(filter->src.ports[1].first, 8000);
+    BOOST_CHECK_EQUAL(filter->src.ports[1].last, 8080);
+
+    BOOST_CHECK_EQUAL(filter->dst.negated, true);
+    BOOST_CHECK(filter->dst.address == IPFilterAddress::parse("2001:db8::").value());
+    BOOST_CHECK_EQUAL(filter->dst.prefix_length, 32);
+    BOOST_CHECK(filter->dst.ports.empty());
+
+    BOOST_CHECK_EQUAL(filter->tcp_flags_set, TcpFlagV::Syn);
+    BOOST_CHECK_EQUAL(filter->tcp_flags_clear, TcpFlagV::Ack);
+    BOOST_CHECK_EQUAL(filter->established, true);
+    BOOST_CHECK_EQUAL(filter->ip_options_set, IPOptionV::Rr);
+    BOOST_CHECK_EQUAL(filter->ip_options_clear, IPOptionV::Ssrr);
+    BOOST_CHECK_EQUAL(filter->frag, true);
+    BOOST_CHECK_EQUAL(filter->has_options(), true);
+
+    auto icmp = IPFilter::parse("permit out icmp from any to any icmptypes 0,8");
+    BOOST_REQUIRE(icmp.has_value());
+    BOOST_CHECK_EQUAL(icmp->icmp_types.count(), 2);
+    BOOST_CHECK_EQUAL(icmp->icmp_types.test(8), true);
+
+    auto range = IPFilter::parse("permit out icmp from any to any icmptypes 0-8");
+    BOOST_REQUIRE(range.has_value());
+    BOOST_CHECK_EQUAL(range->icmp_types.count(), 9);
+    BOOST_CHECK_EQUAL(range->icmp_types.test(0), true);
+    BOOST_CHECK_EQUAL(range->icmp_types.test(8), true);
+    BOOST_CHECK_EQUAL(range->icmp_types.test(9), false);
+
+    auto named = IPFilter::parse("permit out icmp from any to any icmptypes echo");
+    BOOST_REQUIRE(named.has_value());
+    BOOST_CHECK_EQUAL(named->icmp_types.count(), 1);
+    BOOST_CHECK_EQUAL(named->icmp_types.test(8), true);
+
+    auto mixed = IPFilter::parse(
+        "permit out icmp from any to any icmptypes EchoReply,unreach-redirect,13,maskreq-18");
+    BOOST_REQUIRE(mixed.has_value());
+    BOOST_CHECK_EQUAL(mixed->icmp_types.count(), 7);
+    BOOST_CHECK_EQUAL(mixed->icmp_types.test(0), true);
+    BOOST_CHECK_EQUAL(mixed->icmp_types.test(4), true);
+    BOOST_CHECK_EQUAL(mixed->icmp_types.test(13), true);
+    BOOST_CHECK_EQUAL(mixed->icmp_types.test(18), true);
+
+    auto ip = IPFilter::parse("permit out ip from any to any");
+    BOOST_REQUIRE(ip.has_value());
+    BOOST_CHECK_EQUAL(ip->protocol.has_value(), false);
+    BOOST_CHECK_EQUAL(ip->has_options(), false);
+}
+
+BOOST_AUTO_TEST_CASE(invalid)
+{
+    auto check = [](const char* rule) {
+        BOOST_TEST_INFO(rule);
+        BOOST_CHECK_EQUAL(message::avp::IPFilterRule(rule)->validate(), false);
+    };
+
+    check("");
+    check("permit");
+    check("permit in");
+    check("permit in tcp from any");
+    check("permit in tcp from any to");
+    check("permit up tcp from any to any");
+    check("permit in tcpx from any to any");
+    check("permit in 256 from any to any");
+    check("permit in tcp to any from any");
+    check("permit in tcp from 256.256.256.256 to any");
+    check("permit in tcp from 10.0.0.0/33 to any");
+    check("permit in tcp from 2001:db8::/129 to any");
+    check("permit in tcp from 10.0.0.0/ to any");
+    check("permit in tcp from ! to any");
+    check("permit in tcp from any to any 80-");
+    check("permit in tcp from any to any 80,");
+    check("permit in tcp from any to any 90-80");
+    check("permit in tcp from any to any 65536");
+    check("permit in tcp from any to any tcpflags syn,fyn");
+    check("permit in tcp from any to any tcpflags");
+    check("permit in tcp from any to any icmptypes 256");
+    check("permit in tcp from any to any icmptypes 8-0");
+    check("permit in tcp from any to any icmptypes 0-");
+    check("permit in tcp from any to any icmptypes ping");
+    check("permit in tcp from any to any keep-state");
+}
+
+BOOST_AUTO_TEST_CASE(matches)
+{
+    using namespace message::avp::value;
+
+    auto packet = [](const char* src, uint16_t src_port, const char* dst, uint16_t dst_port) {
+        IPFilterPacket p;
+        p.direction = IPFilterDirectionV::Out;
+        p.src = IPFilterAddress::parse(src).value();
+        p.dst = IPFilterAddress::parse(dst).value();
+        p.protocol = IPProtocolV::Tcp;
+        p.src_port = src_port;
+        p.dst_port = dst_port;
+        return p;
+    };
+
+    auto filter = IPFilter::parse("permit out tcp from 10.1.0.0/16 to !assigned 443").value();
+    std::vector<IPFilterAddress> assigned = {IPFilterAddress::parse("10.9.9.9").value()};
+
+    BOOST_CHECK_EQUAL(filter.matches(packet("10.1.2.3", 5000, "8.8.8.8", 443), assigned), true);
+    BOOST_CHECK_EQUAL(filter.matches(packet("10.2.2.3", 5000, "8.8.8.8", 443), assigned), false);
+    BOOST_CHECK_EQUAL(filter.matches(packet("10.1.2.3", 5000, "10.9.9.9", 443), assigned), false);
+    BOOST_CHECK_EQUAL(filter.matches(packet("10.1.2.3", 5000, "8.8.8.8", 80), assigned), false);
+    BOOST_CHECK_EQUAL(filter.matches(packet("::1", 5000, "8.8.8.8", 443), assigned), false);
+
+    auto in = packet("10.1.2.3", 5000, "8.8.8.8", 443);
+    in.direction = IPFilterDirectionV::In;
+    BOOST_CHECK_EQUAL(filter.matches(in, assigned), false);
+
+    auto setup = IPFilter::parse("permit out tcp from any to any setup").value();
+    auto syn = packet("10.1.2.3", 5000, "8.8.8.8", 443);
+    syn.tcp_flags = TcpFlagV::Syn;
+    BOOST_CHECK_EQUAL(setup.matches(syn), true);
+    syn.tcp_flags = static_cast<uint8_t>(TcpFlagV::Syn | TcpFlagV::Ack);
+    BOOST_CHECK_EQUAL(setup.matches(syn), false);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
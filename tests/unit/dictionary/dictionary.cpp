@@ -0,0 +1,262 @@
+#include <boost/test/unit_test.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <diameter/dictionary/dictionary.h>
+#include <diameter/dictionary/xml.h>
+
+using namespace diameter;
+
+namespace {
+
+const char* const base_xml = R"(<?xml version="1.0" encoding="UTF-8"?>
+<!DOCTYPE dictionary SYSTEM "dictionary.dtd" [
+    <!ENTITY vendors "<vendor vendor-id='TGPP' code='10415' name='3GPP'/>">
+]>
+<dictionary>
+    <!-- RFC 6733 -->
+    <base uri="https://tools.ietf.org/html/rfc6733">
+        <typedefn type-name="OctetString"/>
+        <typedefn type-name="UTF8String" type-parent="OctetString"/>
+        <typedefn type-name="Unsigned32"/>
+        <typedefn type-name="AppId" type-parent="Unsigned32"/>
+        <typedefn type-name="Time" type-parent="OctetString"/>
+        <command name="Capabilities-Exchange" code="257" vendor-id="None">
+            <requestrules>
+                <required>
+                    <avprule name="Origin-Host" maximum="1" minimum="1"/>
+                    <avprule name="Origin-Realm"/>
+                </required>
+                <optional>
+                    <avprule name="Auth-Application-Id" maximum="*"/>
+                    <avprule name="Unknown-Avp"/>
+                </optional>
+            </requestrules>
+            <answerrules>
+                <required><avprule name="Result-Code"/></required>
+            </answerrules>
+        </command>
+        <avp name="Origin-Host" code="264" mandatory="must" may-encrypt="no" vendor-bit="mustnot">
+            <type type-name="DiameterIdentity"/>
+        </avp>
+        <avp name="Origin-Realm" code="296" mandatory="must">
+            <type type-name="DiameterIdentity"/>
+        </avp>
+        <avp name="Result-Code" code="268" mandatory="must">
+            <type type-name="Unsigned32"/>
+        </avp>
+        <avp name="Auth-Application-Id" code="258" mandatory="must">
+            <type type-name="AppId"/>
+        </avp>
+        <avp name="Event-Timestamp" code="55" mandatory="must">
+            <type type-name="Time"/>
+        </avp>
+        <avp name="Proxy-Info" code="284" mandatory="must">
+            <grouped>
+                <gavp name="Proxy-Host"/>
+                <gavp name="Proxy-State"/>
+            </grouped>
+        </avp>
+        <avp name="Proxy-Host" code="280" mandatory="must"><type type-name="DiameterIdentity"/></avp>
+        <avp name="Proxy-State" code="33" mandatory="must"><type type-name="OctetString"/></avp>
+        <avp name="Disconnect-Cause" code="273" mandatory="must">
+            <type type-name="Enumerated"/>
+            <enum name="REBOOTING" code="0"/>
+            <enum name="DO_NOT_WANT_TO_TALK_TO_YOU" code="2"/>
+            <enum name="NEGATIVE" code="-2147483648"/>
+        </avp>
+    </base>
+    &vendors;
+    <application id="16777238" name="3GPP Gx" uri="http://www.3gpp.org/ftp/Specs/html-info/29212.htm">
+        <command name="Credit-Control" code="272" vendor-id="None">
+            <requestrules>
+                <fixed><avprule name="Origin-Host"/></fixed>
+            </requestrules>
+        </command>
+        <avp name="Bearer-Identifier" code="1020" mandatory="must" vendor-bit="must" vendor-id="TGPP">
+            <type type-name="OctetString"/>
+        </avp>
+        <avp name="QoS-Class-Identifier" code="1028" mandatory="must" vendor-id="TGPP">
+            <type type-name="Enumerated"/>
+        </avp>
+    </application>
+</dictionary>
+)";
+
+dictionary::Dictionary load(const char* text)
+{
+    dictionary::XmlLoader loader;
+    loader.load(text);
+    return loader.dictionary();
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(dictionary_tests)
+
+BOOST_AUTO_TEST_CASE(perfect_hash)
+{
+    std::mt19937_64 random(7);
+    for (std::size_t count : {1u, 2u, 3u, 10u, 100u, 1000u, 5000u}) {
+        std::set<uint64_t> unique;
+        while (unique.size() < count) {
+            // AVP codes of a few vendors
+            unique.insert(random() % 4 << 32 | random() % 3000);
+        }
+        auto keys = std::vector<uint64_t>(unique.begin(), unique.end());
+        auto hash = dictionary::detail::PerfectHash(keys);
+        BOOST_CHECK_GE(hash.size(), count);
+        BOOST_CHECK_LE(hash.size(), count * 2 + 2);
+        std::set<std::size_t> slots;
+        for (auto key : keys) {
+            auto slot = hash.index(key);
+            BOOST_CHECK_LT(slot, hash.size());
+            slots.insert(slot);
+        }
+        BOOST_CHECK_EQUAL(slots.size(), count);
+    }
+    BOOST_CHECK_EQUAL(dictionary::detail::PerfectHash().size(), 0);
+    BOOST_CHECK_THROW(dictionary::detail::PerfectHash(std::vector<uint64_t> {1, 2, 1}),
+        std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(find)
+{
+    using dictionary::AvpTypeV;
+
+    auto dict = load(base_xml);
+    BOOST_CHECK_EQUAL(dict.avps().size(), 11);
+
+    const auto* origin_host = dict.find(264);
+    BOOST_REQUIRE(origin_host != nullptr);
+    BOOST_CHECK_EQUAL(origin_host->name, "Origin-Host");
+    BOOST_CHECK_EQUAL(origin_host->type, AvpTypeV::DiameterIdentity);
+    BOOST_CHECK_EQUAL(origin_host->flag_bits, message::avp::FlagBits::Mandatory);
+    BOOST_CHECK(dict.find("Origin-Host") == origin_host);
+
+    // Derived types
+    BOOST_CHECK_EQUAL(dict.find(258)->type, AvpTypeV::Unsigned32);
+    BOOST_CHECK_EQUAL(dict.find(55)->type, AvpTypeV::Time);
+    BOOST_CHECK_EQUAL(dict.find(284)->type, AvpTypeV::Grouped);
+
+    // Vendor
+    const auto* bearer = dict.find(1020, 10415);
+    BOOST_REQUIRE(bearer != nullptr);
+    BOOST_CHECK_EQUAL(bearer->name, "Bearer-Identifier");
+    BOOST_CHECK_EQUAL(bearer->flag_bits,
+        message::avp::FlagBits::Mandatory | message::avp::FlagBits::VendorSpecific);
+    BOOST_CHECK(dict.find(1020) == nullptr);
+    BOOST_CHECK(dict.find(264, 10415) == nullptr);
+    BOOST_CHECK(dict.find(1) == nullptr);
+    BOOST_CHECK(dict.find("User-Name") == nullptr);
+    BOOST_CHECK_EQUAL(dict.find_vendor(10415)->name, "3GPP");
+
+    // Enum values
+    const auto* cause = dict.find("Disconnect-Cause");
+    BOOST_REQUIRE_EQUAL(cause->values.size(), 3);
+    BOOST_CHECK_EQUAL(cause->values[1].name, "DO_NOT_WANT_TO_TALK_TO_YOU");
+    BOOST_CHECK_EQUAL(cause->values[1].code, 2);
+    BOOST_CHECK_EQUAL(cause->values[2].code, -2147483648LL);
+
+    BOOST_CHECK(dictionary::Dictionary().find(264) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(rules)
+{
+    using dictionary::AvpRule;
+    using dictionary::RuleSectionV;
+
+    auto dict = load(base_xml);
+
+    const auto* cer = dict.find_command(257);
+    BOOST_REQUIRE(cer != nullptr);
+    BOOST_CHECK_EQUAL(cer->name, "Capabilities-Exchange");
+    // The rule of the undefined AVP is dropped
+    BOOST_REQUIRE_EQUAL(cer->request.rules.size(), 3);
+    BOOST_CHECK_EQUAL(cer->request.any_avp, false);
+    const auto& origin_realm = cer->request.rules[1];
+    BOOST_CHECK_EQUAL(origin_realm.code, 296);
+    BOOST_CHECK_EQUAL(origin_realm.section, RuleSectionV::Required);
+    BOOST_CHECK_EQUAL(origin_realm.min, 1);
+    BOOST_CHECK_EQUAL(origin_realm.max, 1);
+    const auto& application = cer->request.rules[2];
+    BOOST_CHECK_EQUAL(application.section, RuleSectionV::Optional);
+    BOOST_CHECK_EQUAL(application.min, 0);
+    BOOST_CHECK_EQUAL(application.max, AvpRule::unbounded);
+    BOOST_REQUIRE_EQUAL(cer->answer.rules.size(), 1);
+    BOOST_CHECK_EQUAL(cer->answer.rules[0].code, 268);
+
+    // Application command, the base one for other applications
+    const auto* ccr = dict.find_command(272, 16777238);
+    BOOST_REQUIRE(ccr != nullptr);
+    BOOST_CHECK_EQUAL(ccr->request.rules[0].section, RuleSectionV::Fixed);
+    BOOST_CHECK(dict.find_command(272) == nullptr);
+    BOOST_CHECK(dict.find_command(257, 16777238) == cer);
+
+    const auto& proxy_info = dict.find(284)->rules.rules;
+    BOOST_REQUIRE_EQUAL(proxy_info.size(), 2);
+    BOOST_CHECK_EQUAL(proxy_info[1].code, 33);
+    BOOST_CHECK_EQUAL(proxy_info[1].max, AvpRule::unbounded);
+}
+
+BOOST_AUTO_TEST_CASE(override_and_files)
+{
+    auto directory = std::string(P_tmpdir) + "/";
+    {
+        std::ofstream main(directory + "diameter_dictionary_main.xml");
+        main << R"(<!DOCTYPE dictionary SYSTEM "dictionary.dtd" [
+            <!ENTITY app SYSTEM "diameter_dictionary_app.xml">
+        ]>
+        <dictionary>
+            <base><avp name="User-Name" code="1"><type type-name="UTF8String"/></avp></base>
+            &app;
+        </dictionary>)";
+        std::ofstream app(directory + "diameter_dictionary_app.xml");
+        app << R"(<application id="1">
+            <avp name="User-Name" code="1" mandatory="must"><type type-name="OctetString"/></avp>
+        </application>
+        <vendor vendor-id="Ericsson" code="193" name="Ericsson"/>)";
+    }
+
+    auto dict = dictionary::load_xml_file(directory + "diameter_dictionary_main.xml");
+    // The later definition wins
+    BOOST_REQUIRE_EQUAL(dict.avps().size(), 1);
+    BOOST_CHECK_EQUAL(dict.find(1)->type, dictionary::AvpTypeV::OctetString);
+    BOOST_CHECK_EQUAL(dict.find(1)->flag_bits, message::avp::FlagBits::Mandatory);
+    BOOST_CHECK_EQUAL(dict.find_vendor(193)->name, "Ericsson");
+
+    std::remove((directory + "diameter_dictionary_main.xml").c_str());
+    std::remove((directory + "diameter_dictionary_app.xml").c_str());
+
+    BOOST_CHECK_THROW(dictionary::load_xml_file(directory + "diameter_dictionary_none.xml"),
+        std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(invalid)
+{
+    const char* const documents[] = {
+        "<dictionary><avp name='A' code='x'/></dictionary>",
+        "<dictionary><avp name='A'/></dictionary>",
+        "<dictionary><avp name='A' code='1'></dictionary>",
+        "<dictionary><avp name='A' code='1'/></base>",
+        "<dictionary><avp name='A' code='1' vendor-id='Unknown'/></dictionary>",
+        "<dictionary><avp name='A' code='99999999999'/></dictionary>",
+        "<dictionary>&undeclared;</dictionary>",
+        "<!DOCTYPE d [<!ENTITY e SYSTEM 'e.xml'>]><dictionary>&e;</dictionary>",
+        "<dictionary><avp name='A code='1'/></dictionary>",
+    };
+    for (const auto* document : documents) {
+        BOOST_CHECK_THROW(load(document), std::runtime_error);
+    }
+    // Character data and references are skipped
+    BOOST_CHECK_NO_THROW(load("<dictionary>AT&amp;T &#65;<base/></dictionary>"));
+    BOOST_CHECK_EQUAL(load("<dictionary><avp name='A&amp;B' code='1'/></dictionary>")
+        .find(1)->name, "A&B");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
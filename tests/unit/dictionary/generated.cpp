@@ -0,0 +1,116 @@
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+#include <netpacker/netpacker.h>
+
+#include <diameter/application/base/avp.h>
+#include <diameter/dictionaries/dcca.h>
+#include <diameter/dictionary/xml.h>
+#include <diameter/serial/serial.h>
+
+using namespace diameter;
+
+namespace {
+
+namespace dma = message::avp;
+namespace base = application::base;
+namespace dcca = dictionaries::dcca;
+
+using dictionary::AvpTypeV;
+
+// The generated AvpDef of the base protocol AVPs are those of application/base/avp.h
+static_assert(std::is_same_v<dcca::avp::OriginHost, base::avp::OriginHost>);
+static_assert(std::is_same_v<dcca::avp::ProductName, base::avp::ProductName>);
+static_assert(std::is_same_v<dcca::avp::FailedAvp, base::avp::FailedAvp>);
+
+// The lookups are constant expressions
+static_assert(dcca::Dictionary::find(416)->type == AvpTypeV::Enumerated);
+static_assert(dcca::Dictionary::find(416, 10415) == nullptr);
+static_assert(dcca::Dictionary::find_command(272, 4)->name == "Credit-Control");
+static_assert(dcca::CommandV::CreditControl == 272);
+static_assert(dcca::avp::CcRequestTypeV::TERMINATION_REQUEST == 3);
+static_assert(dcca::avp::CcUnitTypeV::TOTAL_OCTETS == 2);
+
+dictionary::Dictionary load_dcca()
+{
+    dictionary::XmlLoader loader;
+    loader.load_file(DIAMETER_DICTIONARIES_DIR "/base.xml");
+    loader.load_file(DIAMETER_DICTIONARIES_DIR "/dcca.xml");
+    return loader.dictionary();
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(generated_dictionary)
+
+BOOST_AUTO_TEST_CASE(same_as_loaded)
+{
+    auto loaded = load_dcca();
+    BOOST_REQUIRE_EQUAL(std::size(dcca::avps), loaded.avps().size());
+    BOOST_REQUIRE_EQUAL(std::size(dcca::commands), loaded.commands().size());
+    for (const auto& avp : loaded.avps()) {
+        const auto* entry = dcca::Dictionary::find(avp.code, avp.vendor_id);
+        BOOST_REQUIRE(entry != nullptr);
+        BOOST_CHECK_EQUAL(entry->name, avp.name);
+        BOOST_CHECK_EQUAL(entry->type, avp.type);
+        BOOST_CHECK_EQUAL(entry->flag_bits, avp.flag_bits);
+    }
+    for (const auto& command : loaded.commands()) {
+        const auto* entry = dcca::Dictionary::find_command(command.code, command.application_id);
+        BOOST_REQUIRE(entry != nullptr);
+        BOOST_CHECK_EQUAL(entry->name, command.name);
+        BOOST_CHECK_EQUAL(entry->application_id, command.application_id);
+    }
+
+    BOOST_CHECK(dcca::Dictionary::find(9999) == nullptr);
+    // Commands of the base protocol are found for every application
+    BOOST_CHECK_EQUAL(dcca::Dictionary::find_command(280, 4)->name, "Device-Watchdog");
+    BOOST_CHECK(dcca::Dictionary::find_command(272, 0) == nullptr);
+    BOOST_CHECK(dcca::Dictionary::find_command(316, 16777251) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(decode)
+{
+    message::Message msg {message::header::Header{}, dma::AvpList {
+        dcca::avp::SessionId::make(dma::UTF8String("pgw.example.org;1;2")),
+        dcca::avp::CcRequestType::make(dma::Enumerated(int32_t {
+            dcca::avp::CcRequestTypeV::INITIAL_REQUEST})),
+        dcca::avp::MultipleServicesCreditControl::make(dma::Grouped(dma::AvpList {
+            dcca::avp::RequestedServiceUnit::make(dma::Grouped(dma::AvpList {
+                dcca::avp::CcTotalOctets::make(uint64_t {1000000}),
+            })),
+            dcca::avp::RatingGroup::make(uint32_t {10}),
+        })),
+    }};
+    msg.header.version = message::header::ProtocolVersionV::V01;
+    msg.header.command_code = dcca::CommandV::CreditControl;
+    msg.header.application_id = 4;
+    auto data = std::vector<uint8_t>(msg.size());
+    netpacker::put(data.begin(), data.end(), msg);
+
+    auto generated = serial::decode(data, dcca::Dictionary {});
+    auto loaded = serial::decode(data, load_dcca());
+    for (auto* decoded : {&generated, &loaded}) {
+        auto encoded = std::vector<uint8_t>(decoded->size());
+        netpacker::put(encoded.begin(), encoded.end(), *decoded);
+        BOOST_CHECK(encoded == data);
+    }
+
+    const auto& avps = generated.avps;
+    BOOST_REQUIRE_EQUAL(avps.size(), 3u);
+    BOOST_CHECK(std::holds_alternative<dma::Enumerated>(avps[1].value));
+    const auto& mscc = *std::get<dma::Grouped>(avps[2].value);
+    const auto& rsu = *std::get<dma::Grouped>(mscc.at(0).value);
+    BOOST_CHECK_EQUAL(*std::get<dma::Unsigned64>(rsu.at(0).value), 1000000u);
+
+    auto session_id = serial::avp::get<dcca::avp::SessionId>(avps);
+    BOOST_REQUIRE(session_id.has_value());
+    BOOST_CHECK(**session_id == "pgw.example.org;1;2");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
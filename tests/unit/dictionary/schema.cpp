@@ -0,0 +1,167 @@
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <stdexcept>
+#include <variant>
+#include <vector>
+
+#include <diameter/application/base/result_code.h>
+#include <diameter/dictionaries/dcca.h>
+#include <diameter/dictionaries/s6a.h>
+#include <diameter/dictionary/schema.h>
+#include <diameter/dictionary/xml.h>
+
+using namespace diameter;
+using application::base::ResultCodeV;
+
+namespace {
+
+namespace dma = message::avp;
+namespace dcca = dictionaries::dcca;
+namespace s6a = dictionaries::s6a;
+
+using dictionary::AvpRule;
+using dictionary::AvpRules;
+using dictionary::RuleSectionV;
+
+dma::AvpList make_ccr()
+{
+    return dma::AvpList {
+        dcca::avp::SessionId::make(dma::UTF8String("pgw.example.org;1;2")),
+        dcca::avp::OriginHost::make(dma::DiameterIdentity("pgw.example.org")),
+        dcca::avp::OriginRealm::make(dma::DiameterIdentity("example.org")),
+        dcca::avp::DestinationRealm::make(dma::DiameterIdentity("ocs.example.org")),
+        dcca::avp::AuthApplicationId::make(uint32_t {4}),
+        dcca::avp::ServiceContextId::make(dma::UTF8String("32251@3gpp.org")),
+        dcca::avp::CcRequestType::make(dma::Enumerated(int32_t {1})),
+        dcca::avp::CcRequestNumber::make(uint32_t {0}),
+        dcca::avp::MultipleServicesCreditControl::make(dma::Grouped()),
+        dcca::avp::MultipleServicesCreditControl::make(dma::Grouped()),
+        // Not in the grammar, allowed by "* [ AVP ]"
+        dma::AVP {873, dma::Flags {uint8_t {0x80}}, uint32_t {10415}, dma::Grouped()},
+    };
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(schema_tests)
+
+BOOST_AUTO_TEST_CASE(valid)
+{
+    BOOST_CHECK(!dictionary::validate(make_ccr(), dcca::schema::CreditControlRequest,
+        dcca::Dictionary {}));
+
+    dma::AvpList ulr {
+        s6a::avp::SessionId::make(dma::UTF8String("mme.example.org;1;2")),
+        s6a::avp::AuthSessionState::make(dma::Enumerated(int32_t {1})),
+        s6a::avp::OriginHost::make(dma::DiameterIdentity("mme.example.org")),
+        s6a::avp::OriginRealm::make(dma::DiameterIdentity("example.org")),
+        s6a::avp::DestinationRealm::make(dma::DiameterIdentity("hss.example.org")),
+        s6a::avp::UserName::make(dma::UTF8String("250011234567890")),
+        s6a::avp::SupportedFeatures::make(dma::Grouped()),
+        s6a::avp::SupportedFeatures::make(dma::Grouped()),
+        s6a::avp::RatType::make(dma::Enumerated(int32_t {s6a::avp::RatTypeV::EUTRAN})),
+        s6a::avp::UlrFlags::make(uint32_t {0x22}),
+        s6a::avp::VisitedPlmnId::make(dma::OctetString(dma::OctetString::value_type {0x52})),
+    };
+    BOOST_CHECK(!dictionary::validate(ulr, s6a::schema::UpdateLocationRequest,
+        s6a::Dictionary {}));
+    // Without the vendor the AVPs are other AVPs: RAT-Type is missing
+    ulr[8].vendor_id = std::nullopt;
+    auto violation = dictionary::validate(ulr, s6a::schema::UpdateLocationRequest,
+        s6a::Dictionary {});
+    BOOST_CHECK_EQUAL(violation.result_code, ResultCodeV::AvpUnsupported);
+    BOOST_CHECK(violation.avp == &ulr[8]);
+}
+
+BOOST_AUTO_TEST_CASE(violations)
+{
+    const auto& schema = dcca::schema::CreditControlRequest;
+    dcca::Dictionary dict;
+
+    // Session-Id is not the first AVP
+    auto avps = make_ccr();
+    std::swap(avps[0], avps[1]);
+    auto violation = dictionary::validate(avps, schema, dict);
+    BOOST_CHECK_EQUAL(violation.result_code, ResultCodeV::MissingAvp);
+    BOOST_CHECK_EQUAL(violation.code, 263u);
+    BOOST_CHECK(violation.avp == nullptr);
+
+    // A required AVP is missing, Failed-AVP has an example of it
+    avps = make_ccr();
+    avps.erase(avps.begin() + 7);
+    violation = dictionary::validate(avps, schema, dict);
+    BOOST_CHECK_EQUAL(violation.result_code, ResultCodeV::MissingAvp);
+    BOOST_CHECK_EQUAL(violation.code, 415u);
+    auto failed = violation.failed_avp();
+    BOOST_CHECK_EQUAL(failed.code, 415u);
+    BOOST_CHECK(failed.flags[dma::Flag::Mandatory]);
+    BOOST_CHECK(!failed.vendor_id.has_value());
+
+    // The second Origin-Host
+    avps = make_ccr();
+    avps.push_back(dcca::avp::OriginHost::make(dma::DiameterIdentity("other.example.org")));
+    violation = dictionary::validate(avps, schema, dict);
+    BOOST_CHECK_EQUAL(violation.result_code, ResultCodeV::AvpOccursTooManyTimes);
+    BOOST_CHECK(violation.avp == &avps.back());
+    BOOST_CHECK_EQUAL(violation.failed_avp().code, 264u);
+
+    // An unknown AVP with the 'M' flag
+    avps = make_ccr();
+    avps.insert(avps.begin() + 3, dma::AVP {9999, dma::Flags {uint8_t {0x40}}, std::nullopt,
+        dma::Unsigned32(uint32_t {1})});
+    violation = dictionary::validate(avps, schema, dict);
+    BOOST_CHECK_EQUAL(violation.result_code, ResultCodeV::AvpUnsupported);
+    BOOST_CHECK_EQUAL(violation.code, 9999u);
+    BOOST_CHECK(violation.avp == &avps[3]);
+
+    // Known to the dictionary, not in the grammar of the answer
+    avps = make_ccr();
+    violation = dictionary::validate(avps, dcca::schema::CreditControlAnswer, dict);
+    BOOST_CHECK_EQUAL(violation.result_code, ResultCodeV::MissingAvp);
+    BOOST_CHECK_EQUAL(violation.code, 268u);
+}
+
+BOOST_AUTO_TEST_CASE(runtime_schema)
+{
+    dictionary::XmlLoader loader;
+    loader.load_file(DIAMETER_DICTIONARIES_DIR "/base.xml");
+    loader.load_file(DIAMETER_DICTIONARIES_DIR "/dcca.xml");
+    auto loaded = loader.dictionary();
+    auto schema = dictionary::Schema(loaded.find_command(272, 4)->request);
+    auto view = schema.view();
+
+    const auto& generated = dcca::schema::CreditControlRequest;
+    BOOST_REQUIRE_EQUAL(view.size, generated.size);
+    BOOST_CHECK_EQUAL(view.fixed, 1);
+    BOOST_CHECK(view.any_avp);
+    for (std::size_t i = 0; i < view.size; ++i) {
+        BOOST_CHECK_EQUAL(view.rules[i].code, generated.rules[i].code);
+        BOOST_CHECK_EQUAL(view.rules[i].max, generated.rules[i].max);
+        BOOST_CHECK_EQUAL(view.index[i], generated.index[i]);
+    }
+    BOOST_CHECK(!dictionary::validate(make_ccr(), view, loaded));
+
+    // Without "* [ AVP ]" and with a forbidden AVP
+    AvpRules rules;
+    rules.rules.push_back(AvpRule {"Session-Id", 263, 0, RuleSectionV::Fixed, 1, 1});
+    rules.rules.push_back(AvpRule {"Origin-Host", 264, 0, RuleSectionV::Required, 1, 1});
+    rules.rules.push_back(AvpRule {"Origin-Realm", 296, 0, RuleSectionV::Optional, 0, 0});
+    auto strict = dictionary::Schema(rules);
+    auto avps = make_ccr();
+    avps.resize(2);
+    BOOST_CHECK(!dictionary::validate(avps, strict.view(), loaded));
+    avps.push_back(make_ccr()[2]);
+    auto violation = dictionary::validate(avps, strict.view(), loaded);
+    BOOST_CHECK_EQUAL(violation.result_code, ResultCodeV::AvpNotAllowed);
+    BOOST_CHECK(violation.avp == &avps[2]);
+    avps.back() = make_ccr()[3];
+    violation = dictionary::validate(avps, strict.view(), loaded);
+    BOOST_CHECK_EQUAL(violation.result_code, ResultCodeV::AvpNotAllowed);
+    BOOST_CHECK_EQUAL(violation.code, 283u);
+
+    rules.rules.resize(dictionary::CommandSchema::max_rules + 1);
+    BOOST_CHECK_THROW(dictionary::Schema {rules}, std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
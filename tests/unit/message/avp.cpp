@@ -2,7 +2,7 @@
 
 #include <diameter/message/avp/avp.h>
 
-#include <list>
+#include <vector>
 
 using namespace diameter::message::avp;
 
@@ -51,4 +51,24 @@ BOOST_AUTO_TEST_CASE(size_calculation)
     BOOST_CHECK_EQUAL(a.length(), 12);
 }
 
+BOOST_AUTO_TEST_CASE(flags_storage)
+{
+    BOOST_CHECK_EQUAL(sizeof(Flags), 1);
+
+    auto flags = Flags{uint8_t{0xE0}};
+    BOOST_CHECK_EQUAL(flags.all(), false);
+    BOOST_CHECK_EQUAL(flags.count(), 3);
+    BOOST_CHECK_EQUAL(flags.data(), 0xE0);
+
+    flags.reset(Flag::Protected);
+    BOOST_CHECK_EQUAL(flags[Flag::Protected], false);
+    BOOST_CHECK_EQUAL(flags[Flag::Mandatory], true);
+    BOOST_CHECK_EQUAL((flags ^ Flags{Flag::Mandatory}).data(), 0x80);
+    BOOST_CHECK_EQUAL((flags & Flags{Flag::Mandatory}).data(), 0x40);
+
+    flags.reset();
+    BOOST_CHECK_EQUAL(flags.none(), true);
+    BOOST_CHECK_EQUAL(Flags{uint8_t{0xFF}}.all(), true);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
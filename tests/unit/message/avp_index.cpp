@@ -0,0 +1,177 @@
+#include <boost/test/unit_test.hpp>
+
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+#include <optional>
+#include <stdexcept>
+#include <variant>
+#include <vector>
+
+#include <netpacker/netpacker.h>
+
+#include <diameter/dictionaries/dcca.h>
+#include <diameter/message/avp_index.h>
+#include <diameter/message/message.h>
+#include <diameter/serial/serial.h>
+
+using namespace diameter::message;
+
+namespace {
+
+const avp::Flags mandatory {avp::Flag::Mandatory};
+const avp::Flags vendor_mandatory = avp::Flags {avp::Flag::Mandatory} | avp::Flags {avp::Flag::VendorSpecific};
+
+// Credit-Control-Request with two Multiple-Services-Credit-Control AVPs
+Message make_ccr()
+{
+    auto mscc1 = avp::AvpList{
+        avp::AVP{437, mandatory, std::nullopt, avp::Grouped(avp::AvpList{
+            avp::AVP{421, mandatory, std::nullopt, avp::Unsigned64(uint64_t{1000})}
+        })},
+        avp::AVP{432, mandatory, std::nullopt, avp::Unsigned32(uint32_t{1})}
+    };
+    auto mscc2 = avp::AvpList{
+        avp::AVP{437, mandatory, std::nullopt, avp::Grouped(avp::AvpList{
+            avp::AVP{421, mandatory, std::nullopt, avp::Unsigned64(uint64_t{2000})}
+        })},
+        avp::AVP{432, mandatory, std::nullopt, avp::Unsigned32(uint32_t{2})}
+    };
+    auto service_information = avp::AvpList{
+        avp::AVP{874, vendor_mandatory, 10415, avp::Grouped(avp::AvpList{
+            avp::AVP{2, vendor_mandatory, 10415, avp::UTF8String("01234567")}
+        })}
+    };
+
+    Message msg;
+    msg.header.version = header::ProtocolVersion{header::ProtocolVersionV::V01};
+    msg.header.command_code = 272;
+    msg.header.application_id = 4;
+    msg.avps = avp::AvpList{
+        avp::AVP{263, mandatory, std::nullopt, avp::UTF8String("host.example.org;1;2")},
+        avp::AVP{264, mandatory, std::nullopt, avp::DiameterIdentity("host.example.org")},
+        avp::AVP{456, mandatory, std::nullopt, avp::Grouped(mscc1)},
+        avp::AVP{2, mandatory, std::nullopt, avp::Unsigned32(uint32_t{7})},
+        avp::AVP{456, mandatory, std::nullopt, avp::Grouped(mscc2)},
+        avp::AVP{873, vendor_mandatory, 10415, avp::Grouped(service_information)}
+    };
+    msg.size();
+    return msg;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(avp_index)
+
+BOOST_AUTO_TEST_CASE(find)
+{
+    auto msg = make_ccr();
+    auto index = AvpIndex(msg.avps);
+
+    BOOST_CHECK_EQUAL(index.size(), msg.avps.size());
+    BOOST_CHECK(index.find(263) == &msg.avps[0]);
+    BOOST_CHECK(index.find(264) == &msg.avps[1]);
+    BOOST_CHECK(index.find(268) == nullptr);
+
+    // Repeated AVPs in order of appearance
+    auto mscc = index.find_all(456);
+    BOOST_REQUIRE_EQUAL(mscc.size(), 2);
+    BOOST_CHECK(mscc[0] == &msg.avps[2]);
+    BOOST_CHECK(mscc[1] == &msg.avps[4]);
+    BOOST_CHECK(index.find_all(268).empty());
+
+    // Vendor id is part of the key
+    BOOST_CHECK(index.find(2) == &msg.avps[3]);
+    BOOST_CHECK(index.find(2, 10415) == nullptr);
+    BOOST_CHECK(index.find(873) == nullptr);
+    BOOST_CHECK(index.find(873, 10415) == &msg.avps[5]);
+
+    BOOST_CHECK(index.child(index.find(263)) == nullptr);
+    auto child = index.child(mscc[1]);
+    BOOST_REQUIRE(child != nullptr);
+    BOOST_CHECK(child->find(432) == &(*std::get<avp::Grouped>(msg.avps[4].value))[1]);
+
+    BOOST_CHECK(AvpIndex().find(263) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(find_path)
+{
+    auto msg = make_ccr();
+    auto index = AvpIndex(msg.avps);
+
+    auto rsu = index.find_path("456/437/421");
+    BOOST_REQUIRE(rsu != nullptr);
+    BOOST_CHECK_EQUAL(*std::get<avp::Unsigned64>(rsu->value), 1000);
+
+    rsu = index.find_path("456[1]/437[0]/421");
+    BOOST_REQUIRE(rsu != nullptr);
+    BOOST_CHECK_EQUAL(*std::get<avp::Unsigned64>(rsu->value), 2000);
+
+    auto msisdn = index.find_path("873@10415/874@10415/2@10415");
+    BOOST_REQUIRE(msisdn != nullptr);
+    BOOST_CHECK_EQUAL(*std::get<avp::UTF8String>(msisdn->value), "01234567");
+
+    BOOST_CHECK(index.find_path("263") == &msg.avps[0]);
+    BOOST_CHECK(index.find_path("456[2]/437") == nullptr);
+    BOOST_CHECK(index.find_path("873/874") == nullptr);
+    BOOST_CHECK(index.find_path("263/1") == nullptr);
+
+    BOOST_CHECK_THROW(index.find_path(""), std::invalid_argument);
+    BOOST_CHECK_THROW(index.find_path("456/"), std::invalid_argument);
+    BOOST_CHECK_THROW(index.find_path("456[1"), std::invalid_argument);
+    BOOST_CHECK_THROW(index.find_path("456@"), std::invalid_argument);
+    BOOST_CHECK_THROW(index.find_path("4294967296"), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(decode)
+{
+    auto ccr = make_ccr();
+    // CC-Total-Octets of 8: its value looks like an empty AVP
+    ccr.avps.push_back(avp::AVP{421, mandatory, std::nullopt, avp::Unsigned64(uint64_t{8})});
+    auto data = std::vector<uint8_t>(ccr.size());
+    netpacker::put(data.begin(), data.end(), ccr);
+
+    AvpIndex index;
+    auto pos = data.cbegin();
+    auto msg = netpacker::get<Message>(pos, data.cend(), index);
+
+    BOOST_CHECK(index.find(264) == &msg.avps[1]);
+    BOOST_CHECK_EQUAL(index.find_all(456).size(), 2);
+    // Without a predicate the values are raw, nothing is nested
+    BOOST_CHECK(std::holds_alternative<avp::OctetString>(msg.avps[4].value));
+    BOOST_CHECK(index.find_path("456[1]/432") == nullptr);
+
+    // The AVPs which are Grouped in the dictionary, and Service-Information of 3GPP
+    diameter::dictionaries::dcca::Dictionary dcca;
+    auto dictionary_grouped = diameter::serial::grouped_avps(dcca);
+    auto is_grouped = [&](avp::Code code, std::optional<avp::VendorId> vendor_id) {
+        return (vendor_id == 10415u && (code == 873 || code == 874))
+            || dictionary_grouped(code, vendor_id);
+    };
+    std::array<std::byte, 4096> buffer;
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(),
+        std::pmr::null_memory_resource());
+    pos = data.cbegin();
+    msg = netpacker::get<Message>(pos, data.cend(), index, is_grouped, &arena);
+    BOOST_CHECK(pos == data.cend());
+
+    const auto& mscc = std::get<avp::Grouped>(msg.avps[4].value);
+    BOOST_CHECK(mscc->get_allocator().resource() == &arena);
+    auto rsu = index.find_path("456[1]/437/421");
+    BOOST_REQUIRE(rsu != nullptr);
+    BOOST_CHECK_EQUAL(*diameter::serial::avp::value_as<avp::Unsigned64>(rsu->value), 2000);
+    auto msisdn = index.find_path("873@10415/874@10415/2@10415");
+    BOOST_REQUIRE(msisdn != nullptr);
+    BOOST_CHECK_EQUAL(msisdn->size(), 20);
+    // Not Grouped, whatever the bytes of the value
+    BOOST_CHECK(std::holds_alternative<avp::OctetString>(msg.avps[6].value));
+    BOOST_CHECK(index.child(&msg.avps[6]) == nullptr);
+    BOOST_CHECK(index.find_path("263/1") == nullptr);
+
+    // The same encoding
+    auto encoded = std::vector<uint8_t>(msg.size());
+    netpacker::put(encoded.begin(), encoded.end(), msg);
+    BOOST_CHECK(encoded == data);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -2,7 +2,7 @@
 
 #include <diameter/message/message.h>
 
-#include <list>
+#include <vector>
 
 using namespace diameter::message;
 
@@ -37,7 +37,7 @@ BOOST_AUTO_TEST_CASE(field_initialization)
             header::HopByHopIdentifier{0xdeadbeef},
             header::EndToEndIdentifier{0xcafebabe}
         },
-        std::list<avp::AVP>{
+        avp::AvpList{
             avp::AVP{1000, avp::Flags{avp::Flag::VendorSpecific} | avp::Flags{avp::Flag::Mandatory}, 10415, avp::Integer32(1)},
             avp::AVP{1001, avp::Flags{avp::Flag::Mandatory}, std::nullopt, avp::Integer64(1)}
         }
@@ -68,7 +68,7 @@ BOOST_AUTO_TEST_CASE(move_constructor)
             header::HopByHopIdentifier{0xdeadbeef},
             header::EndToEndIdentifier{0xcafebabe}
         },
-        std::list<avp::AVP>{
+        avp::AvpList{
             avp::AVP{1000, avp::Flags{avp::Flag::VendorSpecific} | avp::Flags{avp::Flag::Mandatory}, 10415, avp::Integer32(1)},
             avp::AVP{1001, avp::Flags{avp::Flag::Mandatory}, std::nullopt, avp::Integer64(1)}
         }
@@ -107,7 +107,7 @@ BOOST_AUTO_TEST_CASE(full_size_calculation)
             header::HopByHopIdentifier{0x6ad1d314},
             header::EndToEndIdentifier{0x77287404}
         },
-        std::list<avp::AVP>{
+        avp::AvpList{
             avp::AVP{264, avp::Flags{avp::Flag::Mandatory}, std::nullopt, avp::DiameterIdentity("testhost.epc.mnc000.mcc000.3gppnetwork.org")},
             avp::AVP{296, avp::Flags{avp::Flag::Mandatory}, std::nullopt, avp::DiameterIdentity("epc.mnc000.mcc000.3gppnetwork.org")},
             avp::AVP{257, avp::Flags{avp::Flag::Mandatory}, std::nullopt, avp::Address("127.0.0.1")},
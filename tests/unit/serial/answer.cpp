@@ -0,0 +1,159 @@
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include <netpacker/netpacker.h>
+
+#include <diameter/dictionaries/dcca.h>
+#include <diameter/dictionary/schema.h>
+#include <diameter/serial/answer.h>
+#include <diameter/serial/serial.h>
+
+using namespace diameter;
+
+namespace {
+
+namespace dma = message::avp;
+namespace dcca = dictionaries::dcca;
+
+using message::header::CommandFlag;
+
+std::vector<uint8_t> make_ccr()
+{
+    message::Message msg {serial::record::make_header(272, 4, true), dma::AvpList {
+        dcca::avp::SessionId::make(dma::UTF8String("pgw.example.org;1;2")),
+        dcca::avp::OriginHost::make(dma::DiameterIdentity("pgw.example.org")),
+        dcca::avp::OriginRealm::make(dma::DiameterIdentity("example.org")),
+        dcca::avp::DestinationRealm::make(dma::DiameterIdentity("ocs.example.org")),
+        dcca::avp::AuthApplicationId::make(uint32_t {4}),
+        dcca::avp::ServiceContextId::make(dma::UTF8String("32251@3gpp.org")),
+        dcca::avp::CcRequestType::make(dma::Enumerated(int32_t {1})),
+        dcca::avp::CcRequestNumber::make(uint32_t {0}),
+        dcca::avp::ProxyInfo::make(dma::Grouped(dma::AvpList {
+            dcca::avp::ProxyHost::make(dma::DiameterIdentity("dra1.example.org")),
+            dcca::avp::ProxyState::make(dma::OctetString(dma::OctetString::value_type {1})),
+        })),
+        dcca::avp::ProxyInfo::make(dma::Grouped(dma::AvpList {
+            dcca::avp::ProxyHost::make(dma::DiameterIdentity("dra2.example.org")),
+            dcca::avp::ProxyState::make(dma::OctetString(dma::OctetString::value_type {2})),
+        })),
+    }};
+    msg.header.command_flags.set(CommandFlag::Retransmitted);
+    msg.header.hop_by_hop = 0x11223344;
+    msg.header.end_to_end = 0x55667788;
+    auto data = std::vector<uint8_t>(msg.size());
+    netpacker::put(data.begin(), data.end(), msg);
+    return data;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(answer)
+
+BOOST_AUTO_TEST_CASE(make_answer)
+{
+    auto data = make_ccr();
+    auto request = serial::view::MessageView(data);
+    serial::AnswerBuilder builder("ocs.example.org", "example.org");
+
+    std::vector<uint8_t> out;
+    out.reserve(1024);
+    const auto* storage = out.data();
+    auto writer = builder.make_answer(request, application::base::ResultCodeV::Success, out);
+    writer.add<dcca::avp::AuthApplicationId>(uint32_t {4})
+        .add<dcca::avp::CcRequestType>(int32_t {1})
+        .add(*request.find(dcca::avp::CcRequestNumber::code))
+        .add(dcca::avp::ValidityTime::make(uint32_t {600}));
+    auto encoded = writer.finish();
+    BOOST_CHECK(out.data() == storage);
+    BOOST_CHECK(encoded.data() == out.data());
+    BOOST_CHECK_EQUAL(encoded.size(), out.size());
+
+    auto answer = serial::decode(encoded, dcca::Dictionary {});
+    BOOST_CHECK_EQUAL(answer.header.length, encoded.size());
+    BOOST_CHECK_EQUAL(answer.header.command_code, 272u);
+    BOOST_CHECK_EQUAL(answer.header.application_id, 4u);
+    BOOST_CHECK_EQUAL(answer.header.hop_by_hop, 0x11223344u);
+    BOOST_CHECK_EQUAL(answer.header.end_to_end, 0x55667788u);
+    BOOST_CHECK(!answer.header.command_flags[CommandFlag::Request]);
+    BOOST_CHECK(answer.header.command_flags[CommandFlag::Proxiable]);
+    BOOST_CHECK(!answer.header.command_flags[CommandFlag::Error]);
+    BOOST_CHECK(!answer.header.command_flags[CommandFlag::Retransmitted]);
+    BOOST_CHECK(!dictionary::validate(answer, dcca::schema::CreditControlAnswer,
+        dcca::Dictionary {}));
+
+    const auto& avps = answer.avps;
+    BOOST_REQUIRE_EQUAL(avps.size(), 10u);
+    BOOST_CHECK_EQUAL(avps[0].code, 263u);
+    BOOST_CHECK(**serial::avp::get<dcca::avp::SessionId>(avps) == "pgw.example.org;1;2");
+    BOOST_CHECK_EQUAL(**serial::avp::get<dcca::avp::ResultCode>(avps), 2001u);
+    BOOST_CHECK((*serial::avp::get<dcca::avp::OriginHost>(avps))->value() == "ocs.example.org");
+    BOOST_CHECK((*serial::avp::get<dcca::avp::OriginRealm>(avps))->value() == "example.org");
+    // The Proxy-Info AVPs are copied as they are, in their order
+    BOOST_CHECK_EQUAL(avps[4].code, 284u);
+    BOOST_CHECK_EQUAL(avps[5].code, 284u);
+    auto proxy_info = request.avps().begin();
+    std::advance(proxy_info, 9);
+    const auto* answer_proxy_info = encoded.data() + encoded.size() - 4 * 12
+        - proxy_info->size();
+    BOOST_CHECK(std::equal(proxy_info->raw().begin(), proxy_info->raw().end(),
+        answer_proxy_info));
+    BOOST_CHECK_EQUAL(**serial::avp::get<dcca::avp::ValidityTime>(avps), 600u);
+}
+
+BOOST_AUTO_TEST_CASE(protocol_error)
+{
+    auto data = make_ccr();
+    auto request = serial::view::MessageView(data);
+    serial::AnswerBuilder builder("ocs.example.org", "example.org");
+
+    // Appended after another answer
+    std::vector<uint8_t> out;
+    builder.make_answer(request, application::base::ResultCodeV::Success, out).finish();
+    auto offset = out.size();
+    auto encoded = builder.make_answer(request, application::base::ResultCodeV::TooBusy, out)
+        .finish();
+    BOOST_CHECK(encoded.data() == out.data() + offset);
+
+    auto answer = serial::view::MessageView(encoded);
+    BOOST_CHECK_EQUAL(answer.length(), encoded.size());
+    BOOST_CHECK(answer.header().command_flags[CommandFlag::Error]);
+    BOOST_CHECK_EQUAL(answer.avps().count(), 6u);
+
+    // Without Result-Code
+    out.clear();
+    encoded = builder.make_answer(request, 0, out).finish();
+    answer = serial::view::MessageView(encoded);
+    BOOST_CHECK(!answer.find(268).has_value());
+    BOOST_CHECK_EQUAL(answer.avps().count(), 5u);
+
+    BOOST_CHECK_THROW(serial::AnswerBuilder("ocs..example.org", "example.org"),
+        std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(request_in_buffer)
+{
+    serial::AnswerBuilder builder("ocs.example.org", "example.org");
+    auto expected = std::vector<uint8_t>();
+    auto data = make_ccr();
+    builder.make_answer(serial::view::MessageView(data), 2001, expected).finish();
+
+    // The answer follows the request in the same buffer, the capacity holds both
+    auto out = make_ccr();
+    auto request_size = out.size();
+    out.reserve(request_size + expected.size());
+    auto request = serial::view::MessageView(message::ByteSpan(out.data(), request_size));
+    auto encoded = builder.make_answer(request, 2001, out).finish();
+    BOOST_CHECK(std::equal(encoded.begin(), encoded.end(), expected.begin(), expected.end()));
+
+    // Growing the buffer would free the request
+    out = make_ccr();
+    out.shrink_to_fit();
+    request = serial::view::MessageView(message::ByteSpan(out.data(), out.size()));
+    BOOST_CHECK_THROW(builder.make_answer(request, 2001, out), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,172 @@
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+
+#include <netpacker/netpacker.h>
+
+#include <diameter/application/base/avp.h>
+#include <diameter/message/message.h>
+#include <diameter/serial/serial.h>
+
+using namespace diameter;
+
+namespace {
+
+namespace dma = message::avp;
+namespace base = application::base;
+
+// 3GPP MSISDN, for a vendor-specific definition
+using MsisdnDef = dma::AvpDef<701, 10415, dma::OctetString>;
+
+static_assert(base::avp::SessionId::header_length == 8);
+static_assert(base::avp::SessionId::header[2] == 0x01 && base::avp::SessionId::header[3] == 0x07);
+static_assert(base::avp::SessionId::header[4] == 0x40);
+static_assert(base::avp::ProductName::flag_bits == 0x00);
+static_assert(MsisdnDef::header_length == 12);
+static_assert(MsisdnDef::header[2] == 0x02 && MsisdnDef::header[3] == 0xBD);
+static_assert(MsisdnDef::header[4] == 0xC0);
+static_assert(MsisdnDef::header[10] == 0x28 && MsisdnDef::header[11] == 0xAF);
+static_assert(dma::is_value_alternative_v<dma::Grouped>);
+static_assert(!dma::is_value_alternative_v<uint32_t>);
+
+template<typename Def>
+void check_put(const typename Def::value_type& value)
+{
+    auto avp = Def::make(value);
+    auto expected = std::vector<uint8_t>(avp.size());
+    netpacker::put(expected.begin(), expected.end(), avp);
+
+    auto actual = std::vector<uint8_t>(avp.size());
+    auto pos = serial::avp::put<Def>(actual.begin(), actual.end(), value);
+    BOOST_CHECK(pos == actual.end());
+    BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(avp_def)
+
+BOOST_AUTO_TEST_CASE(put)
+{
+    check_put<base::avp::SessionId>(dma::UTF8String("host.example.org;1;2"));
+    check_put<base::avp::OriginHost>(dma::DiameterIdentity("host.example.org"));
+    check_put<base::avp::ResultCode>(dma::Unsigned32(uint32_t{2001}));
+    check_put<base::avp::AccountingSubSessionId>(dma::Unsigned64(uint64_t{1} << 40));
+    check_put<base::avp::EventTimestamp>(dma::Time(uint32_t{0xe9f6d345}));
+    check_put<base::avp::AuthSessionState>(dma::Enumerated(1));
+    check_put<base::avp::HostIpAddress>(dma::Address("10.0.0.1"));
+    check_put<base::avp::RedirectHost>(dma::DiameterURI("aaa://host.example.com;transport=tcp"));
+    check_put<base::avp::ProductName>(dma::UTF8String("ExampleProduct"));
+    check_put<MsisdnDef>(
+        dma::OctetString(dma::OctetString::value_type{0x97, 0x10, 0x32, 0x54, 0x76}));
+    check_put<base::avp::VendorSpecificApplicationId>(dma::Grouped(dma::AvpList{
+        base::avp::VendorId::make(uint32_t{10415}),
+        base::avp::AuthApplicationId::make(uint32_t{16777251})
+    }));
+}
+
+BOOST_AUTO_TEST_CASE(put_overflow)
+{
+    auto data = std::vector<uint8_t>(10);
+    BOOST_CHECK_THROW(serial::avp::put<base::avp::ResultCode>(data.begin(), data.end(),
+        dma::Unsigned32(uint32_t{2001})), netpacker::BufferOverflow);
+    BOOST_CHECK_THROW(serial::avp::put<MsisdnDef>(data.begin(), data.begin() + 8,
+        dma::OctetString(dma::OctetString::value_type{0x01})), netpacker::BufferOverflow);
+}
+
+BOOST_AUTO_TEST_CASE(get_decoded)
+{
+    auto avps = dma::AvpList{
+        base::avp::SessionId::make(dma::UTF8String("host.example.org;1;2")),
+        base::avp::ResultCode::make(uint32_t{2001}),
+        MsisdnDef::make(dma::OctetString(dma::OctetString::value_type{0x97, 0x10}))
+    };
+    message::Message msg {message::header::Header{}, avps};
+    msg.header.version = message::header::ProtocolVersionV::V01;
+    auto data = std::vector<uint8_t>(msg.size());
+    netpacker::put(data.begin(), data.end(), msg);
+
+    auto pos = data.cbegin();
+    auto decoded = netpacker::get<message::Message>(pos, data.cend());
+
+    auto session_id = serial::avp::get<base::avp::SessionId>(decoded.avps);
+    BOOST_REQUIRE(session_id.has_value());
+    BOOST_CHECK_EQUAL(**session_id, "host.example.org;1;2");
+    BOOST_CHECK_EQUAL(**serial::avp::get<base::avp::ResultCode>(decoded.avps), 2001);
+    BOOST_CHECK_EQUAL((*serial::avp::get<MsisdnDef>(decoded.avps))->size(), 2);
+    BOOST_CHECK(!serial::avp::get<base::avp::OriginHost>(decoded.avps).has_value());
+    // Same code, another vendor
+    using VendorResultCode = dma::AvpDef<268, 10415, dma::Unsigned32>;
+    BOOST_CHECK(serial::avp::find<VendorResultCode>(decoded.avps) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(set)
+{
+    auto avps = dma::AvpList{base::avp::ResultCode::make(uint32_t{2001})};
+
+    serial::avp::set<base::avp::ResultCode>(avps, uint32_t{5012});
+    serial::avp::set<base::avp::ErrorMessage>(avps, dma::UTF8String("unable to comply"));
+
+    BOOST_REQUIRE_EQUAL(avps.size(), 2);
+    BOOST_CHECK_EQUAL(*std::get<dma::Unsigned32>(avps[0].value), 5012);
+    BOOST_CHECK_EQUAL(avps[1].code, 281);
+    BOOST_CHECK(!avps[1].flags[dma::Flag::Mandatory]);
+    BOOST_CHECK(!avps[1].vendor_id.has_value());
+
+    auto& msisdn = serial::avp::set<MsisdnDef>(avps,
+        dma::OctetString(dma::OctetString::value_type{0x01}));
+    BOOST_CHECK(msisdn.flags[dma::Flag::VendorSpecific]);
+    BOOST_CHECK_EQUAL(msisdn.vendor_id.value(), 10415);
+}
+
+BOOST_AUTO_TEST_CASE(get_interned)
+{
+    dma::value::IdentityTable table;
+    const auto* own = table.intern("dra1.example.org");
+
+    auto avps = dma::AvpList{
+        base::avp::OriginHost::make(dma::DiameterIdentity("peer.example.org")),
+        base::avp::RouteRecord::make(dma::DiameterIdentity("dra2.example.org")),
+        base::avp::RouteRecord::make(dma::DiameterIdentity("dra1.example.org")),
+        base::avp::RouteRecord::make(dma::DiameterIdentity("dra3..example.org"))
+    };
+    message::Message msg {message::header::Header{}, avps};
+    msg.header.version = message::header::ProtocolVersionV::V01;
+    auto data = std::vector<uint8_t>(msg.size());
+    netpacker::put(data.begin(), data.end(), msg);
+
+    auto pos = data.cbegin();
+    auto decoded = netpacker::get<message::Message>(pos, data.cend());
+
+    // get() only looks the value up, the table is not filled from the wire
+    auto origin_host = serial::avp::get<base::avp::OriginHost>(decoded.avps, table);
+    BOOST_REQUIRE(origin_host.has_value());
+    BOOST_CHECK_EQUAL((*origin_host)->value(), "peer.example.org");
+    BOOST_CHECK((*origin_host)->entry() == nullptr);
+    BOOST_CHECK_EQUAL(table.size(), 1);
+    BOOST_CHECK(!serial::avp::get<base::avp::DestinationHost>(decoded.avps, table).has_value());
+    auto own_route = serial::avp::get<base::avp::RouteRecord>(decoded.avps[2], table);
+    BOOST_CHECK(own_route->entry() == own);
+
+    // Loop detection: the own identity in the Route-Record AVPs
+    serial::avp::intern<base::avp::RouteRecord>(decoded.avps, table);
+    std::size_t loops = 0;
+    for (const auto& avp : decoded.avps) {
+        if (base::avp::RouteRecord::matches(avp)) {
+            const auto& route = std::get<dma::DiameterIdentity>(avp.value);
+            loops += route->entry() == own ? 1u : 0u;
+        }
+    }
+    BOOST_CHECK_EQUAL(loops, 1);
+    // Not an FQDN: kept as a copy of the text
+    const auto& invalid = std::get<dma::DiameterIdentity>(decoded.avps[3].value);
+    BOOST_CHECK(invalid->entry() == nullptr);
+    BOOST_CHECK_EQUAL(invalid->value(), "dra3..example.org");
+    BOOST_CHECK_EQUAL(table.size(), 2);
+    // Already interned values are kept as they are
+    auto route = serial::avp::get<base::avp::RouteRecord>(decoded.avps, table);
+    BOOST_CHECK((*route)->entry() == table.find("dra2.example.org"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
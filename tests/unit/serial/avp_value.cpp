@@ -81,4 +81,44 @@ BOOST_AUTO_TEST_CASE(time)
     BOOST_CHECK_EQUAL(value1->value(), *value4);
 }
 
+BOOST_AUTO_TEST_CASE(put_direct)
+{
+    // Every alternative written directly matches its OctetString form
+    auto grouped = Grouped(AvpList{
+        AVP{258, Flags{Flag::Mandatory}, std::nullopt, Unsigned32(uint32_t{4})},
+        AVP{1, Flags{Flag::Mandatory} | Flags{Flag::VendorSpecific}, 10415, UTF8String("abcde")}
+    });
+    auto values = std::vector<Value>{
+        OctetString(std::vector<uint8_t>{0x01, 0x02, 0x03}),
+        Integer32(int32_t{-2}),
+        Integer64(int64_t{-3}),
+        Unsigned32(uint32_t{0xfffffffe}),
+        Unsigned64(uint64_t{1} << 40),
+        Float32(1.5f),
+        Float64(-2.25),
+        Address("10.0.0.1"),
+        Address(value::AddressFamilyV::IPv6, "2001:db8::1"),
+        Time(uint32_t{0xe9f6d345}),
+        UTF8String("ExampleProduct"),
+        DiameterIdentity("host.example.org"),
+        DiameterURI("aaa://host.example.com:6666;transport=tcp"),
+        Enumerated(1004),
+        IPFilterRule("permit in tcp from any to any 443"),
+        grouped
+    };
+
+    for (const auto& value : values) {
+        auto expected = diameter::serial::avp::value_as<OctetString>(value);
+        auto data = std::vector<uint8_t>(expected->size());
+        auto pos = netpacker::put(data.begin(), data.end(), value);
+        BOOST_CHECK(pos == data.end());
+        BOOST_CHECK_EQUAL_COLLECTIONS(data.begin(), data.end(), expected->begin(), expected->end());
+
+        // Overflow of a value or of the padding of a nested AVP
+        auto short_data = std::vector<uint8_t>(expected->size() - 1);
+        BOOST_CHECK_THROW(netpacker::put(short_data.begin(), short_data.end(), value),
+            std::exception);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,121 @@
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+
+#include <diameter/serial/batch.h>
+#include <diameter/serial/framer.h>
+
+#include "../../helpers/from_hex.h"
+
+using namespace diameter;
+
+namespace {
+
+// Device-Watchdog-Request with Origin-Host and Origin-Realm
+const std::string dwr_hexed = \
+    "01000038800001180000000000000001" \
+    "00000001000001084000000E686F7374" \
+    "2E61000000000128400000136578616D" \
+    "706C652E6F726700";
+
+std::vector<uint8_t> make_stream(std::size_t count)
+{
+    std::vector<uint8_t> msg;
+    load_from_hex(dwr_hexed, msg);
+
+    std::vector<uint8_t> stream;
+    for (std::size_t i = 0; i < count; ++i) {
+        msg[15] = static_cast<uint8_t>(i);
+        stream.insert(stream.end(), msg.begin(), msg.end());
+    }
+    return stream;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(batch)
+
+BOOST_AUTO_TEST_CASE(scan)
+{
+    auto stream = make_stream(3);
+    // Incomplete fourth message
+    stream.insert(stream.end(), stream.begin(), stream.begin() + 30);
+
+    serial::FrameBatch batch;
+    BOOST_CHECK_EQUAL(batch.scan(stream), 3 * 56);
+    BOOST_CHECK_EQUAL(batch.consumed(), 3 * 56);
+    BOOST_CHECK(!batch.error());
+    BOOST_REQUIRE_EQUAL(batch.size(), 3);
+
+    std::size_t i = 0;
+    for (const auto& frame : batch) {
+        BOOST_CHECK(frame.data.data() == stream.data() + i * 56);
+        BOOST_CHECK_EQUAL(frame.data.size(), 56);
+        BOOST_CHECK_EQUAL(frame.is_request(), true);
+        BOOST_CHECK_EQUAL(frame.command_code, 280);
+        BOOST_CHECK_EQUAL(frame.application_id, 0);
+        BOOST_CHECK_EQUAL(frame.hop_by_hop, i);
+
+        auto view = frame.view();
+        BOOST_REQUIRE(view.has_value());
+        BOOST_CHECK_EQUAL(view->avps().count(), 2);
+        ++i;
+    }
+
+    // Too short for a header
+    BOOST_CHECK_EQUAL(batch.scan(message::ByteSpan(stream).first(19)), 0);
+    BOOST_CHECK(batch.empty());
+    BOOST_CHECK(!batch.error());
+}
+
+BOOST_AUTO_TEST_CASE(invalid_header)
+{
+    serial::FrameBatch batch;
+
+    auto version = make_stream(3);
+    version[56] = 0x02;
+    BOOST_CHECK_EQUAL(batch.scan(version), 56);
+    BOOST_CHECK_EQUAL(batch.size(), 1);
+    BOOST_CHECK_EQUAL(batch.error().code, serial::DecodeErrorV::UnsupportedVersion);
+    BOOST_CHECK_EQUAL(batch.error().offset, 56);
+
+    auto bits = make_stream(3);
+    bits[2 * 56 + 4] = 0xA0;
+    BOOST_CHECK_EQUAL(batch.scan(bits), 2 * 56);
+    BOOST_CHECK_EQUAL(batch.size(), 2);
+    BOOST_CHECK_EQUAL(batch.error().code, serial::DecodeErrorV::InvalidHeaderBits);
+    BOOST_CHECK_EQUAL(batch.error().offset, 2 * 56 + 4);
+
+    auto length = make_stream(3);
+    length[56 + 3] = 0x10;
+    BOOST_CHECK_EQUAL(batch.scan(length), 56);
+    BOOST_CHECK_EQUAL(batch.size(), 1);
+    BOOST_CHECK_EQUAL(batch.error().code, serial::DecodeErrorV::InvalidMessageLength);
+    BOOST_CHECK_EQUAL(batch.error().offset, 56 + 1);
+
+    serial::FrameBatch small(40);
+    auto one = make_stream(1);
+    BOOST_CHECK_EQUAL(small.scan(one), 0);
+    BOOST_CHECK_EQUAL(small.error().code, serial::DecodeErrorV::InvalidMessageLength);
+}
+
+BOOST_AUTO_TEST_CASE(framer_pending)
+{
+    auto stream = make_stream(5);
+
+    serial::Framer framer;
+    serial::FrameBatch batch;
+    framer.feed(message::ByteSpan(stream).first(3 * 56 + 10));
+    framer.consume(batch.scan(framer.pending()));
+    BOOST_CHECK_EQUAL(batch.size(), 3);
+    BOOST_CHECK_EQUAL(framer.buffered(), 10);
+
+    framer.feed(message::ByteSpan(stream).subspan(3 * 56 + 10));
+    framer.consume(batch.scan(framer.pending()));
+    BOOST_CHECK_EQUAL(batch.size(), 2);
+    BOOST_CHECK_EQUAL(batch[1].hop_by_hop, 4);
+    BOOST_CHECK_EQUAL(framer.buffered(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,121 @@
+#include <boost/test/unit_test.hpp>
+
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include <diameter/application/base/result_code.h>
+#include <diameter/serial/serial.h>
+
+#include "../../helpers/from_hex.h"
+
+using namespace diameter;
+using application::base::ResultCodeV;
+
+namespace {
+
+const std::string cer_hexed = \
+    "010000C080000101000000006AD1D314" \
+    "77287404000001084000003274657374" \
+    "686F73742E6570632E6D6E633030302E" \
+    "6D63633030302E336770706E6574776F" \
+    "726B2E6F726700000000012840000029" \
+    "6570632E6D6E633030302E6D63633030" \
+    "302E336770706E6574776F726B2E6F72" \
+    "67000000000001014000000E00017F00" \
+    "000100000000010A4000000C000028AF" \
+    "0000010D000000164578616D706C6550" \
+    "726F647563740000000001024000000C" \
+    "00000004000001094000000C000028AF";
+
+}
+
+BOOST_AUTO_TEST_SUITE(decode)
+
+BOOST_AUTO_TEST_CASE(try_decode)
+{
+    std::vector<uint8_t> data;
+    load_from_hex(cer_hexed, data);
+
+    auto msg = serial::try_decode(data);
+    BOOST_REQUIRE(msg.has_value());
+    BOOST_CHECK_EQUAL(msg.error().code, serial::DecodeErrorV::None);
+    BOOST_CHECK_EQUAL(msg->header.command_code, 257);
+    BOOST_CHECK_EQUAL(msg->avps.size(), 7);
+    BOOST_CHECK_EQUAL(msg->avps.front().code, 264);
+
+    auto view = serial::view::MessageView::try_parse(data);
+    BOOST_REQUIRE(view.has_value());
+    BOOST_CHECK_EQUAL(view->avps().count(), 7);
+}
+
+BOOST_AUTO_TEST_CASE(header_errors)
+{
+    std::vector<uint8_t> data;
+    load_from_hex(cer_hexed, data);
+
+    // Nothing is allocated on failure
+    auto previous = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+
+    auto truncated = serial::try_decode(message::ByteSpan(data).first(100));
+    auto bad_version = data;
+    bad_version[0] = 0x02;
+    auto version = serial::try_decode(bad_version);
+    auto bad_length = data;
+    bad_length[3] = 0xC2;
+    auto length = serial::try_decode(bad_length);
+    auto bad_bits = data;
+    bad_bits[4] = 0xA0;
+    auto bits = serial::try_decode(bad_bits);
+
+    std::pmr::set_default_resource(previous);
+
+    BOOST_REQUIRE(!truncated);
+    BOOST_CHECK_EQUAL(truncated.error().code, serial::DecodeErrorV::Truncated);
+    BOOST_CHECK_EQUAL(truncated.error().offset, 100);
+    BOOST_CHECK_EQUAL(truncated.error().result_code(), ResultCodeV::InvalidMessageLength);
+
+    BOOST_REQUIRE(!version);
+    BOOST_CHECK_EQUAL(version.error().code, serial::DecodeErrorV::UnsupportedVersion);
+    BOOST_CHECK_EQUAL(version.error().offset, 0);
+    BOOST_CHECK_EQUAL(version.error().result_code(), ResultCodeV::UnsupportedVersion);
+
+    BOOST_REQUIRE(!length);
+    BOOST_CHECK_EQUAL(length.error().code, serial::DecodeErrorV::InvalidMessageLength);
+    BOOST_CHECK_EQUAL(length.error().offset, 1);
+    BOOST_CHECK_EQUAL(length.error().result_code(), ResultCodeV::InvalidMessageLength);
+
+    BOOST_REQUIRE(!bits);
+    BOOST_CHECK_EQUAL(bits.error().code, serial::DecodeErrorV::InvalidHeaderBits);
+    BOOST_CHECK_EQUAL(bits.error().offset, 4);
+    BOOST_CHECK_EQUAL(bits.error().result_code(), ResultCodeV::InvalidHdrBits);
+    BOOST_CHECK_THROW(serial::view::MessageView{bad_bits}, serial::InvalidHeaderBits);
+}
+
+BOOST_AUTO_TEST_CASE(avp_errors)
+{
+    std::vector<uint8_t> data;
+    load_from_hex(cer_hexed, data);
+
+    // Origin-Realm (second AVP, at offset 72) length points beyond the message
+    auto out_of_bounds = data;
+    out_of_bounds[79] = 0xff;
+    auto result = serial::try_decode(out_of_bounds);
+    BOOST_REQUIRE(!result);
+    BOOST_CHECK_EQUAL(result.error().code, serial::DecodeErrorV::InvalidAvpLength);
+    BOOST_CHECK_EQUAL(result.error().offset, 72);
+    BOOST_CHECK_EQUAL(result.error().avp_code, 296);
+    BOOST_CHECK_EQUAL(result.error().result_code(), ResultCodeV::InvalidAvpLength);
+
+    // Origin-Host length is smaller than the AVP header
+    auto too_small = data;
+    too_small[27] = 0x04;
+    result = serial::try_decode(too_small);
+    BOOST_REQUIRE(!result);
+    BOOST_CHECK_EQUAL(result.error().offset, 20);
+    BOOST_CHECK_EQUAL(result.error().avp_code, 264);
+    BOOST_CHECK_EQUAL(std::string(result.error().reason), "Invalid avp length: too small");
+    BOOST_CHECK_THROW(serial::view::MessageView{too_small}, serial::InvalidAvpLength);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,213 @@
+#include <boost/test/unit_test.hpp>
+
+#include <array>
+#include <memory_resource>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include <netpacker/netpacker.h>
+
+#include <diameter/application/base/avp.h>
+#include <diameter/application/base/result_code.h>
+#include <diameter/dictionaries/base.h>
+#include <diameter/dictionary/dictionary.h>
+#include <diameter/serial/serial.h>
+
+using namespace diameter;
+using application::base::ResultCodeV;
+
+namespace {
+
+namespace dma = message::avp;
+namespace base = application::base;
+
+using dictionary::AvpDefinition;
+using dictionary::AvpTypeV;
+
+dictionary::Dictionary make_dictionary()
+{
+    std::vector<AvpDefinition> avps;
+    avps.push_back(AvpDefinition {"Origin-Host", 264, 0, AvpTypeV::DiameterIdentity, 0x40, {}, {}});
+    avps.push_back(AvpDefinition {"Result-Code", 268, 0, AvpTypeV::Unsigned32, 0x40, {}, {}});
+    avps.push_back(AvpDefinition {"Host-IP-Address", 257, 0, AvpTypeV::Address, 0x40, {}, {}});
+    avps.push_back(AvpDefinition {"Event-Timestamp", 55, 0, AvpTypeV::Time, 0x40, {}, {}});
+    avps.push_back(AvpDefinition {"Session-Id", 263, 0, AvpTypeV::UTF8String, 0x40, {}, {}});
+    avps.push_back(AvpDefinition {"Proxy-Info", 284, 0, AvpTypeV::Grouped, 0x40, {}, {}});
+    avps.push_back(AvpDefinition {"Proxy-Host", 280, 0, AvpTypeV::DiameterIdentity, 0x40, {}, {}});
+    avps.push_back(AvpDefinition {"QoS-Class-Identifier", 1028, 10415, AvpTypeV::Enumerated, 0xC0,
+        {}, {}});
+    avps.push_back(AvpDefinition {"Float", 9999, 10415, AvpTypeV::Float64, 0x80, {}, {}});
+    return dictionary::Dictionary({}, std::move(avps), {});
+}
+
+std::vector<uint8_t> encode(const dma::AvpList& avps)
+{
+    message::Message msg {message::header::Header{}, avps};
+    msg.header.version = message::header::ProtocolVersionV::V01;
+    auto data = std::vector<uint8_t>(msg.size());
+    netpacker::put(data.begin(), data.end(), msg);
+    return data;
+}
+
+// A message of Proxy-Info AVPs nested `depth` times, the innermost one is empty
+std::vector<uint8_t> encode_nested(std::size_t depth)
+{
+    auto data = encode(dma::AvpList {});
+    auto size = data.size();
+    data.resize(size + 8 * depth);
+    for (std::size_t i = 0; i < depth; ++i) {
+        auto* p = data.data() + size + 8 * i;
+        serial::detail::store_u32(p, 284);
+        serial::detail::store_u32(p + 4, static_cast<uint32_t>(8 * (depth - i)));
+        p[4] = 0x40;
+    }
+    serial::detail::store_u24(data.data() + 1, static_cast<uint32_t>(data.size()));
+    return data;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(serial_dictionary)
+
+BOOST_AUTO_TEST_CASE(typed_decode)
+{
+    auto dict = make_dictionary();
+    auto proxy_info = dma::AvpList {
+        base::avp::ProxyHost::make(dma::DiameterIdentity("proxy.example.org")),
+        base::avp::ProxyState::make(dma::OctetString(dma::OctetString::value_type {1, 2, 3}))
+    };
+    auto data = encode(dma::AvpList {
+        base::avp::SessionId::make(dma::UTF8String("host.example.org;1;2")),
+        base::avp::OriginHost::make(dma::DiameterIdentity("host.example.org")),
+        base::avp::ResultCode::make(uint32_t {2001}),
+        base::avp::HostIpAddress::make(dma::Address("10.0.0.1")),
+        base::avp::EventTimestamp::make(dma::Time(uint32_t {3900000000})),
+        base::avp::ProxyInfo::make(dma::Grouped(proxy_info)),
+        dma::AvpDef<1028, 10415, dma::Enumerated>::make(dma::Enumerated(int32_t {9})),
+        dma::AvpDef<9999, 10415, dma::Float64>::make(dma::Float64(2.5)),
+        base::avp::ProductName::make(dma::UTF8String("product")),
+    });
+
+    std::array<std::byte, 4096> buffer;
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(),
+        std::pmr::null_memory_resource());
+    auto result = serial::try_decode(data, dict, &arena);
+    BOOST_REQUIRE(result.has_value());
+    const auto& avps = result->avps;
+    BOOST_REQUIRE_EQUAL(avps.size(), 9);
+    BOOST_CHECK_EQUAL(result->size(), data.size());
+
+    BOOST_CHECK_EQUAL(*std::get<dma::UTF8String>(avps[0].value), "host.example.org;1;2");
+    BOOST_CHECK_EQUAL(std::get<dma::DiameterIdentity>(avps[1].value)->value(), "host.example.org");
+    BOOST_CHECK_EQUAL(*std::get<dma::Unsigned32>(avps[2].value), 2001);
+    BOOST_CHECK_EQUAL(std::get<dma::Address>(avps[3].value)->address_string(), "10.0.0.1");
+    BOOST_CHECK_EQUAL(std::get<dma::Time>(avps[4].value)->value(), 3900000000);
+    BOOST_CHECK_EQUAL(std::get<dma::Enumerated>(avps[6].value)->value(), 9);
+    BOOST_CHECK_EQUAL(*std::get<dma::Float64>(avps[7].value), 2.5);
+    BOOST_CHECK_EQUAL(avps[7].vendor_id.value(), 10415);
+    // Not in the dictionary
+    BOOST_CHECK(std::holds_alternative<dma::OctetString>(avps[8].value));
+
+    // Grouped values are expanded, the nested AVPs are typed too
+    const auto& nested = *std::get<dma::Grouped>(avps[5].value);
+    BOOST_REQUIRE_EQUAL(nested.size(), 2);
+    BOOST_CHECK_EQUAL(std::get<dma::DiameterIdentity>(nested[0].value)->value(),
+        "proxy.example.org");
+    BOOST_CHECK_EQUAL((*std::get<dma::OctetString>(nested[1].value)).size(), 3);
+    BOOST_CHECK(nested.get_allocator().resource() == &arena);
+
+    // The same encoding
+    message::Message msg {result->header, avps};
+    auto encoded = std::vector<uint8_t>(msg.size());
+    netpacker::put(encoded.begin(), encoded.end(), msg);
+    BOOST_CHECK(encoded == data);
+}
+
+BOOST_AUTO_TEST_CASE(invalid_value_length)
+{
+    auto dict = make_dictionary();
+
+    // Result-Code with a 2-byte value
+    auto data = encode(dma::AvpList {
+        base::avp::OriginHost::make(dma::DiameterIdentity("host.example.org")),
+        dma::AVP {268, dma::Flags {dma::Flag::Mandatory}, std::nullopt,
+            dma::OctetString(dma::OctetString::value_type {0x07, 0xD1})}
+    });
+    auto result = serial::try_decode(data, dict);
+    BOOST_REQUIRE(!result.has_value());
+    BOOST_CHECK_EQUAL(result.error().code, serial::DecodeErrorV::InvalidAvpLength);
+    BOOST_CHECK_EQUAL(result.error().avp_code, 268);
+    BOOST_CHECK_EQUAL(result.error().offset, 20 + 24);
+    BOOST_CHECK_EQUAL(result.error().result_code(), ResultCodeV::InvalidAvpLength);
+    BOOST_CHECK_THROW(serial::decode(data, dict), serial::InvalidAvpLength);
+
+    // Proxy-Info which is not a list of AVPs: the nested AVP is reported
+    data = encode(dma::AvpList {
+        dma::AVP {284, dma::Flags {dma::Flag::Mandatory}, std::nullopt,
+            dma::OctetString(dma::OctetString::value_type {0, 0, 1, 24, 0x40, 0, 0, 20})}
+    });
+    result = serial::try_decode(data, dict);
+    BOOST_REQUIRE(!result.has_value());
+    BOOST_CHECK_EQUAL(result.error().avp_code, 280);
+    BOOST_CHECK_EQUAL(result.error().offset, 20 + 8);
+
+    // Without the dictionary the values stay raw
+    BOOST_CHECK(serial::try_decode(data).has_value());
+}
+
+BOOST_AUTO_TEST_CASE(nesting_depth)
+{
+    dictionaries::base::Dictionary dict;
+
+    auto data = encode_nested(serial::max_nesting_depth);
+    auto result = serial::try_decode(data, dict);
+    BOOST_REQUIRE(result.has_value());
+    const auto* avps = &result->avps;
+    for (std::size_t i = 1; i < serial::max_nesting_depth; ++i) {
+        BOOST_REQUIRE_EQUAL(avps->size(), 1);
+        avps = &*std::get<dma::Grouped>((*avps)[0].value);
+    }
+    BOOST_REQUIRE_EQUAL(avps->size(), 1);
+    BOOST_CHECK((*std::get<dma::Grouped>((*avps)[0].value)).empty());
+
+    // One level more than the limit: the innermost Proxy-Info is not expanded
+    data = encode_nested(serial::max_nesting_depth + 1);
+    result = serial::try_decode(data, dict);
+    BOOST_REQUIRE(!result.has_value());
+    BOOST_CHECK_EQUAL(result.error().code, serial::DecodeErrorV::NestingTooDeep);
+    BOOST_CHECK_EQUAL(result.error().avp_code, 284);
+    BOOST_CHECK_EQUAL(result.error().offset, 20 + 8 * serial::max_nesting_depth);
+    BOOST_CHECK_EQUAL(result.error().result_code(), ResultCodeV::InvalidAvpValue);
+    BOOST_CHECK_THROW(serial::decode(data, dict), serial::InvalidAvpNesting);
+    BOOST_CHECK(serial::try_decode(data, dict, std::pmr::get_default_resource(),
+        serial::max_nesting_depth + 1).has_value());
+
+    // A 320 KB message does not exhaust the stack
+    data = encode_nested(40000);
+    result = serial::try_decode(data, dict);
+    BOOST_REQUIRE(!result.has_value());
+    BOOST_CHECK_EQUAL(result.error().code, serial::DecodeErrorV::NestingTooDeep);
+
+    // The nested AVPs are still checked
+    data = encode_nested(3);
+    serial::detail::store_u24(data.data() + 20 + 16 + 5, 16);
+    result = serial::try_decode(data, dict);
+    BOOST_REQUIRE(!result.has_value());
+    BOOST_CHECK_EQUAL(result.error().code, serial::DecodeErrorV::InvalidAvpLength);
+    BOOST_CHECK_EQUAL(result.error().offset, 20 + 16);
+}
+
+BOOST_AUTO_TEST_CASE(decode_value)
+{
+    const uint8_t bytes[] = {0x40, 0x04, 0, 0, 0, 0, 0, 0};
+    auto value = serial::decode_value(AvpTypeV::Float64, message::ByteSpan(bytes));
+    BOOST_REQUIRE(value.has_value());
+    BOOST_CHECK_EQUAL(*std::get<dma::Float64>(*value), 2.5);
+    BOOST_CHECK(!serial::decode_value(AvpTypeV::Float32, message::ByteSpan(bytes)).has_value());
+    BOOST_CHECK(!serial::decode_value(AvpTypeV::Address, message::ByteSpan(bytes, 1)).has_value());
+    value = serial::decode_value(AvpTypeV::Integer64, message::ByteSpan(bytes));
+    BOOST_CHECK_EQUAL(*std::get<dma::Integer64>(*value), 0x4004000000000000LL);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,130 @@
+#include <boost/test/unit_test.hpp>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <diameter/serial/error.h>
+#include <diameter/serial/framer.h>
+
+#include "../../helpers/from_hex.h"
+
+using namespace diameter;
+
+namespace {
+
+// Device-Watchdog-Request with Origin-Host and Origin-Realm
+const std::string dwr_hexed = \
+    "01000038800001180000000000000001" \
+    "00000001000001084000000E686F7374" \
+    "2E61000000000128400000136578616D" \
+    "706C652E6F726700";
+
+}
+
+BOOST_AUTO_TEST_SUITE(framer)
+
+BOOST_AUTO_TEST_CASE(whole_messages)
+{
+    std::vector<uint8_t> msg;
+    load_from_hex(dwr_hexed, msg);
+
+    auto stream = msg;
+    stream.insert(stream.end(), msg.begin(), msg.end());
+
+    serial::Framer framer;
+    BOOST_CHECK_EQUAL(framer.feed(stream), stream.size());
+
+    auto frame1 = framer.next();
+    BOOST_REQUIRE(frame1.has_value());
+    BOOST_CHECK_EQUAL_COLLECTIONS(frame1->begin(), frame1->end(), msg.begin(), msg.end());
+
+    auto frame2 = framer.next();
+    BOOST_REQUIRE(frame2.has_value());
+    BOOST_CHECK_EQUAL_COLLECTIONS(frame2->begin(), frame2->end(), msg.begin(), msg.end());
+    // Frames are views into one buffer
+    BOOST_CHECK(frame2->data() == frame1->data() + msg.size());
+
+    BOOST_CHECK_EQUAL(framer.next().has_value(), false);
+    BOOST_CHECK_EQUAL(framer.buffered(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(byte_by_byte)
+{
+    std::vector<uint8_t> msg;
+    load_from_hex(dwr_hexed, msg);
+
+    serial::Framer framer;
+    std::size_t frames = 0;
+    for (int round = 0; round < 3; ++round) {
+        for (std::size_t i = 0; i < msg.size(); ++i) {
+            BOOST_CHECK_EQUAL(framer.feed(message::ByteSpan(&msg[i], 1)), 1);
+            auto frame = framer.next();
+            if (i + 1 < msg.size()) {
+                BOOST_CHECK_EQUAL(frame.has_value(), false);
+            }
+            else {
+                BOOST_REQUIRE(frame.has_value());
+                BOOST_CHECK_EQUAL_COLLECTIONS(frame->begin(), frame->end(), msg.begin(), msg.end());
+                ++frames;
+            }
+        }
+    }
+    BOOST_CHECK_EQUAL(frames, 3);
+}
+
+BOOST_AUTO_TEST_CASE(prepare_commit_and_compaction)
+{
+    std::vector<uint8_t> msg;
+    load_from_hex(dwr_hexed, msg);
+
+    // Room for two messages and a half
+    serial::Framer framer(msg.size(), msg.size() * 5 / 2);
+
+    auto chunk = [&](std::size_t offset, std::size_t size) {
+        auto area = framer.prepare();
+        BOOST_REQUIRE(area.size() >= size);
+        std::memcpy(area.data(), msg.data() + offset, size);
+        framer.commit(size);
+    };
+
+    chunk(0, msg.size());
+    chunk(0, msg.size());
+    chunk(0, 10);
+    BOOST_CHECK(framer.next().has_value());
+    BOOST_CHECK(framer.next().has_value());
+    BOOST_CHECK_EQUAL(framer.next().has_value(), false);
+
+    // The tail is too small for the rest of the message: the partial message is moved
+    auto area = framer.prepare();
+    BOOST_CHECK_EQUAL(area.size(), framer.capacity() - 10);
+    chunk(10, msg.size() - 10);
+
+    auto frame = framer.next();
+    BOOST_REQUIRE(frame.has_value());
+    BOOST_CHECK_EQUAL_COLLECTIONS(frame->begin(), frame->end(), msg.begin(), msg.end());
+}
+
+BOOST_AUTO_TEST_CASE(invalid_header)
+{
+    serial::Framer framer(1024);
+
+    // Rejected as soon as the length is received
+    auto too_small = std::vector<uint8_t> {0x01, 0x00, 0x00, 0x10};
+    framer.feed(too_small);
+    BOOST_CHECK_THROW(framer.next(), serial::InvalidMessageLength);
+
+    framer.reset();
+    auto too_big = std::vector<uint8_t> {0x01, 0x00, 0x04, 0x04};
+    framer.feed(too_big);
+    BOOST_CHECK_THROW(framer.next(), serial::InvalidMessageLength);
+
+    framer.reset();
+    auto version = std::vector<uint8_t> {0x02, 0x00, 0x00, 0x14};
+    framer.feed(version);
+    BOOST_CHECK_THROW(framer.next(), serial::InvalidProtocolVersion);
+
+    BOOST_CHECK_THROW(serial::Framer(10), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
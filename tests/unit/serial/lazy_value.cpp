@@ -0,0 +1,69 @@
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include <diameter/serial/avp/lazy_value.h>
+#include <diameter/serial/error.h>
+
+using namespace diameter;
+
+BOOST_AUTO_TEST_SUITE(lazy_value)
+
+BOOST_AUTO_TEST_CASE(cached_conversion)
+{
+    auto data = std::vector<uint8_t>{
+        0x00, 0x00, 0x01, 0x07,   //Code: Session-Id
+        0x40,                     //Flags
+              0x00, 0x00, 0x0f,   //Length
+        0x61, 0x62, 0x63, 0x3b,   //Data
+        0x31, 0x32, 0x33,
+        0x00                      //Padding
+    };
+
+    auto pos = data.begin();
+    auto avp = netpacker::get<message::avp::AVP>(pos, data.end());
+
+    auto value = serial::avp::LazyValue(std::move(avp.value));
+    BOOST_CHECK_EQUAL(value.is_cached<message::avp::UTF8String>(), false);
+
+    const auto& session_id1 = value.get<message::avp::UTF8String>();
+    BOOST_CHECK_EQUAL(*session_id1, "abc;123");
+    BOOST_CHECK_EQUAL(value.is_cached<message::avp::UTF8String>(), true);
+
+    // Later reads return the cached value
+    const auto& session_id2 = value.get<message::avp::UTF8String>();
+    BOOST_CHECK_EQUAL(&session_id1, &session_id2);
+
+    // The raw alternative is returned without conversion
+    const auto& raw = value.get<message::avp::OctetString>();
+    BOOST_CHECK_EQUAL(raw->size(), 7);
+    BOOST_CHECK_EQUAL(value.is_cached<message::avp::UTF8String>(), true);
+
+    // Another type is cached too, the references to the first one stay valid
+    const auto& identity = value.get<message::avp::DiameterIdentity>();
+    BOOST_CHECK_EQUAL(identity->value(), "abc;123");
+    BOOST_CHECK_EQUAL(value.is_cached<message::avp::UTF8String>(), true);
+    BOOST_CHECK_EQUAL(value.is_cached<message::avp::DiameterIdentity>(), true);
+    BOOST_CHECK_EQUAL(*session_id1, "abc;123");
+    BOOST_CHECK_EQUAL(&value.get<message::avp::UTF8String>(), &session_id1);
+    BOOST_CHECK_EQUAL(&value.get<message::avp::DiameterIdentity>(), &identity);
+}
+
+BOOST_AUTO_TEST_CASE(invalid_cast)
+{
+    auto value = serial::avp::LazyValue(
+        message::avp::OctetString(message::avp::OctetString::value_type {0x00, 0x01}));
+
+    const auto& text = value.get<message::avp::UTF8String>();
+    BOOST_CHECK_THROW(value.get<message::avp::Unsigned32>(), serial::InvalidAvpValueCast);
+    BOOST_CHECK_EQUAL(value.is_cached<message::avp::Unsigned32>(), false);
+    // A failed conversion keeps the cache
+    BOOST_CHECK_EQUAL(value.is_cached<message::avp::UTF8String>(), true);
+    BOOST_CHECK_EQUAL(&value.get<message::avp::UTF8String>(), &text);
+
+    value.reset(message::avp::OctetString(message::avp::OctetString::value_type {0, 0, 0x0b, 0xb9}));
+    BOOST_CHECK_EQUAL(*value.get<message::avp::Unsigned32>(), 3001);
+    BOOST_CHECK_EQUAL(value.is_cached<message::avp::UTF8String>(), false);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
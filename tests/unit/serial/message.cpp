@@ -2,6 +2,7 @@
 
 #include <iostream>
 #include <iomanip>
+#include <memory_resource>
 #include <vector>
 
 #include <netpacker/error.h>
@@ -167,7 +168,7 @@ BOOST_AUTO_TEST_CASE(encode_message)
             header::HopByHopIdentifier{0x6ad1d314},
             header::EndToEndIdentifier{0x77287404}
         },
-        std::list<avp::AVP>{
+        avp::AvpList{
             avp::AVP{264, avp::Flags{avp::Flag::Mandatory}, std::nullopt, avp::DiameterIdentity("testhost.epc.mnc000.mcc000.3gppnetwork.org")},
             avp::AVP{296, avp::Flags{avp::Flag::Mandatory}, std::nullopt, avp::DiameterIdentity("epc.mnc000.mcc000.3gppnetwork.org")},
             avp::AVP{257, avp::Flags{avp::Flag::Mandatory}, std::nullopt, avp::Address("127.0.0.1")},
@@ -201,4 +202,79 @@ BOOST_AUTO_TEST_CASE(encode_message)
     BOOST_CHECK_EQUAL_COLLECTIONS(data.begin(), data.end(), expected_data.begin(), expected_data.end());
 }
 
+BOOST_AUTO_TEST_CASE(encode_nested_grouped)
+{
+    auto mandatory = avp::Flags{avp::Flag::Mandatory};
+    Message m {
+        {
+            header::ProtocolVersion{header::ProtocolVersionV::V01},
+            header::MessageLength{0},
+            header::CommandFlags{0x80},
+            header::CommandCode{272},
+            header::ApplicationId{4},
+            header::HopByHopIdentifier{1},
+            header::EndToEndIdentifier{2}
+        },
+        avp::AvpList{
+            avp::AVP{456, mandatory, std::nullopt, avp::Grouped(avp::AvpList{
+                avp::AVP{437, mandatory, std::nullopt, avp::Grouped(avp::AvpList{
+                    avp::AVP{421, mandatory, std::nullopt, avp::Unsigned64(uint64_t{1000})}
+                })},
+                avp::AVP{263, mandatory, std::nullopt, avp::UTF8String("abc")}
+            })}
+        }
+    };
+
+    std::string hexed = \
+        "01000040800001100000000400000001" \
+        "00000002000001C84000002C000001B5" \
+        "40000018000001A54000001000000000" \
+        "000003E8000001074000000B61626300";
+
+    std::vector<uint8_t> expected_data;
+    load_from_hex(hexed, expected_data);
+
+    // Lengths of the message and of every AVP are written by the encoder itself
+    auto data = std::vector<uint8_t>(expected_data.size());
+    auto pos = netpacker::put(data.begin(), data.end(), m);
+
+    BOOST_CHECK(pos == data.end());
+    BOOST_CHECK_EQUAL(m.header.length, 0);
+    BOOST_CHECK_EQUAL_COLLECTIONS(data.begin(), data.end(), expected_data.begin(), expected_data.end());
+    BOOST_CHECK_EQUAL(m.size(), expected_data.size());
+}
+
+BOOST_AUTO_TEST_CASE(decode_into_arena)
+{
+    std::string hexed = \
+        "01000040800001100000000400000001" \
+        "00000002000001C84000002C000001B5" \
+        "40000018000001A54000001000000000" \
+        "000003E8000001074000000B61626300";
+
+    std::vector<uint8_t> data;
+    load_from_hex(hexed, data);
+
+    alignas(std::max_align_t) uint8_t buffer[1024];
+    std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+
+    // Nothing may be allocated from the default resource
+    auto previous = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+
+    auto pos = data.cbegin();
+    auto msg = netpacker::get<Message>(pos, data.cend(), &arena);
+    auto mscc = diameter::serial::avp::value_as<avp::Grouped>(msg.avps.front().value);
+    auto session_id = diameter::serial::avp::value_as<avp::UTF8String>((*mscc)[1].value);
+
+    auto encoded = std::vector<uint8_t>(data.size());
+    std::pmr::set_default_resource(previous);
+    netpacker::put(encoded.begin(), encoded.end(), msg);
+
+    BOOST_CHECK(msg.avps.get_allocator().resource() == &arena);
+    BOOST_CHECK(mscc->get_allocator().resource() == &arena);
+    BOOST_CHECK(std::get<avp::OctetString>((*mscc)[0].value)->get_allocator().resource() == &arena);
+    BOOST_CHECK_EQUAL(*session_id, "abc");
+    BOOST_CHECK_EQUAL_COLLECTIONS(encoded.begin(), encoded.end(), data.begin(), data.end());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
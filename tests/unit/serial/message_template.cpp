@@ -0,0 +1,151 @@
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+
+#include <netpacker/netpacker.h>
+
+#include <diameter/message/message.h>
+#include <diameter/serial/serial.h>
+
+using namespace diameter;
+
+namespace {
+
+namespace dma = message::avp;
+
+const auto mandatory = dma::Flags{dma::Flag::Mandatory};
+
+// Credit-Control-Answer with a Multiple-Services-Credit-Control granting CC-Time
+message::Message make_cca(const std::string& session_id, uint32_t cc_time)
+{
+    auto granted_service_unit = dma::AvpList{
+        dma::AVP{420, mandatory, std::nullopt, dma::Unsigned32(cc_time)}
+    };
+    auto mscc = dma::AvpList{
+        dma::AVP{431, mandatory, std::nullopt, dma::Grouped(std::move(granted_service_unit))},
+        dma::AVP{448, mandatory, std::nullopt, dma::Unsigned32(uint32_t{3600})}
+    };
+    return message::Message{
+        message::header::Header{
+            message::header::ProtocolVersion{message::header::ProtocolVersionV::V01},
+            message::header::MessageLength{0},
+            message::header::CommandFlags{0x40},
+            message::header::CommandCode{272},
+            message::header::ApplicationId{4},
+            message::header::HopByHopIdentifier{0},
+            message::header::EndToEndIdentifier{0}
+        },
+        dma::AvpList{
+            dma::AVP{263, mandatory, std::nullopt, dma::UTF8String(session_id)},
+            dma::AVP{268, mandatory, std::nullopt, dma::Unsigned32(uint32_t{2001})},
+            dma::AVP{456, mandatory, std::nullopt, dma::Grouped(std::move(mscc))},
+            dma::AVP{264, mandatory, std::nullopt, dma::DiameterIdentity("ocs.example.org")}
+        }
+    };
+}
+
+std::vector<uint8_t> encode(message::Message msg)
+{
+    auto data = std::vector<uint8_t>(msg.size());
+    netpacker::put(data.begin(), data.end(), msg);
+    return data;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(message_template)
+
+BOOST_AUTO_TEST_CASE(instantiate)
+{
+    serial::MessageTemplate cca(make_cca("session;1", 0));
+    auto expected = encode(make_cca("session;1", 0));
+
+    auto instance = cca.instantiate();
+    auto data = instance.data();
+    BOOST_CHECK_EQUAL_COLLECTIONS(data.begin(), data.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(patch_fixed_fields)
+{
+    serial::MessageTemplate cca(make_cca("session;1", 0));
+    auto result_code = cca.field(268);
+    auto cc_time = cca.field(cca.field(cca.field(456), 431), 420);
+
+    serial::TemplateInstance instance;
+    cca.instantiate(instance)
+        .hop_by_hop(0x11223344)
+        .end_to_end(0x55667788)
+        .set(result_code, uint32_t{5030})
+        .set(cc_time, 900);
+
+    auto msg = make_cca("session;1", 900);
+    msg.header.hop_by_hop = 0x11223344;
+    msg.header.end_to_end = 0x55667788;
+    msg.avps[1].value = dma::Unsigned32(uint32_t{5030});
+    auto expected = encode(std::move(msg));
+
+    auto data = instance.data();
+    BOOST_CHECK_EQUAL_COLLECTIONS(data.begin(), data.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(patch_variable_length)
+{
+    serial::MessageTemplate cca(make_cca("session;1", 0));
+    auto session_id = cca.field(263);
+    auto cc_time = cca.field(cca.field(cca.field(456), 431), 420);
+
+    serial::TemplateInstance instance;
+    for (const std::string value : {"s", "session;12", "pgw.example.org;1096298391;1;2", "", "ab"}) {
+        cca.instantiate(instance).set(session_id, value).set(cc_time, uint32_t{7});
+        auto expected = encode(make_cca(value, 7));
+
+        auto data = instance.data();
+        BOOST_CHECK_EQUAL_COLLECTIONS(data.begin(), data.end(), expected.begin(), expected.end());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(patch_nested_variable_length)
+{
+    auto make = [](const std::string& product) {
+        auto msg = make_cca("session;1", 0);
+        std::get<dma::Grouped>(msg.avps[2].value)->push_back(
+            dma::AVP{269, dma::Flags{}, std::nullopt, dma::UTF8String(product)});
+        return msg;
+    };
+
+    serial::MessageTemplate cca(make("x"));
+    auto product = cca.field(cca.field(456), 269);
+    auto origin_host = cca.field(264);
+
+    auto instance = cca.instantiate();
+    instance.set(product, std::string_view("ExampleProduct"))
+        .set(origin_host, std::string_view("ocs2.example.org"));
+
+    auto msg = make("ExampleProduct");
+    msg.avps[3].value = dma::DiameterIdentity("ocs2.example.org");
+    auto expected = encode(std::move(msg));
+
+    auto data = instance.data();
+    BOOST_CHECK_EQUAL_COLLECTIONS(data.begin(), data.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(invalid_fields)
+{
+    serial::MessageTemplate cca(make_cca("session;1", 0));
+    BOOST_CHECK_THROW(cca.field(1), std::invalid_argument);
+    BOOST_CHECK_THROW(cca.field(420), std::invalid_argument);
+    BOOST_CHECK_THROW(cca.field(268, 10415), std::invalid_argument);
+
+    auto instance = cca.instantiate();
+    BOOST_CHECK_THROW(instance.set(cca.field(268), uint64_t{1}), std::invalid_argument);
+    BOOST_CHECK_THROW(instance.set(cca.field(268), int64_t{-1}), std::invalid_argument);
+    BOOST_CHECK_THROW(instance.set(cca.field(456), uint32_t{1}), std::invalid_argument);
+    BOOST_CHECK_THROW(instance.set(cca.field(456), std::string_view("a")), std::invalid_argument);
+
+    serial::TemplateInstance empty;
+    BOOST_CHECK_THROW(empty.hop_by_hop(1), std::invalid_argument);
+    BOOST_CHECK_THROW(empty.end_to_end(1), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
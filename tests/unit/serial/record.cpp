@@ -0,0 +1,199 @@
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+#include <netpacker/netpacker.h>
+
+#include <diameter/dictionaries/dcca.h>
+#include <diameter/dictionary/schema.h>
+#include <diameter/serial/record.h>
+#include <diameter/serial/serial.h>
+
+using namespace diameter;
+
+namespace {
+
+namespace dma = message::avp;
+namespace dcca = dictionaries::dcca;
+
+using serial::DecodeErrorV;
+
+// A CCR with its AVPs in the order of the grammar, an AVP which is not in it last
+dma::AvpList make_avps()
+{
+    return dma::AvpList {
+        dcca::avp::SessionId::make(dma::UTF8String("pgw.example.org;1;2")),
+        dcca::avp::OriginHost::make(dma::DiameterIdentity("pgw.example.org")),
+        dcca::avp::OriginRealm::make(dma::DiameterIdentity("example.org")),
+        dcca::avp::DestinationRealm::make(dma::DiameterIdentity("ocs.example.org")),
+        dcca::avp::AuthApplicationId::make(uint32_t {4}),
+        dcca::avp::ServiceContextId::make(dma::UTF8String("32251@3gpp.org")),
+        dcca::avp::CcRequestType::make(dma::Enumerated(int32_t {
+            dcca::avp::CcRequestTypeV::UPDATE_REQUEST})),
+        dcca::avp::CcRequestNumber::make(uint32_t {7}),
+        dcca::avp::CcSubSessionId::make(uint64_t {0x0102030405060708}),
+        dcca::avp::MultipleServicesCreditControl::make(dma::Grouped(dma::AvpList {
+            dcca::avp::RatingGroup::make(uint32_t {10}),
+        })),
+        dcca::avp::MultipleServicesCreditControl::make(dma::Grouped(dma::AvpList {
+            dcca::avp::RatingGroup::make(uint32_t {20}),
+        })),
+        dma::AVP {873, dma::Flags {uint8_t {0x80}}, uint32_t {10415}, dma::Grouped()},
+    };
+}
+
+std::vector<uint8_t> encode_ccr(dma::AvpList avps)
+{
+    message::Message msg {serial::record::make_header(272, 4, true), std::move(avps)};
+    msg.header.hop_by_hop = 0x11223344;
+    msg.header.end_to_end = 0x55667788;
+    auto data = std::vector<uint8_t>(msg.size());
+    netpacker::put(data.begin(), data.end(), msg);
+    return data;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(record)
+
+BOOST_AUTO_TEST_CASE(decode)
+{
+    auto data = encode_ccr(make_avps());
+    dcca::record::CreditControlRequest ccr;
+    BOOST_REQUIRE(!serial::record::try_decode(data, ccr));
+
+    BOOST_CHECK_EQUAL(ccr.header.hop_by_hop, 0x11223344u);
+    BOOST_CHECK_EQUAL(ccr.header.command_code, 272u);
+    BOOST_CHECK_EQUAL(ccr.session_id, "pgw.example.org;1;2");
+    BOOST_CHECK_EQUAL(ccr.origin_host, "pgw.example.org");
+    BOOST_CHECK_EQUAL(ccr.auth_application_id, 4u);
+    BOOST_CHECK_EQUAL(ccr.cc_request_type, dcca::avp::CcRequestTypeV::UPDATE_REQUEST);
+    BOOST_CHECK_EQUAL(ccr.cc_request_number, 7u);
+    BOOST_REQUIRE(ccr.cc_sub_session_id.has_value());
+    BOOST_CHECK_EQUAL(*ccr.cc_sub_session_id, 0x0102030405060708u);
+    BOOST_CHECK(!ccr.destination_host.has_value());
+    BOOST_REQUIRE_EQUAL(ccr.multiple_services_credit_control.size(), 2u);
+    auto rating_group = ccr.multiple_services_credit_control[1].find(432);
+    BOOST_REQUIRE(rating_group.has_value());
+    BOOST_CHECK_EQUAL(serial::detail::load_u32(rating_group->data().data()), 20u);
+    BOOST_REQUIRE_EQUAL(ccr.avps.size(), 1u);
+    BOOST_CHECK_EQUAL(ccr.avps[0].code(), 873u);
+
+    // The values point into the buffer
+    BOOST_CHECK(reinterpret_cast<const uint8_t*>(ccr.session_id.data()) > data.data());
+    BOOST_CHECK(reinterpret_cast<const uint8_t*>(ccr.session_id.data()) < data.data() + 40);
+
+    // In the order of the grammar the message is encoded as it was
+    BOOST_CHECK_EQUAL(serial::record::size(ccr), data.size());
+    std::vector<uint8_t> encoded;
+    serial::record::encode(ccr, encoded);
+    BOOST_CHECK(encoded == data);
+
+    // A reused record keeps the capacity of its vectors
+    auto* storage = ccr.multiple_services_credit_control.data();
+    auto avps = make_avps();
+    avps.erase(avps.begin() + 10);
+    data = encode_ccr(std::move(avps));
+    BOOST_REQUIRE(!serial::record::try_decode(data, ccr));
+    BOOST_CHECK_EQUAL(ccr.multiple_services_credit_control.size(), 1u);
+    BOOST_CHECK(ccr.multiple_services_credit_control.data() == storage);
+}
+
+BOOST_AUTO_TEST_CASE(encode)
+{
+    dcca::record::CreditControlAnswer cca;
+    cca.header.hop_by_hop = 1;
+    cca.header.end_to_end = 2;
+    cca.session_id = "pgw.example.org;1;2";
+    cca.result_code = 2001;
+    cca.origin_host = "ocs.example.org";
+    cca.origin_realm = "example.org";
+    cca.auth_application_id = 4;
+    cca.cc_request_type = dcca::avp::CcRequestTypeV::INITIAL_REQUEST;
+    cca.cc_request_number = 0;
+    cca.validity_time = 600;
+
+    std::vector<uint8_t> data;
+    serial::record::encode(cca, data);
+    BOOST_CHECK_EQUAL(data.size(), serial::record::size(cca));
+    BOOST_CHECK_EQUAL(data.size() % 4, 0u);
+
+    auto msg = serial::decode(data, dcca::Dictionary {});
+    BOOST_CHECK_EQUAL(msg.header.command_code, 272u);
+    BOOST_CHECK(!msg.header.command_flags[message::header::CommandFlag::Request]);
+    BOOST_CHECK(msg.header.command_flags[message::header::CommandFlag::Proxiable]);
+    BOOST_CHECK_EQUAL(msg.header.length, data.size());
+    BOOST_CHECK(!dictionary::validate(msg, dcca::schema::CreditControlAnswer,
+        dcca::Dictionary {}));
+    auto session_id = serial::avp::get<dcca::avp::SessionId>(msg.avps);
+    BOOST_REQUIRE(session_id.has_value());
+    BOOST_CHECK(**session_id == "pgw.example.org;1;2");
+    auto validity_time = serial::avp::get<dcca::avp::ValidityTime>(msg.avps);
+    BOOST_REQUIRE(validity_time.has_value());
+    BOOST_CHECK_EQUAL(**validity_time, 600u);
+
+    auto decoded = serial::record::decode<dcca::record::CreditControlAnswer>(data);
+    BOOST_CHECK_EQUAL(decoded.result_code, 2001u);
+    BOOST_CHECK_EQUAL(decoded.origin_host, "ocs.example.org");
+    BOOST_CHECK(!decoded.cost_information.has_value());
+}
+
+BOOST_AUTO_TEST_CASE(errors)
+{
+    dcca::record::CreditControlRequest ccr;
+
+    auto avps = make_avps();
+    avps.erase(avps.begin() + 7);
+    auto data = encode_ccr(avps);
+    auto error = serial::record::try_decode(data, ccr);
+    BOOST_CHECK_EQUAL(error.code, DecodeErrorV::MissingAvp);
+    BOOST_CHECK_EQUAL(error.avp_code, 415u);
+    BOOST_CHECK_EQUAL(error.offset, data.size());
+    BOOST_CHECK_EQUAL(error.result_code(), application::base::ResultCodeV::MissingAvp);
+    BOOST_CHECK_THROW(serial::record::decode<dcca::record::CreditControlRequest>(data),
+        serial::InvalidAvpOccurrence);
+
+    avps = make_avps();
+    std::swap(avps[0], avps[1]);
+    data = encode_ccr(avps);
+    error = serial::record::try_decode(data, ccr);
+    BOOST_CHECK_EQUAL(error.code, DecodeErrorV::MissingAvp);
+    BOOST_CHECK_EQUAL(error.avp_code, 263u);
+    BOOST_CHECK_EQUAL(error.offset, 20u);
+
+    avps = make_avps();
+    avps.push_back(dcca::avp::CcRequestNumber::make(uint32_t {8}));
+    data = encode_ccr(avps);
+    error = serial::record::try_decode(data, ccr);
+    BOOST_CHECK_EQUAL(error.code, DecodeErrorV::AvpOccursTooManyTimes);
+    BOOST_CHECK_EQUAL(error.avp_code, 415u);
+    BOOST_CHECK_EQUAL(error.result_code(),
+        application::base::ResultCodeV::AvpOccursTooManyTimes);
+
+    // An Unsigned32 of 3 octets
+    avps = make_avps();
+    avps[4] = dma::AVP {258, dma::Flags {uint8_t {0x40}}, std::nullopt,
+        dma::OctetString(dma::OctetString::value_type {0, 0, 4})};
+    data = encode_ccr(avps);
+    error = serial::record::try_decode(data, ccr);
+    BOOST_CHECK_EQUAL(error.code, DecodeErrorV::InvalidAvpLength);
+    BOOST_CHECK_EQUAL(error.avp_code, 258u);
+
+    // A Grouped value which is not a list of AVPs
+    avps = make_avps();
+    avps[9] = dma::AVP {456, dma::Flags {uint8_t {0x40}}, std::nullopt,
+        dma::OctetString(dma::OctetString::value_type {1, 2, 3, 4, 5})};
+    data = encode_ccr(avps);
+    error = serial::record::try_decode(data, ccr);
+    BOOST_CHECK_EQUAL(error.code, DecodeErrorV::InvalidAvpLength);
+    BOOST_CHECK_EQUAL(error.avp_code, 456u);
+
+    data.resize(10);
+    error = serial::record::try_decode(data, ccr);
+    BOOST_CHECK_EQUAL(error.code, DecodeErrorV::Truncated);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
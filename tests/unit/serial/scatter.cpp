@@ -0,0 +1,175 @@
+#include <boost/test/unit_test.hpp>
+
+#include <stdexcept>
+#include <vector>
+
+#include <netpacker/netpacker.h>
+
+#include <diameter/message/message.h>
+#include <diameter/serial/serial.h>
+
+using namespace diameter;
+
+namespace {
+
+namespace dma = message::avp;
+
+const auto mandatory = dma::Flags{dma::Flag::Mandatory};
+const auto vendor_mandatory = dma::Flags{dma::Flag::Mandatory} | dma::Flags{dma::Flag::VendorSpecific};
+
+message::Message make_message()
+{
+    auto payload = dma::OctetString::value_type(1001, 0xab);
+    auto container = dma::AvpList{
+        dma::AVP{1, vendor_mandatory, 10415, dma::OctetString(std::move(payload))},
+        dma::AVP{2, vendor_mandatory, 10415, dma::Unsigned32(uint32_t{7})}
+    };
+    return message::Message{
+        message::header::Header{
+            message::header::ProtocolVersion{message::header::ProtocolVersionV::V01},
+            message::header::MessageLength{0},
+            message::header::CommandFlags{0x80},
+            message::header::CommandCode{272},
+            message::header::ApplicationId{4},
+            message::header::HopByHopIdentifier{1},
+            message::header::EndToEndIdentifier{2}
+        },
+        dma::AvpList{
+            dma::AVP{263, mandatory, std::nullopt, dma::UTF8String("host.example.org;1;2")},
+            dma::AVP{702, vendor_mandatory, 10415, dma::OctetString(dma::OctetString::value_type(600, 0x11))},
+            dma::AVP{873, vendor_mandatory, 10415, dma::Grouped(std::move(container))},
+            dma::AVP{268, mandatory, std::nullopt, dma::Unsigned32(uint32_t{2001})}
+        }
+    };
+}
+
+std::vector<uint8_t> gather(const std::vector<iovec>& iovecs)
+{
+    std::vector<uint8_t> data;
+    for (const auto& iov : iovecs) {
+        const auto* base = static_cast<const uint8_t*>(iov.iov_base);
+        data.insert(data.end(), base, base + iov.iov_len);
+    }
+    return data;
+}
+
+std::vector<uint8_t> encode(message::Message& msg)
+{
+    auto data = std::vector<uint8_t>(msg.size());
+    netpacker::put(data.begin(), data.end(), msg);
+    return data;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(scatter)
+
+BOOST_AUTO_TEST_CASE(matches_contiguous_encoding)
+{
+    auto msg = make_message();
+
+    serial::ScatterEncoder encoder;
+    const auto& iovecs = encoder.encode(msg);
+
+    BOOST_CHECK_EQUAL(encoder.size(), msg.size());
+    auto expected = encode(msg);
+    auto actual = gather(iovecs);
+    BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(large_payloads_in_place)
+{
+    auto msg = make_message();
+    const auto& large = *std::get<dma::OctetString>(msg.avps[1].value);
+    const auto& grouped = *std::get<dma::Grouped>(msg.avps[2].value);
+    const auto& nested = *std::get<dma::OctetString>(grouped[0].value);
+
+    serial::ScatterEncoder encoder;
+    const auto& iovecs = encoder.encode(msg);
+
+    // scratch, payload, scratch, nested payload, scratch
+    BOOST_REQUIRE_EQUAL(iovecs.size(), 5);
+    BOOST_CHECK(iovecs[1].iov_base == large.data());
+    BOOST_CHECK_EQUAL(iovecs[1].iov_len, 600);
+    BOOST_CHECK(iovecs[3].iov_base == nested.data());
+    BOOST_CHECK_EQUAL(iovecs[3].iov_len, 1001);
+    BOOST_CHECK_EQUAL(encoder.copied(), msg.size() - 1601);
+}
+
+BOOST_AUTO_TEST_CASE(threshold)
+{
+    auto msg = make_message();
+
+    // Everything copied
+    serial::ScatterEncoder copying(1 << 20);
+    const auto& one = copying.encode(msg);
+    BOOST_CHECK_EQUAL(one.size(), 1);
+    BOOST_CHECK_EQUAL(copying.copied(), msg.size());
+
+    // The short Session-Id is referenced as well
+    serial::ScatterEncoder referencing(16);
+    const auto& iovecs = referencing.encode(msg);
+    BOOST_CHECK_EQUAL(iovecs.size(), 7);
+    auto expected = encode(msg);
+    auto actual = gather(iovecs);
+    BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(max_iovecs)
+{
+    auto msg = make_message();
+    auto expected = encode(msg);
+
+    // Room for the first payload only, the other ones are copied
+    serial::ScatterEncoder encoder(16, 4);
+    const auto& iovecs = encoder.encode(msg);
+    BOOST_CHECK_EQUAL(iovecs.size(), 3);
+    BOOST_CHECK_EQUAL(encoder.copied(), msg.size() - 20);
+    auto actual = gather(iovecs);
+    BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
+
+    serial::ScatterEncoder single(16, 1);
+    BOOST_CHECK_EQUAL(single.encode(msg).size(), 1);
+    BOOST_CHECK_EQUAL(serial::ScatterEncoder().max_iovecs(),
+        serial::ScatterEncoder::default_max_iovecs);
+    BOOST_CHECK_THROW(serial::ScatterEncoder(16, 0), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(length_limits)
+{
+    // The payloads are referenced, nothing is copied
+    auto payload = dma::OctetString::value_type(0xFFFFFF - 8 + 1);
+    auto msg = make_message();
+    msg.avps[1] = dma::AVP{702, mandatory, std::nullopt, dma::OctetString(std::move(payload))};
+    serial::ScatterEncoder encoder;
+    BOOST_CHECK_THROW(encoder.encode(msg), serial::InvalidAvpLength);
+
+    // Two AVPs which fit, a message which does not
+    payload = dma::OctetString::value_type(0x800000);
+    msg.avps[1] = dma::AVP{702, mandatory, std::nullopt, dma::OctetString(payload)};
+    msg.avps[2] = dma::AVP{702, mandatory, std::nullopt, dma::OctetString(std::move(payload))};
+    BOOST_CHECK_THROW(encoder.encode(msg), serial::InvalidMessageLength);
+}
+
+BOOST_AUTO_TEST_CASE(reuse)
+{
+    auto msg = make_message();
+    serial::ScatterEncoder encoder;
+    encoder.encode(msg);
+
+    msg.avps.pop_back();
+    auto actual = gather(encoder.encode(msg));
+    auto expected = encode(msg);
+    BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(missing_vendor_id)
+{
+    auto msg = make_message();
+    msg.avps[1].vendor_id = std::nullopt;
+
+    serial::ScatterEncoder encoder;
+    BOOST_CHECK_THROW(encoder.encode(msg), serial::InvalidAvpVendorId);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,145 @@
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+
+#include <netpacker/error.h>
+
+#include <diameter/serial/serial.h>
+
+#include "../../helpers/from_hex.h"
+
+using namespace diameter;
+
+namespace {
+
+const std::string cer_hexed = \
+    "010000C080000101000000006AD1D314" \
+    "77287404000001084000003274657374" \
+    "686F73742E6570632E6D6E633030302E" \
+    "6D63633030302E336770706E6574776F" \
+    "726B2E6F726700000000012840000029" \
+    "6570632E6D6E633030302E6D63633030" \
+    "302E336770706E6574776F726B2E6F72" \
+    "67000000000001014000000E00017F00" \
+    "000100000000010A4000000C000028AF" \
+    "0000010D000000164578616D706C6550" \
+    "726F647563740000000001024000000C" \
+    "00000004000001094000000C000028AF";
+
+}
+
+BOOST_AUTO_TEST_SUITE(view)
+
+BOOST_AUTO_TEST_CASE(message_view)
+{
+    std::vector<uint8_t> data;
+    load_from_hex(cer_hexed, data);
+
+    auto msg = serial::view::MessageView(data);
+
+    BOOST_CHECK_EQUAL(msg.length(), 192);
+    BOOST_CHECK_EQUAL(msg.data().size(), 192);
+    BOOST_CHECK_EQUAL(msg.header().version, message::header::ProtocolVersionV::V01);
+    BOOST_CHECK_EQUAL(msg.header().command_flags[message::header::CommandFlag::Request], true);
+    BOOST_CHECK_EQUAL(msg.header().command_code, 257);
+    BOOST_CHECK_EQUAL(msg.header().application_id, 0);
+    BOOST_CHECK_EQUAL(msg.header().hop_by_hop, 0x6ad1d314);
+    BOOST_CHECK_EQUAL(msg.header().end_to_end, 0x77287404);
+    BOOST_CHECK_EQUAL(msg.avps().count(), 7);
+
+    auto origin_host = msg.find(264);
+    BOOST_REQUIRE(origin_host.has_value());
+    BOOST_CHECK_EQUAL(origin_host->flags()[message::avp::Flag::Mandatory], true);
+    BOOST_CHECK_EQUAL(origin_host->vendor_id().has_value(), false);
+    BOOST_CHECK_EQUAL(origin_host->length(), 50);
+    BOOST_CHECK_EQUAL(origin_host->size(), 52);
+
+    // The payload points into the receive buffer
+    auto payload = origin_host->data();
+    BOOST_CHECK(payload.data() == data.data() + 20 + 8);
+    BOOST_CHECK_EQUAL(std::string(payload.begin(), payload.end()),
+        "testhost.epc.mnc000.mcc000.3gppnetwork.org");
+
+    BOOST_CHECK_EQUAL(msg.find(263).has_value(), false);
+}
+
+BOOST_AUTO_TEST_CASE(to_message)
+{
+    std::vector<uint8_t> data;
+    load_from_hex(cer_hexed, data);
+
+    auto msg = serial::view::MessageView(data).to_message();
+
+    auto pos = data.cbegin();
+    auto expected = netpacker::get<message::Message>(pos, data.cend());
+
+    BOOST_CHECK_EQUAL(msg.avps.size(), expected.avps.size());
+
+    auto data2 = std::vector<uint8_t>(msg.size());
+    netpacker::put(data2.begin(), data2.end(), msg);
+
+    BOOST_CHECK_EQUAL_COLLECTIONS(data2.begin(), data2.end(), data.begin(), data.end());
+}
+
+BOOST_AUTO_TEST_CASE(vendor_specific_and_grouped)
+{
+    auto data = std::vector<uint8_t>{
+        0x00, 0x00, 0x01, 0x04,   //Code: Vendor-Specific-Application-Id
+        0x40,                     //Flags
+              0x00, 0x00, 0x24,   //Length
+        // Vendor-Id
+        0x00, 0x00, 0x01, 0x0a,   //Code
+        0x40,                     //Flags
+              0x00, 0x00, 0x0c,   //Length
+        0x00, 0x00, 0x28, 0xaf,   //Data
+        // Auth-Application-Id, vendor specific
+        0x00, 0x00, 0x01, 0x02,   //Code
+        0xc0,                     //Flags
+              0x00, 0x00, 0x0f,   //Length
+        0x00, 0x00, 0x28, 0xaf,   //VendorID
+        0x01, 0x00, 0x00,         //Data
+        0x00                      //Padding
+    };
+
+    auto avps = serial::view::AvpRange(data);
+    BOOST_CHECK_EQUAL(avps.count(), 1);
+
+    auto group = avps.begin()->grouped();
+    BOOST_CHECK_EQUAL(group.count(), 2);
+
+    auto vendor_id = group.find(266);
+    BOOST_REQUIRE(vendor_id.has_value());
+    BOOST_CHECK_EQUAL(vendor_id->data().size(), 4);
+
+    BOOST_CHECK_EQUAL(group.find(258).has_value(), false);
+    auto auth = group.find(258, 10415);
+    BOOST_REQUIRE(auth.has_value());
+    BOOST_CHECK_EQUAL(auth->vendor_id().value(), 10415);
+    BOOST_CHECK_EQUAL(auth->data().size(), 3);
+    BOOST_CHECK_EQUAL(auth->raw().size(), 16);
+}
+
+BOOST_AUTO_TEST_CASE(invalid)
+{
+    std::vector<uint8_t> data;
+    load_from_hex(cer_hexed, data);
+
+    auto truncated = message::ByteSpan(data).first(data.size() - 1);
+    BOOST_CHECK_THROW(serial::view::MessageView{truncated}, netpacker::EndOfBuffer);
+
+    auto bad_version = data;
+    bad_version[0] = 0x02;
+    BOOST_CHECK_THROW(serial::view::MessageView{bad_version}, serial::InvalidProtocolVersion);
+
+    auto bad_length = data;
+    bad_length[3] = 0x10;
+    BOOST_CHECK_THROW(serial::view::MessageView{bad_length}, serial::InvalidMessageLength);
+
+    // Origin-Host length points beyond the message
+    auto bad_avp = data;
+    bad_avp[27] = 0xff;
+    BOOST_CHECK_THROW(serial::view::MessageView{bad_avp}, serial::InvalidAvpLength);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,506 @@
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include <diameter/dictionary/schema.h>
+#include <diameter/dictionary/xml.h>
+#include <diameter/message/avp/avp_def.h>
+
+// Generates a C++ header from XML dictionaries (see dictionary/xml.h):
+//
+//     diameter_dictgen --namespace diameter::dictionaries::dcca --output dcca.h base.xml dcca.xml
+//
+// The header has the AvpDef of every AVP, the values of the Enumerated AVPs, the command codes,
+// constexpr tables of the AVPs and commands, a Dictionary whose lookups are switches and the
+// CommandSchema of the request and the answer of every command (dictionary/schema.h), so the
+// dictionary is compiled in: nothing is parsed at startup and the decoding of serial/dictionary.h
+// inlines the lookup. A struct per request and answer, with a member per rule of the grammar, is
+// decoded from and encoded to the wire by serial/record.h. The CMake function
+// diameter_generate_dictionary() runs it at build time.
+
+namespace {
+
+using diameter::dictionary::AvpDefinition;
+using diameter::dictionary::AvpRule;
+using diameter::dictionary::AvpTypeV;
+using diameter::dictionary::CommandDefinition;
+using diameter::dictionary::Dictionary;
+using diameter::dictionary::Schema;
+
+constexpr std::string_view type_names[] = {
+    "OctetString", "Integer32", "Integer64", "Unsigned32", "Unsigned64", "Float32", "Float64",
+    "Address", "Time", "UTF8String", "DiameterIdentity", "DiameterURI", "Enumerated",
+    "IPFilterRule", "Grouped",
+};
+
+// "CC-Request-Type" -> "CcRequestType", the naming of application/base/avp.h
+std::string type_name(std::string_view name)
+{
+    std::string result;
+    auto word_start = true;
+    for (auto c : name) {
+        auto u = static_cast<unsigned char>(c);
+        if (!std::isalnum(u)) {
+            word_start = true;
+            continue;
+        }
+        result += static_cast<char>(word_start ? std::toupper(u) : std::tolower(u));
+        word_start = false;
+    }
+    if (result.empty() || std::isdigit(static_cast<unsigned char>(result[0]))) {
+        result.insert(0, "Avp");
+    }
+    return result;
+}
+
+// "END_USER_E164" stays as is, other characters become '_'
+std::string value_name(std::string_view name)
+{
+    std::string result;
+    for (auto c : name) {
+        result += std::isalnum(static_cast<unsigned char>(c)) ? c : '_';
+    }
+    if (result.empty() || std::isdigit(static_cast<unsigned char>(result[0]))) {
+        result.insert(0, "V");
+    }
+    return result;
+}
+
+// "CC-Request-Type" -> "cc_request_type", a C++ keyword or a name of the record gets a '_'
+std::string member_name(std::string_view name)
+{
+    static const std::set<std::string> reserved = {
+        "and", "auto", "bool", "break", "case", "catch", "char", "class", "const", "continue",
+        "default", "delete", "do", "double", "else", "enum", "explicit", "export", "extern",
+        "false", "float", "for", "friend", "goto", "if", "inline", "int", "long", "mutable",
+        "namespace", "new", "not", "operator", "or", "private", "protected", "public", "register",
+        "return", "short", "signed", "sizeof", "static", "struct", "switch", "template", "this",
+        "throw", "true", "try", "typedef", "typename", "union", "unsigned", "using", "virtual",
+        "void", "volatile", "while", "xor",
+        "avps", "decode", "header", "schema", "visit",
+    };
+    std::string result;
+    for (auto c : name) {
+        auto u = static_cast<unsigned char>(c);
+        if (!std::isalnum(u)) {
+            if (!result.empty() && result.back() != '_') {
+                result += '_';
+            }
+            continue;
+        }
+        result += static_cast<char>(std::tolower(u));
+    }
+    if (result.empty() || std::isdigit(static_cast<unsigned char>(result[0]))) {
+        result.insert(0, "avp_");
+    }
+    if (reserved.count(result) != 0) {
+        result += '_';
+    }
+    return result;
+}
+
+std::string hex(uint8_t value)
+{
+    static constexpr char digits[] = "0123456789ABCDEF";
+    return std::string("0x") + digits[value >> 4] + digits[value & 0x0F];
+}
+
+std::string quoted(std::string_view text)
+{
+    std::string result = "\"";
+    for (auto c : text) {
+        if (c == '"' || c == '\\') {
+            result += '\\';
+        }
+        result += c;
+    }
+    return result + '"';
+}
+
+// "diameter::dictionaries::dcca" -> DIAMETER_DICTIONARIES_DCCA_H
+std::string guard(const std::string& name_space)
+{
+    std::string result;
+    for (auto c : name_space) {
+        auto u = static_cast<unsigned char>(c);
+        if (std::isalnum(u)) {
+            result += static_cast<char>(std::toupper(u));
+        }
+        else if (!result.empty() && result.back() != '_') {
+            result += '_';
+        }
+    }
+    return result + "_H";
+}
+
+void write_avps(std::ostream& out, const std::vector<AvpDefinition>& avps)
+{
+    out << "namespace avp {\n\n";
+    std::set<std::string> names;
+    for (const auto& avp : avps) {
+        auto name = type_name(avp.name);
+        if (!names.insert(name).second) {
+            continue;
+        }
+        auto flag_bits = static_cast<uint8_t>(
+            avp.flag_bits & ~diameter::message::avp::FlagBits::VendorSpecific);
+        out << "using " << name << " = diameter::message::avp::AvpDef<" << avp.code << ", "
+            << avp.vendor_id << ", diameter::message::avp::" << type_names[avp.type] << ", "
+            << hex(flag_bits) << ">;\n";
+    }
+    for (const auto& avp : avps) {
+        if (avp.values.empty() || names.count(type_name(avp.name) + "V") != 0) {
+            continue;
+        }
+        names.insert(type_name(avp.name) + "V");
+        out << "\nstruct " << type_name(avp.name) << "V\n{\n    enum Value : int32_t\n    {\n";
+        std::set<std::string> values;
+        for (const auto& value : avp.values) {
+            auto name = value_name(value.name);
+            if (values.insert(name).second) {
+                out << "        " << name << " = " << value.code << ",\n";
+            }
+        }
+        out << "    };\n};\n";
+    }
+    out << "\n} // namespace avp\n\n";
+}
+
+void write_commands(std::ostream& out, const std::vector<CommandDefinition>& commands)
+{
+    out << "struct CommandV\n{\n    enum Value : diameter::message::header::CommandCode\n    {\n";
+    std::set<std::string> names;
+    for (const auto& command : commands) {
+        auto name = type_name(command.name);
+        if (names.insert(name).second) {
+            out << "        " << name << " = " << command.code << ",\n";
+        }
+    }
+    out << "    };\n};\n\n";
+}
+
+void write_tables(std::ostream& out, const std::vector<AvpDefinition>& avps,
+    const std::vector<CommandDefinition>& commands)
+{
+    out << "// Sorted by vendor id and code\n"
+        << "inline constexpr diameter::dictionary::AvpEntry avps[] = {\n";
+    for (const auto& avp : avps) {
+        out << "    {" << quoted(avp.name) << ", " << avp.code << ", " << avp.vendor_id
+            << ", diameter::dictionary::AvpTypeV::" << type_names[avp.type] << ", "
+            << hex(avp.flag_bits) << "},\n";
+    }
+    out << "};\n\n// Sorted by code and application id\n"
+        << "inline constexpr diameter::dictionary::CommandEntry commands[] = {\n";
+    for (const auto& command : commands) {
+        out << "    {" << quoted(command.name) << ", " << command.code << ", "
+            << command.application_id << "},\n";
+    }
+    out << "};\n\n";
+}
+
+// switch (first) { case a: switch (second) { case b: return &table[i]; } break; }
+template<typename Entry, typename First, typename Second>
+void write_switch(std::ostream& out, const std::vector<Entry>& entries,
+    const std::string& first_name, First first, const std::string& second_name, Second second,
+    const std::string& table)
+{
+    std::vector<std::size_t> order(entries.size());
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t lhs, std::size_t rhs) {
+        return first(entries[lhs]) < first(entries[rhs]);
+    });
+    out << "        switch (" << first_name << ") {\n";
+    for (std::size_t i = 0; i < order.size();) {
+        auto key = first(entries[order[i]]);
+        out << "            case " << key << ":\n"
+            << "                switch (" << second_name << ") {\n";
+        for (; i < order.size() && first(entries[order[i]]) == key; ++i) {
+            out << "                    case " << second(entries[order[i]]) << ": return &"
+                << table << "[" << order[i] << "];\n";
+        }
+        out << "                }\n                break;\n";
+    }
+    out << "        }\n";
+}
+
+void write_dictionary(std::ostream& out, const std::vector<AvpDefinition>& avps,
+    const std::vector<CommandDefinition>& commands)
+{
+    out << "/*\n"
+        << " * The generated dictionary, for the decoding of serial/dictionary.h: the lookups are\n"
+        << " * switches the compiler turns into jump tables or binary searches.\n"
+        << " */\n"
+        << "struct Dictionary\n{\n"
+        << "    static constexpr const diameter::dictionary::AvpEntry* find(\n"
+        << "        diameter::message::avp::Code code,\n"
+        << "        diameter::message::avp::VendorId vendor_id = 0) noexcept\n    {\n";
+    write_switch(out, avps, "vendor_id",
+        [](const AvpDefinition& avp) { return avp.vendor_id; }, "code",
+        [](const AvpDefinition& avp) { return avp.code; }, "avps");
+    out << "        return nullptr;\n    }\n\n"
+        << "    // The command of the application, or of the base protocol (application 0)\n"
+        << "    static constexpr const diameter::dictionary::CommandEntry* find_command(\n"
+        << "        diameter::message::header::CommandCode code,\n"
+        << "        diameter::message::header::ApplicationId application_id = 0) noexcept\n    {\n";
+    write_switch(out, commands, "application_id",
+        [](const CommandDefinition& command) { return command.application_id; }, "code",
+        [](const CommandDefinition& command) { return command.code; }, "commands");
+    out << "        return application_id != 0 ? find_command(code, 0) : nullptr;\n    }\n};\n\n";
+}
+
+constexpr std::string_view section_names[] = {"Fixed", "Required", "Optional"};
+
+void write_schema(std::ostream& out, const std::string& name, const Schema& schema)
+{
+    auto view = schema.view();
+    out << "\n";
+    if (view.size != 0) {
+        out << "inline constexpr diameter::dictionary::SchemaRule " << name << "Rules[] = {\n";
+        for (std::size_t i = 0; i < view.size; ++i) {
+            const auto& rule = view.rules[i];
+            out << "    {" << rule.code << ", " << rule.vendor_id
+                << ", diameter::dictionary::RuleSectionV::" << section_names[rule.section] << ", "
+                << rule.min << ", ";
+            if (rule.max == AvpRule::unbounded) {
+                out << "diameter::dictionary::AvpRule::unbounded";
+            }
+            else {
+                out << rule.max;
+            }
+            out << "},\n";
+        }
+        out << "};\n\ninline constexpr uint8_t " << name << "Index[] = {";
+        for (std::size_t i = 0; i < view.size; ++i) {
+            out << (i == 0 ? "" : ", ") << static_cast<unsigned>(view.index[i]);
+        }
+        out << "};\n\n";
+    }
+    out << "inline constexpr diameter::dictionary::CommandSchema " << name << " {\n    ";
+    if (view.size != 0) {
+        out << name << "Rules, " << name << "Index, ";
+    }
+    else {
+        out << "nullptr, nullptr, ";
+    }
+    out << static_cast<unsigned>(view.size) << ", " << static_cast<unsigned>(view.fixed) << ", "
+        << (view.any_avp ? "true" : "false") << "};\n";
+}
+
+// The grammars of the requests and the answers, e.g. schema::CreditControlRequest
+void write_schemas(std::ostream& out, const std::vector<CommandDefinition>& commands)
+{
+    out << "namespace schema {\n";
+    std::set<std::string> names;
+    for (const auto& command : commands) {
+        auto name = type_name(command.name);
+        if (!names.insert(name).second) {
+            continue;
+        }
+        write_schema(out, name + "Request", Schema(command.request));
+        write_schema(out, name + "Answer", Schema(command.answer));
+    }
+    out << "\n} // namespace schema\n\n";
+}
+
+// The types of the members of the records, see serial/record.h
+constexpr std::string_view member_types[] = {
+    "diameter::message::ByteSpan", "int32_t", "int64_t", "uint32_t", "uint64_t", "float",
+    "double", "diameter::message::ByteSpan", "uint32_t", "std::string_view", "std::string_view",
+    "std::string_view", "int32_t", "std::string_view", "diameter::serial::view::AvpRange",
+};
+
+void write_record(std::ostream& out, const Dictionary& dictionary, const std::string& name,
+    const std::string& schema_name, const CommandDefinition& command, bool request)
+{
+    auto schema = Schema(request ? command.request : command.answer);
+    auto view = schema.view();
+    struct Member
+    {
+        std::size_t index;
+        std::string name;
+        const AvpDefinition* definition;
+    };
+    std::vector<Member> members;
+    std::set<std::string> names;
+    for (std::size_t i = 0; i < view.size; ++i) {
+        const auto& rule = view.rules[i];
+        const auto* definition = dictionary.find(rule.code, rule.vendor_id);
+        if (rule.max == 0 || definition == nullptr) {
+            continue;
+        }
+        auto member = member_name(definition->name);
+        while (!names.insert(member).second) {
+            member += '_';
+        }
+        members.push_back(Member {i, member, definition});
+    }
+
+    out << "\n// " << command.name << (request ? "-Request" : "-Answer")
+        << ", the members in the order of the rules of the schema\n"
+        << "struct " << name << "\n{\n"
+        << "    static constexpr const diameter::dictionary::CommandSchema& schema =\n        "
+        << schema_name << ";\n\n"
+        << "    diameter::message::header::Header header {\n"
+        << "        diameter::serial::record::make_header(" << command.code << ", "
+        << command.application_id << ", " << (request ? "true" : "false") << ")};\n";
+    for (const auto& member : members) {
+        const auto& rule = view.rules[member.index];
+        std::string type(member_types[member.definition->type]);
+        if (rule.max != 1) {
+            type = "std::vector<" + type + ">";
+        }
+        else if (rule.min == 0) {
+            type = "std::optional<" + type + ">";
+        }
+        out << "    " << type << " " << member.name << " {};\n";
+    }
+    out << "    // The AVPs which are not in the grammar\n"
+        << "    std::vector<diameter::serial::view::AvpView> avps;\n\n";
+
+    if (members.empty()) {
+        out << "    bool decode(std::size_t, const diameter::serial::view::AvpView&)\n    {\n"
+            << "        return false;\n    }\n\n"
+            << "    template<typename Self, typename Visitor>\n"
+            << "    static void visit(Self&, Visitor&&)\n    {\n    }\n};\n";
+        return;
+    }
+    out << "    bool decode(std::size_t index, const diameter::serial::view::AvpView& avp)\n"
+        << "    {\n        switch (index) {\n";
+    for (const auto& member : members) {
+        out << "            case " << member.index << ": return diameter::serial::record::get(avp, "
+            << member.name << ");\n";
+    }
+    out << "        }\n        return false;\n    }\n\n"
+        << "    template<typename Self, typename Visitor>\n"
+        << "    static void visit(Self& self, Visitor&& visitor)\n    {\n";
+    for (const auto& member : members) {
+        const auto& rule = view.rules[member.index];
+        out << "        visitor(" << rule.code << ", " << rule.vendor_id << ", "
+            << hex(member.definition->flag_bits) << ", self." << member.name << ");\n";
+    }
+    out << "    }\n};\n";
+}
+
+// Structs of the requests and the answers, e.g. record::CreditControlRequest
+void write_records(std::ostream& out, const Dictionary& dictionary,
+    const std::string& name_space)
+{
+    out << "namespace record {\n";
+    std::set<std::string> names;
+    for (const auto& command : dictionary.commands()) {
+        auto name = type_name(command.name);
+        if (!names.insert(name).second) {
+            continue;
+        }
+        auto schema = "::" + name_space + "::schema::" + name;
+        write_record(out, dictionary, name + "Request", schema + "Request", command, true);
+        write_record(out, dictionary, name + "Answer", schema + "Answer", command, false);
+    }
+    out << "\n} // namespace record\n\n";
+}
+
+std::string generate(const Dictionary& dictionary, const std::string& name_space,
+    const std::vector<std::string>& inputs)
+{
+    auto header_guard = guard(name_space);
+    std::ostringstream out;
+    out << "#ifndef " << header_guard << "\n#define " << header_guard << "\n\n"
+        << "#include <cstdint>\n"
+        << "#include <optional>\n"
+        << "#include <string_view>\n"
+        << "#include <vector>\n\n"
+        << "#include <diameter/dictionary/dictionary.h>\n"
+        << "#include <diameter/dictionary/schema.h>\n"
+        << "#include <diameter/message/avp/avp_def.h>\n"
+        << "#include <diameter/message/header/application_id.h>\n"
+        << "#include <diameter/message/header/command_code.h>\n"
+        << "#include <diameter/message/span.h>\n"
+        << "#include <diameter/serial/record.h>\n"
+        << "#include <diameter/serial/view/avp.h>\n\n"
+        << "// Generated by diameter_dictgen from";
+    for (const auto& input : inputs) {
+        auto slash = input.find_last_of('/');
+        out << " " << input.substr(slash == std::string::npos ? 0 : slash + 1);
+    }
+    out << ", do not edit\n\nnamespace " << name_space << " {\n\n";
+    write_avps(out, dictionary.avps());
+    write_commands(out, dictionary.commands());
+    // The tables in the order of their comments, the switches of Dictionary index into them
+    auto avps = dictionary.avps();
+    std::stable_sort(avps.begin(), avps.end(),
+        [](const AvpDefinition& lhs, const AvpDefinition& rhs) {
+            return std::tie(lhs.vendor_id, lhs.code) < std::tie(rhs.vendor_id, rhs.code);
+        });
+    auto commands = dictionary.commands();
+    std::stable_sort(commands.begin(), commands.end(),
+        [](const CommandDefinition& lhs, const CommandDefinition& rhs) {
+            return std::tie(lhs.code, lhs.application_id)
+                < std::tie(rhs.code, rhs.application_id);
+        });
+    write_tables(out, avps, commands);
+    write_dictionary(out, avps, commands);
+    write_schemas(out, dictionary.commands());
+    write_records(out, dictionary, name_space);
+    out << "static_assert(diameter::dictionary::is_dictionary_v<Dictionary>);\n\n"
+        << "} // namespace " << name_space << "\n\n#endif\n";
+    return out.str();
+}
+
+int usage()
+{
+    std::cerr << "usage: diameter_dictgen --namespace <namespace> --output <header> <xml>...\n";
+    return 2;
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    std::string name_space;
+    std::string output;
+    std::vector<std::string> inputs;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if ((arg == "--namespace" || arg == "--output") && i + 1 < argc) {
+            (arg == "--namespace" ? name_space : output) = argv[++i];
+        }
+        else if (!arg.empty() && arg[0] == '-') {
+            return usage();
+        }
+        else {
+            inputs.emplace_back(arg);
+        }
+    }
+    if (name_space.empty() || output.empty() || inputs.empty()) {
+        return usage();
+    }
+
+    try {
+        diameter::dictionary::XmlLoader loader;
+        for (const auto& input : inputs) {
+            loader.load_file(input);
+        }
+        std::ofstream file(output, std::ios::binary | std::ios::trunc);
+        file << generate(loader.dictionary(), name_space, inputs);
+        if (!file) {
+            std::cerr << "diameter_dictgen: cannot write " << output << "\n";
+            return 1;
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << "diameter_dictgen: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}